@@ -1,95 +1,180 @@
 #include <raylib.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <memory>
-#include "sim/SimulationEngine.h"
-#include "sim/systems/PowerSystem.h"
-#include "sim/systems/DepthSystem.h"
-#include "sim/systems/SonarSystem.h"
-#include "sim/systems/TargetingSystem.h"
-#include "sim/systems/LaunchSequenceHandler/LaunchSequenceHandler.h"
-#include "sim/systems/EnvironmentSystem.h"
-#include "sim/systems/TargetAcquisitionSystem.h"
-#include "sim/systems/TargetValidationSystem.h"
-#include "sim/systems/FriendlySafetySystem.h"
-#include "sim/systems/MissileSystem.h"
-
-#include "sim/world/ContactManager.h"
-#include "sim/world/MissileManager.h"
-#include "sim/world/CrosshairManager.h"
+#include "sim/SimulationWorld.h"
+#include "sim/SimulationSnapshot.h"
+#include "sim/SimulationCommands.h"
+#include "sim/FixedStepClock.h"
+#include "sim/SimulationWorker.h"
 #include "ui/UIRoot.h"
+#include "ui/FramePacer.h"
+#include "ui/StartupTimer.h"
 
 #ifdef PLATFORM_WEB
     #include <emscripten/emscripten.h>
 #endif
 
 // Global variables for web platform
-SimulationEngine* g_engine = nullptr;
+SimulationWorld* g_world = nullptr;
 UIRoot* g_ui = nullptr;
+FramePacer* g_pacer = nullptr;
+FixedStepClock* g_clock = nullptr;
+SimulationWorker* g_worker = nullptr;   // set when the sim runs on its own thread
+SimulationSnapshot* g_snapshot = nullptr;   // what the ui draws
+SimulationCommandQueue* g_commands = nullptr;   // ui input on its way to the world
+
+// constructed during static initialization, so "main" measures the time to main
+StartupTimer g_startup;
 
 void UpdateDrawFrame() {
-    const float dt = GetFrameTime();
-    g_engine->update(dt);
+    FrameProfiler& profiler = g_ui->getFrameProfiler();
+    profiler.beginFrame();
+
+    // the sim ticks at its fixed rate however fast the display refreshes;
+    // rendering blends the last two sim states by the leftover time
+    const float dt = g_pacer->beginFrame();
+    float alpha;
+    if (g_worker) {
+        // the worker steps the sim and applies queued input; the ui takes its
+        // newest snapshot, which never waits on a step in progress
+        g_worker->setTimeScale(g_ui->getTimeScale());
+        g_worker->takeSnapshot(*g_snapshot);
+        alpha = g_worker->getAlpha(*g_snapshot);
+        g_ui->setTimeScaleStats(g_worker->getAchievedScale(), g_worker->getDroppedSteps());
+    } else {
+        // last frame's input lands before the new steps
+        const size_t applied = g_commands->apply(*g_world);
+
+        // accelerated time runs more fixed substeps per frame, within the clock's cpu budget
+        g_clock->setTimeScale(g_ui->getTimeScale());
+        const int steps = g_clock->advance(dt);
+        if (steps > 0) {
+            const double start = GetTime();
+            g_world->advance(g_clock->getStep(), steps);
+            g_clock->reportStepCost(static_cast<float>((GetTime() - start) * 1000.0 / steps));
+        }
+        if (steps > 0 || applied > 0) {
+            g_world->capture(*g_snapshot);
+            g_snapshot->appliedCommands = g_commands->getAppliedCount();
+        }
+        alpha = g_clock->getAlpha();
+        g_ui->setTimeScaleStats(g_clock->getAchievedScale(), g_clock->getDroppedSteps());
+    }
+    profiler.mark(FrameProfiler::SIM);
     g_ui->update(dt);
+    // a paused sim holds still instead of oscillating between states
+    g_ui->setInterpolationAlpha(g_snapshot->paused ? 1.0f : alpha);
+    g_ui->getMemoryTracker().sample(g_snapshot->memory, g_ui->getCacheBytes());
+    profiler.mark(FrameProfiler::UI_UPDATE);
+
+    // a paused sim with no input only needs the low-rate heartbeat redraw;
+    // the profiler graph counts as animation while it is open. the first
+    // frame always draws, even into a hidden window.
+    const bool animating = !g_snapshot->paused || g_ui->isProfilerVisible();
+    if (g_startup.isComplete() && !g_pacer->shouldDraw(animating)) {
+        profiler.endFrame();
+        g_pacer->frameSkipped();
+        return;
+    }
 
     BeginDrawing();
     ClearBackground(BLACK);
     g_ui->draw();
+    // cpu-side draw cost; EndDrawing's flush and vsync wait are excluded
+    profiler.mark(FrameProfiler::DRAW);
     EndDrawing();
+    profiler.endFrame();
+    g_pacer->frameDrawn();
+
+    if (!g_startup.isComplete()) {
+        g_startup.mark(StartupTimer::FIRST_FRAME);
+        g_startup.report();
+    }
 }
 
-int main() {
+// fixed simulation rate, independent of the display refresh
+static constexpr float SIM_RATE_HZ = 60.0f;
+
+int main(int argc, char** argv) {
+    g_startup.mark(StartupTimer::MAIN);
+
+    // --startup-report <budget ms>: draw one frame in a hidden window, print
+    // the startup timings and fail if the first frame missed the budget
+    double startupBudgetMs = -1.0;
+    if (argc > 2 && std::strcmp(argv[1], "--startup-report") == 0) {
+        startupBudgetMs = std::atof(argv[2]);
+    }
+
     const int screenWidth = 1280;
     const int screenHeight = 720;
 
+    SetConfigFlags(startupBudgetMs >= 0.0 ? FLAG_WINDOW_HIDDEN : FLAG_VSYNC_HINT);
     InitWindow(screenWidth, screenHeight, "Submarine Payload Launch (New)");
-    SetTargetFPS(60);
+    g_startup.mark(StartupTimer::WINDOW);
+
+    // render at the monitor's native refresh rate
+    int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+    if (refreshRate <= 0) refreshRate = 60;
+    SetTargetFPS(refreshRate);
 
     // Simulation core
-    SimulationEngine engine;
-    auto contacts = std::make_shared<ContactManager>();
-    auto missiles = std::make_shared<MissileManager>();
-    auto power = std::make_shared<PowerSystem>();
-    auto depth = std::make_shared<DepthSystem>();
-    auto sonar = std::make_shared<SonarSystem>(*contacts);
-    auto targeting = std::make_shared<TargetingSystem>();
-    auto environment = std::make_shared<EnvironmentSystem>();
-    auto launchSequence = std::make_shared<LaunchSequenceHandler>(engine);
-    auto crosshairManager = std::make_shared<CrosshairManager>(*contacts);
-    auto targetAcquisition = std::make_shared<TargetAcquisitionSystem>(*crosshairManager, *contacts);
-    auto targetValidation = std::make_shared<TargetValidationSystem>(*crosshairManager, *contacts);
-    auto friendlySafety = std::make_shared<FriendlySafetySystem>(*crosshairManager, *contacts);
-    auto missileSystem = std::make_shared<MissileSystem>(*missiles, *contacts, *crosshairManager);
-
-
-    engine.registerSystem(power);
-    engine.registerSystem(depth);
-    engine.registerSystem(sonar);
-    engine.registerSystem(targeting);
-    engine.registerSystem(environment);
-    engine.registerSystem(launchSequence);
-    engine.registerSystem(targetAcquisition);
-    engine.registerSystem(targetValidation);
-    engine.registerSystem(friendlySafety);
-    engine.registerSystem(missileSystem);
-
-    // Connect missile system and power system to launch sequence handler
-    launchSequence->setMissileSystem(missileSystem.get());
-    launchSequence->setPowerSystem(power.get());
+    SimulationWorld world;
+    // the clutter operators learn to reject: a few large schools of fish
+    const SchoolClutter clutter{ 4, 500, 90.0f };
+    world.getContactManager().setSchoolClutter(clutter);
+#ifdef PAYLOAD_SIM_FIXED_FOOTPRINT
+    // bounded memory: pools sized once from the scenario limits
+    ScenarioLimits limits;
+    limits.maxSchooledFish = clutter.fish();
+    world.setFixedFootprint(limits);
+#endif
     
-    // UI root with direct pointers to systems/state
-    UIRoot ui(engine, sonar.get(), power.get(), depth.get(), targeting.get(), launchSequence.get(), environment.get(), contacts.get(), crosshairManager.get(), missiles.get());
+    // the ui draws from a snapshot of the world and sends input back as commands
+    SimulationSnapshot snapshot;
+    SimulationCommandQueue commands;
+    world.capture(snapshot);
+    UIRoot ui(snapshot, commands);
+
+    g_startup.mark(StartupTimer::UI_BUILT);
+
+    FramePacer pacer(4.0f, (float)refreshRate);
+    FixedStepClock clock(SIM_RATE_HZ);
 
     // Set global pointers for web platform
-    g_engine = &engine;
+    g_world = &world;
     g_ui = &ui;
+    g_pacer = &pacer;
+    g_clock = &clock;
+    g_snapshot = &snapshot;
+    g_commands = &commands;
+
+#ifdef PAYLOAD_SIM_THREADED
+    SimulationWorker worker(world, SIM_RATE_HZ, &commands);
+    worker.start();
+    g_worker = &worker;
+#endif
 
 #ifdef PLATFORM_WEB
-    emscripten_set_main_loop(UpdateDrawFrame, 60, 1);
+    // 0 = requestAnimationFrame, which follows the display's refresh rate
+    emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
 #else
     while (!WindowShouldClose()) {
         UpdateDrawFrame();
+        if (startupBudgetMs >= 0.0 && g_startup.isComplete()) break;
     }
 #endif
 
+    if (startupBudgetMs >= 0.0) {
+        const double firstFrameMs = g_startup.getMs(StartupTimer::FIRST_FRAME);
+        const bool withinBudget = g_startup.isComplete() && firstFrameMs <= startupBudgetMs;
+        std::cout << "[StartupTimer] first frame " << firstFrameMs << " ms, budget " << startupBudgetMs
+                  << " ms: " << (withinBudget ? "ok" : "OVER BUDGET") << std::endl;
+        CloseWindow();
+        return withinBudget ? 0 : 1;
+    }
+
     CloseWindow();
     return 0;
 }
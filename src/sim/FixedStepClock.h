@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// turns variable frame times into whole fixed sim steps. the leftover time is
+// exposed as an alpha in [0, 1) so rendering can blend the last two states.
+//
+// a time scale above 1 runs the sim faster than the wall clock while the step
+// stays fixed, so one frame can owe many substeps. the catch-up cap grows with
+// the scale, and once the caller reports what a step costs it is also held to
+// a per-frame cpu budget; substeps past the cap are dropped and counted.
+class FixedStepClock {
+public:
+    static constexpr float MIN_TIME_SCALE = 1.0f;
+    static constexpr float MAX_TIME_SCALE = 100.0f;
+
+    explicit FixedStepClock(float stepHz = 60.0f, int maxSteps = 16)
+        : step(1.0f / stepHz), maxSteps(maxSteps) {}
+
+    // adds frame time and returns how many steps to run this frame
+    int advance(float frameTime) {
+        accumulator += frameTime * timeScale;
+        int steps = static_cast<int>(accumulator / step);
+        const int cap = getStepCap();
+        if (steps > cap) {
+            // too far behind to catch up; drop the backlog instead of spiralling
+            droppedSteps += static_cast<uint64_t>(steps - cap);
+            steps = cap;
+            accumulator = 0.0f;
+        } else {
+            accumulator -= steps * step;
+        }
+
+        // achieved scale over a half-second window of wall time
+        windowWall += frameTime;
+        windowSim += steps * step;
+        if (windowWall >= ACHIEVED_WINDOW) {
+            achievedScale = windowSim / windowWall;
+            windowWall = 0.0f;
+            windowSim = 0.0f;
+        }
+        return steps;
+    }
+
+    float getStep() const { return step; }
+
+    // fraction of a step elapsed since the last sim state
+    float getAlpha() const { return std::clamp(accumulator / step, 0.0f, 1.0f); }
+
+    // sim seconds per wall second, clamped to [MIN_TIME_SCALE, MAX_TIME_SCALE]
+    void setTimeScale(float scale) {
+        const float clamped = std::clamp(scale, MIN_TIME_SCALE, MAX_TIME_SCALE);
+        if (clamped == timeScale) return;
+        timeScale = clamped;
+        windowWall = 0.0f;
+        windowSim = 0.0f;
+    }
+    float getTimeScale() const { return timeScale; }
+
+    // cpu time the sim may take per frame, and the measured cost of one step.
+    // with no cost reported only the scaled step cap applies.
+    void setFrameBudgetMs(float ms) { frameBudgetMs = ms; }
+    float getFrameBudgetMs() const { return frameBudgetMs; }
+    void reportStepCost(float ms) {
+        stepCostMs = stepCostMs > 0.0f ? stepCostMs + (ms - stepCostMs) * 0.1f : ms;
+    }
+
+    // most steps a single advance may return; never below maxSteps, so real
+    // time keeps its usual catch-up
+    int getStepCap() const {
+        int cap = maxSteps * static_cast<int>(std::ceil(timeScale));
+        if (stepCostMs > 0.0f) {
+            cap = std::min(cap, static_cast<int>(frameBudgetMs / stepCostMs));
+        }
+        return std::max(cap, maxSteps);
+    }
+
+    // sim seconds per wall second actually run, and steps dropped so far
+    float getAchievedScale() const { return achievedScale; }
+    uint64_t getDroppedSteps() const { return droppedSteps; }
+
+    void reset() {
+        accumulator = 0.0f;
+        windowWall = 0.0f;
+        windowSim = 0.0f;
+    }
+
+private:
+    static constexpr float ACHIEVED_WINDOW = 0.5f;
+
+    float step;
+    int maxSteps;
+    float accumulator = 0.0f;
+
+    float timeScale = 1.0f;
+    float frameBudgetMs = 8.0f;
+    float stepCostMs = 0.0f;
+
+    float windowWall = 0.0f;
+    float windowSim = 0.0f;
+    float achievedScale = 1.0f;
+    uint64_t droppedSteps = 0;
+};
@@ -1,11 +1,24 @@
 #pragma once
 
+#include <limits>
 #include <string>
 #include "SimulationState.h"
 
 class ISystem {
 public:
+    static constexpr float NO_DEADLINE = std::numeric_limits<float>::infinity();
+
     virtual ~ISystem() = default;
     virtual const char* getName() const = 0;
     virtual void update(SimulationState& state, float dt) = 0;
+
+    // true when one update of n*dt lands where n updates of dt would, so the
+    // engine may fold a run of substeps into a single step
+    virtual bool integratesAnalytically() const { return false; }
+
+    // sim seconds until this system's next scheduled change: the longest
+    // single update it can take without stepping over one. 0 while it has
+    // dynamics that need fixed steps, NO_DEADLINE when nothing is scheduled.
+    // systems that don't say stay on fixed steps
+    virtual float getNextDeadline(const SimulationState& /*state*/) const { return 0.0f; }
 };
\ No newline at end of file
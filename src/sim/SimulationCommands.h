@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "SimulationSnapshot.h"
+
+class SimulationWorld;
+
+// input forwarded from the render thread, run against the world between sim
+// steps by whoever owns it. posting only takes the queue's own lock, never
+// the world's, so a click can't stall behind a step.
+class SimulationCommandQueue {
+public:
+    using Command = std::function<void(SimulationWorld&)>;
+
+    void post(Command command) {
+        std::lock_guard<std::mutex> guard(mutex);
+        pending.push_back(std::move(command));
+        posted.fetch_add(1, std::memory_order_release);
+    }
+
+    // runs everything posted so far, in order; returns how many ran
+    size_t apply(SimulationWorld& world) {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            running.swap(pending);
+        }
+        for (auto& command : running) command(world);
+        const size_t count = running.size();
+        running.clear();
+        applied.fetch_add(count, std::memory_order_release);
+        return count;
+    }
+
+    bool hasPending() const { return posted.load(std::memory_order_acquire) != getAppliedCount(); }
+    uint64_t getPostedCount() const { return posted.load(std::memory_order_acquire); }
+    uint64_t getAppliedCount() const { return applied.load(std::memory_order_acquire); }
+
+    // true while a posted command has yet to show up in the snapshot; views
+    // that mirror sim state hold their local input until it has
+    bool isAheadOf(const SimulationSnapshot& snapshot) const { return getPostedCount() != snapshot.appliedCommands; }
+
+private:
+    std::mutex mutex;
+    std::vector<Command> pending;
+    std::vector<Command> running;   // only touched by the applying thread
+    std::atomic<uint64_t> posted{0};
+    std::atomic<uint64_t> applied{0};
+};
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <vector>
 #include <memory>
 #include "SimulationState.h"
@@ -9,20 +12,86 @@ class SimulationEngine {
 public:
     SimulationEngine() = default;
 
-    void update(float dt) {
+    void update(float dt) { substep(dt, 0, 1); }
+
+    // substep index of a run of count fixed steps of dt taken in one frame.
+    // systems that integrate analytically fold the substeps up to their next
+    // deadline into one step and sit those out, so a flag they publish flips
+    // on the same substep as under fixed steps. everything else steps dt at
+    // a time, so guidance and timers keep their fixed-step accuracy.
+    void substep(float dt, int index, int count) {
+        if (paused) return;
+        for (size_t i = 0; i < systems.size(); ++i) {
+            if (index == 0) {
+                foldedUntil[i] = 0;
+                if (profiling) systemTimesMs[i] = 0.0f;
+            }
+            ISystem& system = *systems[i];
+            int steps = 1;
+            if (system.integratesAnalytically()) {
+                if (index < foldedUntil[i]) continue;
+                steps = foldLength(system, dt, count - index);
+                foldedUntil[i] = index + steps;
+            }
+            runSystem(i, dt * static_cast<float>(steps));
+        }
+    }
+
+    // earliest of every system's next deadline; see ISystem::getNextDeadline
+    float getNextDeadline() const {
+        float deadline = ISystem::NO_DEADLINE;
         for (const auto& system : systems) {
-            system->update(state, dt);
+            deadline = std::min(deadline, system->getNextDeadline(state));
         }
+        return deadline;
     }
 
     void registerSystem(const std::shared_ptr<ISystem>& system) {
         systems.push_back(system);
+        systemTimesMs.push_back(0.0f);
+        foldedUntil.push_back(0);
     }
 
+    // timing is off by default so headless worlds don't pay for it
+    void setProfiling(bool enabled) { profiling = enabled; }
+    bool isProfiling() const { return profiling; }
+    size_t getSystemCount() const { return systems.size(); }
+    const ISystem& getSystem(size_t index) const { return *systems[index]; }
+    float getSystemTimeMs(size_t index) const { return systemTimesMs[index]; }
+
+    // a paused engine keeps its state but skips all system updates
+    void setPaused(bool value) { paused = value; }
+    bool isPaused() const { return paused; }
+
     SimulationState& getState() { return state; }
     const SimulationState& getState() const { return state; }
 
 private:
+    // whole substeps that end short of the system's next deadline, so the
+    // state a fold publishes holds for every substep it covers; at least
+    // one, so the substep that reaches the deadline runs on its own
+    int foldLength(const ISystem& system, float dt, int remaining) const {
+        const float deadline = system.getNextDeadline(state);
+        if (!(deadline < static_cast<float>(remaining) * dt)) return remaining;
+        const int before = static_cast<int>(std::ceil(deadline / dt - 1e-3f)) - 1;
+        return std::clamp(before, 1, remaining);
+    }
+
+    void runSystem(size_t index, float dt) {
+        if (!profiling) {
+            systems[index]->update(state, dt);
+            return;
+        }
+        // per-system wall time over the run, read by the profiler overlay
+        const auto start = std::chrono::steady_clock::now();
+        systems[index]->update(state, dt);
+        systemTimesMs[index] += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
     SimulationState state{};
     std::vector<std::shared_ptr<ISystem>> systems;
+    std::vector<float> systemTimesMs;
+    std::vector<int> foldedUntil;   // substep each analytic system has run up to
+    bool paused = false;
+    bool profiling = false;
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <raylib.h>
+#include "SimulationState.h"
+#include "systems/SonarSystem.h"
+#include "world/ContactManager.h"
+#include "world/MissileManager.h"
+#include "world/MissionInstructionManager.h"
+#include "world/ScenarioLimits.h"
+
+// copy of everything the ui shows, taken by SimulationWorld::capture between
+// sim steps. the render thread draws from a snapshot instead of the live
+// world, so it never waits for a step to finish. capturing into the same
+// snapshot again reuses its buffers.
+struct SimulationSnapshot {
+    struct SystemTime {
+        const char* name;
+        float ms;
+    };
+
+    SimulationState state{};
+    bool paused = false;
+
+    // power and depth panels
+    float batteryLevel = 0.0f;
+    float powerLevel = 0.0f;
+    float optimalDepth = 0.0f;
+    float throttlePercentage = 0.0f;
+    const char* movementStatus = "";
+
+    // launch sequence and mission guidance
+    const char* launchPhase = "";
+    std::string authCode;
+    MissionInstruction instruction{ MissionStep::ADJUST_DEPTH, "", PulsateTarget::NONE, false };
+
+    // track estimates at this step and the one before, for interpolation
+    std::vector<Vector2> trackPositions;
+    std::vector<Vector2> trackPreviousPositions;
+    std::vector<ContactType> trackTypes;
+
+    // sonar mode, and what the latest ping heard (perceived positions)
+    SonarMode sonarMode = SonarMode::Passive;
+    float beamTurns = 0.0f;
+    uint32_t pingCount = 0;
+    std::vector<Vector2> pingDetections;
+    size_t contactCount = 0;
+
+    bool tracking = false;
+    Vector2 crosshairPosition{ 0.0f, 0.0f };
+    Vector2 previousCrosshairPosition{ 0.0f, 0.0f };
+
+    std::vector<Missile> missiles;
+    std::vector<Explosion> explosions;
+
+    // profiler and memory readouts
+    std::vector<SystemTime> systemTimes;
+    WorldMemory memory;
+
+    // set by whoever runs the world: render-thread commands it had applied,
+    // and for a worker the steady_clock time in ns the state belongs to
+    uint64_t appliedCommands = 0;
+    int64_t stepTimeNs = 0;
+};
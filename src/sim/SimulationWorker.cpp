@@ -0,0 +1,86 @@
+#include "SimulationWorker.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+SimulationWorker::SimulationWorker(SimulationWorld& world, float stepHz, SimulationCommandQueue* commands)
+    : world(world), commands(commands), clock(stepHz) {}
+
+void SimulationWorker::start() {
+    if (isRunning()) return;
+    clock.reset();
+    {
+        // the render thread has a picture before the first step
+        std::lock_guard<std::mutex> guard(worldMutex);
+        publish(Clock::now().time_since_epoch().count());
+    }
+    running.store(true, std::memory_order_release);
+    thread = std::thread(&SimulationWorker::run, this);
+    std::cout << "[SimulationWorker] started" << std::endl;
+}
+
+void SimulationWorker::stop() {
+    if (!isRunning()) return;
+    running.store(false, std::memory_order_release);
+    if (thread.joinable()) thread.join();
+    std::cout << "[SimulationWorker] stopped after " << getStepCount() << " steps" << std::endl;
+}
+
+bool SimulationWorker::takeSnapshot(SimulationSnapshot& into) {
+    std::lock_guard<std::mutex> guard(snapshotMutex);
+    if (!fresh) return false;
+    std::swap(into, published);
+    fresh = false;
+    return true;
+}
+
+float SimulationWorker::getAlpha(const SimulationSnapshot& shown) const {
+    const int64_t sinceNs = Clock::now().time_since_epoch().count() - shown.stepTimeNs;
+    const float since = static_cast<float>(sinceNs) * 1e-9f * requestedScale.load(std::memory_order_relaxed);
+    return std::clamp(since / clock.getStep(), 0.0f, 1.0f);
+}
+
+void SimulationWorker::publish(int64_t stepNs) {
+    world.capture(back);
+    back.appliedCommands = commands ? commands->getAppliedCount() : 0;
+    back.stepTimeNs = stepNs;
+
+    std::lock_guard<std::mutex> guard(snapshotMutex);
+    std::swap(back, published);
+    fresh = true;
+}
+
+void SimulationWorker::run() {
+    auto last = Clock::now();
+    int64_t stepNs = last.time_since_epoch().count();
+    while (running.load(std::memory_order_acquire)) {
+        const auto now = Clock::now();
+        const float frameTime = std::min(std::chrono::duration<float>(now - last).count(), 0.25f);
+        last = now;
+
+        clock.setTimeScale(requestedScale.load(std::memory_order_relaxed));
+        const int steps = clock.advance(frameTime);
+        const bool input = commands && commands->hasPending();
+        if (steps > 0 || input) {
+            std::lock_guard<std::mutex> guard(worldMutex);
+            // input lands before the steps it was given during
+            if (input) commands->apply(world);
+            if (steps > 0) {
+                const auto start = Clock::now();
+                world.advance(clock.getStep(), steps);
+                clock.reportStepCost(std::chrono::duration<float, std::milli>(Clock::now() - start).count() / steps);
+                stepCount.fetch_add(static_cast<uint64_t>(steps), std::memory_order_relaxed);
+                // the new state belongs to `now` minus the wall time still in the accumulator
+                const float leftover = clock.getAlpha() * clock.getStep() / clock.getTimeScale();
+                stepNs = now.time_since_epoch().count() - static_cast<int64_t>(leftover * 1e9f);
+            }
+            publish(stepNs);
+        }
+        achievedScale.store(clock.getAchievedScale(), std::memory_order_relaxed);
+        droppedSteps.store(clock.getDroppedSteps(), std::memory_order_relaxed);
+
+        // sleep until the next step is due, in wall time
+        const float wait = (1.0f - clock.getAlpha()) * clock.getStep() / clock.getTimeScale();
+        std::this_thread::sleep_for(std::chrono::duration<float>(wait));
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "SimulationWorld.h"
+#include "SimulationSnapshot.h"
+#include "SimulationCommands.h"
+#include "FixedStepClock.h"
+
+// ticks a SimulationWorld at a fixed rate on its own thread, so the render
+// thread only draws and forwards input. in the threaded web build the thread
+// is a Web Worker and the world lives in the shared (SharedArrayBuffer) heap.
+//
+// the render thread never touches the world: after each pass the worker
+// captures a snapshot into its back buffer and swaps it with the published
+// one, and takeSnapshot swaps that into the reader's. the swap lock only
+// covers the swap, so reading never waits on a step. input goes through the
+// command queue, which the worker drains before it steps.
+class SimulationWorker {
+public:
+    SimulationWorker(SimulationWorld& world, float stepHz, SimulationCommandQueue* commands = nullptr);
+    ~SimulationWorker() { stop(); }
+
+    SimulationWorker(const SimulationWorker&) = delete;
+    SimulationWorker& operator=(const SimulationWorker&) = delete;
+
+    void start();
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    // excludes sim steps for as long as the returned lock is held; for
+    // callers off the render thread
+    std::unique_lock<std::mutex> lock() { return std::unique_lock<std::mutex>(worldMutex); }
+
+    // swaps the newest published snapshot into `into` if one arrived since the
+    // last call, recycling into's old buffers. returns false if nothing new
+    bool takeSnapshot(SimulationSnapshot& into);
+
+    // fraction of a step elapsed since the shown snapshot's step, for interpolation
+    float getAlpha(const SimulationSnapshot& shown) const;
+
+    uint64_t getStepCount() const { return stepCount.load(std::memory_order_relaxed); }
+
+    // sim seconds per wall second; picked up by the worker on its next pass
+    void setTimeScale(float scale) {
+        requestedScale.store(std::clamp(scale, FixedStepClock::MIN_TIME_SCALE, FixedStepClock::MAX_TIME_SCALE),
+                             std::memory_order_relaxed);
+    }
+    float getAchievedScale() const { return achievedScale.load(std::memory_order_relaxed); }
+    uint64_t getDroppedSteps() const { return droppedSteps.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    // captures the world into the back buffer and publishes it; holds worldMutex
+    void publish(int64_t stepNs);
+
+    SimulationWorld& world;
+    SimulationCommandQueue* commands;
+    FixedStepClock clock;
+    std::thread thread;
+    std::mutex worldMutex;
+
+    SimulationSnapshot back;
+    SimulationSnapshot published;
+    bool fresh = false;
+    std::mutex snapshotMutex;   // guards published and fresh, only for a swap
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> stepCount{0};
+    std::atomic<float> requestedScale{1.0f};
+    std::atomic<float> achievedScale{1.0f};
+    std::atomic<uint64_t> droppedSteps{0};
+};
@@ -0,0 +1,150 @@
+#include "SimulationWorld.h"
+#include <algorithm>
+#include <random>
+
+SimulationWorld::SimulationWorld() : SimulationWorld(std::random_device{}()) {}
+
+SimulationWorld::SimulationWorld(uint32_t seed) {
+    // derive independent streams for each random source
+    std::seed_seq seedSequence{seed};
+    uint32_t seeds[6];
+    seedSequence.generate(seeds, seeds + 6);
+
+    contacts = std::make_shared<ContactManager>();
+    contacts->seed(seeds[0]);
+    missiles = std::make_shared<MissileManager>();
+    missiles->seed(seeds[1]);
+    crosshair = std::make_shared<CrosshairManager>(*contacts);
+
+    power = std::make_shared<PowerSystem>();
+    depth = std::make_shared<DepthSystem>(seeds[2]);
+    subBehavior = std::make_shared<SubmarineBehaviorSystem>(*contacts, *missiles);
+    subBehavior->seed(seeds[5]);
+    sonar = std::make_shared<SonarSystem>(*contacts);
+    sonar->seed(seeds[3]);
+    targeting = std::make_shared<TargetingSystem>();
+    environment = std::make_shared<EnvironmentSystem>(seeds[4]);
+    launchSequence = std::make_shared<LaunchSequenceHandler>(engine);
+    targetAcquisition = std::make_shared<TargetAcquisitionSystem>(*crosshair, *contacts);
+    targetValidation = std::make_shared<TargetValidationSystem>(*crosshair, *contacts);
+    friendlySafety = std::make_shared<FriendlySafetySystem>(*crosshair, *contacts);
+    missileSystem = std::make_shared<MissileSystem>(*missiles, *contacts, *crosshair);
+
+    // propagation is solved once per scenario, from the environment's water column
+    sonar->getDetectionModel().setPropagation(environment->getSoundSpeedProfile());
+    contacts->setCurrentField(&environment->getCurrentField());
+    missiles->setCurrentField(&environment->getCurrentField());
+    crosshair->setTracker(&sonar->getTracker());
+
+    engine.registerSystem(power);
+    engine.registerSystem(depth);
+    engine.registerSystem(subBehavior);
+    engine.registerSystem(sonar);
+    engine.registerSystem(targeting);
+    engine.registerSystem(environment);
+    engine.registerSystem(launchSequence);
+    engine.registerSystem(targetAcquisition);
+    engine.registerSystem(targetValidation);
+    engine.registerSystem(friendlySafety);
+    engine.registerSystem(missileSystem);
+
+    // connect missile system and power system to launch sequence handler
+    launchSequence->setMissileSystem(missileSystem.get());
+    launchSequence->setPowerSystem(power.get());
+
+    mission = std::make_shared<MissionInstructionManager>(engine, launchSequence.get());
+}
+
+void SimulationWorld::update(float dt) {
+    engine.update(dt);
+    crosshair->update(dt);
+}
+
+void SimulationWorld::advance(float dt, int count) {
+    for (int i = 0; i < count; ++i) {
+        engine.substep(dt, i, count);
+        crosshair->update(dt);
+    }
+}
+
+size_t SimulationWorld::runFor(float duration, float step) {
+    size_t updates = 0;
+    float remaining = duration;
+    while (remaining > 0.0f) {
+        const float dt = std::min(remaining, std::max(engine.getNextDeadline(), step));
+        update(dt);
+        remaining -= dt;
+        ++updates;
+    }
+    return updates;
+}
+
+void SimulationWorld::setFixedFootprint(const ScenarioLimits& limits) {
+    contacts->setFixedFootprint(limits);
+    missiles->setFixedFootprint(limits);
+    sonar->setFixedFootprint(limits);
+    subBehavior->setFixedFootprint(limits);
+}
+
+WorldMemory SimulationWorld::getMemory() const {
+    WorldMemory memory;
+    memory.contacts = contacts->getMemoryBytes();
+    memory.missiles = missiles->getMissileBytes();
+    memory.trails = missiles->getTrailBytes();
+    memory.explosions = missiles->getExplosionBytes();
+    memory.schooling = contacts->getSchooling().getMemoryBytes();
+    memory.detection = sonar->getDetectionModel().getMemoryBytes();
+    memory.tracks = sonar->getTracker().getMemoryBytes();
+    memory.sweep = sonar->getSweep().getMemoryBytes();
+    memory.behaviors = subBehavior->getMemoryBytes();
+    memory.currents = environment->getCurrentField().getMemoryBytes();
+    return memory;
+}
+
+void SimulationWorld::capture(SimulationSnapshot& out) const {
+    out.state = engine.getState();
+    out.paused = engine.isPaused();
+
+    out.batteryLevel = power->getBatteryLevel();
+    out.powerLevel = power->getPowerLevel();
+    out.optimalDepth = depth->getOptimalDepth();
+    out.throttlePercentage = depth->getThrottlePercentage();
+    out.movementStatus = depth->getMovementStatus();
+
+    out.launchPhase = launchSequence->getCurrentPhaseString();
+    out.authCode = launchSequence->getAuthCode();
+    out.instruction = mission->getCurrentInstruction();
+
+    const ContactTracker& tracker = sonar->getTracker();
+    const size_t tracks = tracker.getTrackCount();
+    out.trackPositions.resize(tracks);
+    out.trackPreviousPositions.resize(tracks);
+    out.trackTypes.resize(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        out.trackPositions[i] = tracker.getPosition(i);
+        out.trackPreviousPositions[i] = tracker.getPreviousPosition(i);
+        out.trackTypes[i] = tracker.getType(i);
+    }
+
+    out.sonarMode = sonar->getMode();
+    out.beamTurns = sonar->getSweep().getBeamTurns();
+    out.pingCount = sonar->getDetectionModel().getPingCount();
+    out.pingDetections.clear();
+    for (const auto& contact : contacts->getActiveContacts()) {
+        if (contact.missedPings == 0) out.pingDetections.push_back(contact.perceivedPosition());
+    }
+    out.contactCount = contacts->getActiveContacts().size();
+
+    out.tracking = crosshair->isTracking();
+    out.crosshairPosition = crosshair->getCrosshairPosition();
+    out.previousCrosshairPosition = crosshair->getPreviousCrosshairPosition();
+
+    out.missiles = missiles->getActiveMissiles();
+    out.explosions = missiles->getActiveExplosions();
+
+    out.systemTimes.resize(engine.getSystemCount());
+    for (size_t i = 0; i < engine.getSystemCount(); ++i) {
+        out.systemTimes[i] = { engine.getSystem(i).getName(), engine.getSystemTimeMs(i) };
+    }
+    out.memory = getMemory();
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "SimulationEngine.h"
+#include "systems/PowerSystem.h"
+#include "systems/DepthSystem.h"
+#include "systems/SonarSystem.h"
+#include "systems/SubmarineBehaviorSystem.h"
+#include "systems/TargetingSystem.h"
+#include "systems/EnvironmentSystem.h"
+#include "systems/TargetAcquisitionSystem.h"
+#include "systems/TargetValidationSystem.h"
+#include "systems/FriendlySafetySystem.h"
+#include "systems/MissileSystem.h"
+#include "systems/LaunchSequenceHandler/LaunchSequenceHandler.h"
+#include "world/ContactManager.h"
+#include "world/MissileManager.h"
+#include "world/CrosshairManager.h"
+#include "world/MissionInstructionManager.h"
+#include "SimulationSnapshot.h"
+
+// one complete simulation: engine, world managers and all registered systems.
+// shared by the interactive app and headless batch environments.
+class SimulationWorld {
+public:
+    SimulationWorld();
+    explicit SimulationWorld(uint32_t seed);
+
+    SimulationWorld(const SimulationWorld&) = delete;
+    SimulationWorld& operator=(const SimulationWorld&) = delete;
+
+    // advances the engine and keeps the crosshair on its tracked contact
+    void update(float dt);
+
+    // runs count fixed steps of dt as one frame's substeps; systems that
+    // integrate analytically fold them into as few steps as their deadlines allow
+    void advance(float dt, int count);
+
+    // runs duration sim seconds for headless use: fixed steps of step while
+    // any system needs them, otherwise one update straight to the earliest
+    // deadline. returns the number of updates taken
+    size_t runFor(float duration, float step);
+
+    // sizes every world pool from limits up front; growth past them is refused
+    void setFixedFootprint(const ScenarioLimits& limits);
+    WorldMemory getMemory() const;
+
+    // copies what the ui shows into out, reusing its buffers; the command
+    // count and step time are left to the caller
+    void capture(SimulationSnapshot& out) const;
+
+    SimulationEngine& getEngine() { return engine; }
+    const SimulationEngine& getEngine() const { return engine; }
+
+    ContactManager& getContactManager() { return *contacts; }
+    MissileManager& getMissileManager() { return *missiles; }
+    CrosshairManager& getCrosshairManager() { return *crosshair; }
+    const ContactManager& getContactManager() const { return *contacts; }
+    const MissileManager& getMissileManager() const { return *missiles; }
+    const CrosshairManager& getCrosshairManager() const { return *crosshair; }
+
+    PowerSystem& getPowerSystem() { return *power; }
+    DepthSystem& getDepthSystem() { return *depth; }
+    SonarSystem& getSonarSystem() { return *sonar; }
+    SubmarineBehaviorSystem& getSubmarineBehaviorSystem() { return *subBehavior; }
+    TargetingSystem& getTargetingSystem() { return *targeting; }
+    EnvironmentSystem& getEnvironmentSystem() { return *environment; }
+    LaunchSequenceHandler& getLaunchSequence() { return *launchSequence; }
+    MissileSystem& getMissileSystem() { return *missileSystem; }
+    const PowerSystem& getPowerSystem() const { return *power; }
+    const SonarSystem& getSonarSystem() const { return *sonar; }
+    const DepthSystem& getDepthSystem() const { return *depth; }
+    const LaunchSequenceHandler& getLaunchSequence() const { return *launchSequence; }
+    const MissileSystem& getMissileSystem() const { return *missileSystem; }
+
+private:
+    SimulationEngine engine;
+
+    std::shared_ptr<ContactManager> contacts;
+    std::shared_ptr<MissileManager> missiles;
+    std::shared_ptr<CrosshairManager> crosshair;
+
+    std::shared_ptr<PowerSystem> power;
+    std::shared_ptr<DepthSystem> depth;
+    std::shared_ptr<SubmarineBehaviorSystem> subBehavior;
+    std::shared_ptr<SonarSystem> sonar;
+    std::shared_ptr<TargetingSystem> targeting;
+    std::shared_ptr<EnvironmentSystem> environment;
+    std::shared_ptr<LaunchSequenceHandler> launchSequence;
+    std::shared_ptr<TargetAcquisitionSystem> targetAcquisition;
+    std::shared_ptr<TargetValidationSystem> targetValidation;
+    std::shared_ptr<FriendlySafetySystem> friendlySafety;
+    std::shared_ptr<MissileSystem> missileSystem;
+
+    std::shared_ptr<MissionInstructionManager> mission;
+};
@@ -0,0 +1,47 @@
+#include "BatchEnvironmentAPI.h"
+#include "BatchSimulation.h"
+
+struct PayloadSimBatch {
+    BatchSimulation simulation;
+
+    PayloadSimBatch(uint32_t worldCount, uint32_t seed, uint32_t threadCount)
+        : simulation(worldCount, seed, threadCount) {}
+};
+
+extern "C" {
+
+PayloadSimBatch* payload_sim_batch_create(uint32_t worldCount, uint32_t seed, uint32_t threadCount) {
+    return new PayloadSimBatch(worldCount, seed, threadCount);
+}
+
+void payload_sim_batch_destroy(PayloadSimBatch* batch) {
+    delete batch;
+}
+
+void payload_sim_batch_reset(PayloadSimBatch* batch, uint32_t seed) {
+    if (batch) batch->simulation.reset(seed);
+}
+
+uint32_t payload_sim_batch_world_count(const PayloadSimBatch* batch) {
+    return batch ? batch->simulation.getWorldCount() : 0;
+}
+
+uint32_t payload_sim_observation_size(void) {
+    return PAYLOAD_SIM_OBSERVATION_SIZE;
+}
+
+void payload_sim_batch_step(PayloadSimBatch* batch, const PayloadSimAction* actions, float dt,
+                            float* observations, float* rewards) {
+    if (batch) batch->simulation.step(actions, dt, observations, rewards);
+}
+
+void payload_sim_batch_run_for(PayloadSimBatch* batch, float duration, float step, float* observations,
+                               float* rewards) {
+    if (batch) batch->simulation.runFor(duration, step, observations, rewards);
+}
+
+void payload_sim_batch_observe(const PayloadSimBatch* batch, float* observations) {
+    if (batch && observations) batch->simulation.observe(observations);
+}
+
+}
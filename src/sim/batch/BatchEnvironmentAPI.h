@@ -0,0 +1,84 @@
+#pragma once
+
+// C interface for stepping many headless simulation worlds at once.
+// Buffers are flat and world-major: observations hold
+// worldCount * PAYLOAD_SIM_OBSERVATION_SIZE floats, rewards hold worldCount floats.
+
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(PAYLOAD_SIM_BATCH_EXPORTS)
+    #define PAYLOAD_SIM_API __declspec(dllexport)
+#elif defined(__GNUC__)
+    #define PAYLOAD_SIM_API __attribute__((visibility("default")))
+#else
+    #define PAYLOAD_SIM_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// sonar tracks reported per world, nearest to own ship first
+#define PAYLOAD_SIM_MAX_OBSERVED_CONTACTS 16
+
+enum PayloadSimObservation {
+    PAYLOAD_SIM_OBS_DEPTH_CLEARANCE_MET = 0,
+    PAYLOAD_SIM_OBS_TARGET_ACQUIRED,
+    PAYLOAD_SIM_OBS_TARGET_VALIDATED,
+    PAYLOAD_SIM_OBS_POWER_SUPPLY_STABLE,
+    PAYLOAD_SIM_OBS_NO_FRIENDLIES_IN_BLAST_RADIUS,
+    PAYLOAD_SIM_OBS_LAUNCH_AUTHORIZED,
+    PAYLOAD_SIM_OBS_PAYLOAD_OPERATIONAL,
+    PAYLOAD_SIM_OBS_MISSILE_ACTIVE,
+    PAYLOAD_SIM_OBS_CURRENT_DEPTH,
+    PAYLOAD_SIM_OBS_OPTIMAL_DEPTH,
+    PAYLOAD_SIM_OBS_BATTERY_LEVEL,
+    PAYLOAD_SIM_OBS_LAUNCH_PHASE,
+    PAYLOAD_SIM_OBS_AUTHORIZATION_PENDING,
+    // followed by PAYLOAD_SIM_MAX_OBSERVED_CONTACTS records of
+    // {x, y, type, tracked}; unused records have type -1
+    PAYLOAD_SIM_OBS_CONTACTS,
+    PAYLOAD_SIM_OBSERVATION_SIZE = PAYLOAD_SIM_OBS_CONTACTS + PAYLOAD_SIM_MAX_OBSERVED_CONTACTS * 4
+};
+
+enum PayloadSimCommand {
+    PAYLOAD_SIM_COMMAND_NONE = 0,
+    PAYLOAD_SIM_COMMAND_AUTHORIZE,
+    PAYLOAD_SIM_COMMAND_SUBMIT_CODE,   // submits the currently pending auth code
+    PAYLOAD_SIM_COMMAND_ARM,
+    PAYLOAD_SIM_COMMAND_LAUNCH,
+    PAYLOAD_SIM_COMMAND_RESET
+};
+
+typedef struct PayloadSimAction {
+    float depthThrottle;     // 0..1, 0.5 holds depth
+    int32_t weaponsPower;    // 0 = off, 1 = on
+    int32_t selectContact;   // 1 = select the contact at (targetX, targetY)
+    float targetX;           // world coordinates
+    float targetY;
+    int32_t command;         // PayloadSimCommand
+} PayloadSimAction;
+
+typedef struct PayloadSimBatch PayloadSimBatch;
+
+// threadCount 0 uses every hardware thread
+PAYLOAD_SIM_API PayloadSimBatch* payload_sim_batch_create(uint32_t worldCount, uint32_t seed, uint32_t threadCount);
+PAYLOAD_SIM_API void payload_sim_batch_destroy(PayloadSimBatch* batch);
+PAYLOAD_SIM_API void payload_sim_batch_reset(PayloadSimBatch* batch, uint32_t seed);
+PAYLOAD_SIM_API uint32_t payload_sim_batch_world_count(const PayloadSimBatch* batch);
+PAYLOAD_SIM_API uint32_t payload_sim_observation_size(void);
+
+// actions may be NULL (no input); observations and rewards may be NULL when not needed
+PAYLOAD_SIM_API void payload_sim_batch_step(PayloadSimBatch* batch, const PayloadSimAction* actions, float dt,
+                                            float* observations, float* rewards);
+// runs duration seconds with no input, in fixed steps of step only where a
+// world needs them and otherwise straight to its next scheduled change.
+// rewards cover kills made during the run, which later steps never pay out
+// again. observations and rewards may be NULL
+PAYLOAD_SIM_API void payload_sim_batch_run_for(PayloadSimBatch* batch, float duration, float step,
+                                               float* observations, float* rewards);
+PAYLOAD_SIM_API void payload_sim_batch_observe(const PayloadSimBatch* batch, float* observations);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,198 @@
+#include "BatchSimulation.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+
+BatchSimulation::BatchSimulation(uint32_t worldCount, uint32_t seed, uint32_t threads)
+    : threadCount(threads) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    // no worker threads without -pthread in the web build
+    threadCount = 1;
+#endif
+    threadCount = std::max(1u, std::min(threadCount, std::max(1u, worldCount)));
+
+    pool = std::make_unique<WorkerPool>(threadCount);
+
+    worlds.resize(worldCount);
+    lastKills.resize(worldCount);
+    reset(seed);
+}
+
+// rebuilds every world; world i is seeded with seed + i so runs are reproducible
+void BatchSimulation::reset(uint32_t seed) {
+    forEachRange([this, seed](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            worlds[i] = std::make_unique<SimulationWorld>(seed + static_cast<uint32_t>(i));
+            lastKills[i] = KillCount{};
+        }
+    });
+}
+
+void BatchSimulation::step(const PayloadSimAction* actions, float dt, float* observations, float* rewards) {
+    forEachRange([&](size_t begin, size_t end) {
+        stepRange(begin, end, actions, dt, observations, rewards);
+    });
+}
+
+void BatchSimulation::observe(float* observations) const {
+    forEachRange([this, observations](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            writeObservation(*worlds[i], observations + i * PAYLOAD_SIM_OBSERVATION_SIZE);
+        }
+    });
+}
+
+void BatchSimulation::runFor(float duration, float step, float* observations, float* rewards) {
+    forEachRange([&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            worlds[i]->runFor(duration, step);
+            settleKills(i, rewards);
+            if (observations) {
+                writeObservation(*worlds[i], observations + i * PAYLOAD_SIM_OBSERVATION_SIZE);
+            }
+        }
+    });
+}
+
+void BatchSimulation::stepRange(size_t begin, size_t end, const PayloadSimAction* actions, float dt,
+                                float* observations, float* rewards) {
+    for (size_t i = begin; i < end; ++i) {
+        SimulationWorld& world = *worlds[i];
+        if (actions) {
+            applyAction(world, actions[i]);
+        }
+        world.update(dt);
+        settleKills(i, rewards);
+        if (observations) {
+            writeObservation(world, observations + i * PAYLOAD_SIM_OBSERVATION_SIZE);
+        }
+    }
+}
+
+// +1 per enemy sub destroyed, -1 per friendly sub destroyed since the last
+// call. the tally moves on even with no rewards buffer, so a kill is only
+// ever paid out by the call it happened in
+void BatchSimulation::settleKills(size_t index, float* rewards) {
+    const MissileSystem& missileSystem = worlds[index]->getMissileSystem();
+    const KillCount kills{missileSystem.getEnemyKills(), missileSystem.getFriendlyKills()};
+    if (rewards) {
+        rewards[index] = static_cast<float>(kills.enemy - lastKills[index].enemy)
+                       - static_cast<float>(kills.friendly - lastKills[index].friendly);
+    }
+    lastKills[index] = kills;
+}
+
+// splits the worlds into one contiguous range per pool thread; the calling thread takes the first
+template <typename Fn>
+void BatchSimulation::forEachRange(Fn fn) const {
+    const size_t count = worlds.size();
+    if (threadCount <= 1 || count <= 1) {
+        fn(size_t{0}, count);
+        return;
+    }
+
+    const size_t chunk = (count + threadCount - 1) / threadCount;
+    auto range = [&](size_t index) {
+        const size_t begin = index * chunk;
+        if (begin < count) {
+            fn(begin, std::min(count, begin + chunk));
+        }
+    };
+    pool->run(range);
+}
+
+void BatchSimulation::applyAction(SimulationWorld& world, const PayloadSimAction& action) {
+    world.getDepthSystem().setThrottleValue(action.depthThrottle);
+    world.getPowerSystem().setPowerState(action.weaponsPower != 0);
+
+    if (action.selectContact) {
+        world.getCrosshairManager().selectContactAt({action.targetX, action.targetY});
+    }
+
+    LaunchSequenceHandler& launchSequence = world.getLaunchSequence();
+    switch (action.command) {
+        case PAYLOAD_SIM_COMMAND_AUTHORIZE:
+            launchSequence.requestAuthorization();
+            break;
+        case PAYLOAD_SIM_COMMAND_SUBMIT_CODE: {
+            // copy: submitting clears the handler's code
+            std::string code = launchSequence.getAuthCode();
+            launchSequence.submitAuthorization(code);
+            break;
+        }
+        case PAYLOAD_SIM_COMMAND_ARM:
+            launchSequence.requestArm();
+            break;
+        case PAYLOAD_SIM_COMMAND_LAUNCH:
+            launchSequence.requestLaunch();
+            break;
+        case PAYLOAD_SIM_COMMAND_RESET:
+            launchSequence.requestReset();
+            break;
+        default:
+            break;
+    }
+}
+
+void BatchSimulation::writeObservation(const SimulationWorld& world, float* out) {
+    const SimulationState& s = world.getEngine().getState();
+    const LaunchSequenceHandler& launchSequence = world.getLaunchSequence();
+
+    out[PAYLOAD_SIM_OBS_DEPTH_CLEARANCE_MET] = s.depthClearanceMet ? 1.0f : 0.0f;
+    out[PAYLOAD_SIM_OBS_TARGET_ACQUIRED] = s.targetAcquired ? 1.0f : 0.0f;
+    out[PAYLOAD_SIM_OBS_TARGET_VALIDATED] = s.targetValidated ? 1.0f : 0.0f;
+    out[PAYLOAD_SIM_OBS_POWER_SUPPLY_STABLE] = s.powerSupplyStable ? 1.0f : 0.0f;
+    out[PAYLOAD_SIM_OBS_NO_FRIENDLIES_IN_BLAST_RADIUS] = s.noFriendlyUnitsInBlastRadius ? 1.0f : 0.0f;
+    out[PAYLOAD_SIM_OBS_LAUNCH_AUTHORIZED] = s.canLaunchAuthorized ? 1.0f : 0.0f;
+    out[PAYLOAD_SIM_OBS_PAYLOAD_OPERATIONAL] = s.payloadSystemOperational ? 1.0f : 0.0f;
+    out[PAYLOAD_SIM_OBS_MISSILE_ACTIVE] = s.missileActive ? 1.0f : 0.0f;
+    out[PAYLOAD_SIM_OBS_CURRENT_DEPTH] = world.getDepthSystem().getDepth();
+    out[PAYLOAD_SIM_OBS_OPTIMAL_DEPTH] = world.getDepthSystem().getOptimalDepth();
+    out[PAYLOAD_SIM_OBS_BATTERY_LEVEL] = world.getPowerSystem().getBatteryLevel() / 100.0f;
+    out[PAYLOAD_SIM_OBS_LAUNCH_PHASE] = static_cast<float>(launchSequence.getCurrentPhase());
+    out[PAYLOAD_SIM_OBS_AUTHORIZATION_PENDING] = launchSequence.isAuthorizationPending() ? 1.0f : 0.0f;
+
+    // nearest sonar tracks to own ship first, at their estimated positions
+    const ContactTracker& tracker = world.getSonarSystem().getTracker();
+    const uint32_t trackedId = world.getCrosshairManager().getTrackedContactId();
+    const size_t trackedTrack = trackedId != 0 ? tracker.findTrack(trackedId) : ContactTracker::NO_TRACK;
+
+    size_t order[PAYLOAD_SIM_MAX_OBSERVED_CONTACTS];
+    float orderDist2[PAYLOAD_SIM_MAX_OBSERVED_CONTACTS];
+    size_t kept = 0;
+    for (size_t i = 0; i < tracker.getTrackCount(); ++i) {
+        const Vector2 p = tracker.getPosition(i);
+        const float d2 = p.x * p.x + p.y * p.y;
+        if (kept == PAYLOAD_SIM_MAX_OBSERVED_CONTACTS && d2 >= orderDist2[kept - 1]) continue;
+
+        // insertion into the small sorted window
+        size_t slot = std::min(kept, static_cast<size_t>(PAYLOAD_SIM_MAX_OBSERVED_CONTACTS - 1));
+        while (slot > 0 && orderDist2[slot - 1] > d2) {
+            order[slot] = order[slot - 1];
+            orderDist2[slot] = orderDist2[slot - 1];
+            --slot;
+        }
+        order[slot] = i;
+        orderDist2[slot] = d2;
+        if (kept < PAYLOAD_SIM_MAX_OBSERVED_CONTACTS) ++kept;
+    }
+
+    float* record = out + PAYLOAD_SIM_OBS_CONTACTS;
+    for (size_t k = 0; k < PAYLOAD_SIM_MAX_OBSERVED_CONTACTS; ++k, record += 4) {
+        if (k < kept) {
+            const Vector2 p = tracker.getPosition(order[k]);
+            record[0] = p.x;
+            record[1] = p.y;
+            record[2] = static_cast<float>(tracker.getType(order[k]));
+            record[3] = (order[k] == trackedTrack) ? 1.0f : 0.0f;
+        } else {
+            record[0] = 0.0f;
+            record[1] = 0.0f;
+            record[2] = -1.0f;
+            record[3] = 0.0f;
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "BatchEnvironmentAPI.h"
+#include "WorkerPool.h"
+#include "../SimulationWorld.h"
+
+// steps many independent worlds per call, split across a pool of worker
+// threads started with the batch.
+// worlds stay self-contained objects; actions, observations and rewards
+// are exchanged through flat world-major arrays.
+class BatchSimulation {
+public:
+    BatchSimulation(uint32_t worldCount, uint32_t seed, uint32_t threadCount = 0);
+
+    void reset(uint32_t seed);
+    void step(const PayloadSimAction* actions, float dt, float* observations, float* rewards);
+    void observe(float* observations) const;
+    // runs duration sim seconds in every world with no input, jumping
+    // between deadlines where the worlds allow it (SimulationWorld::runFor).
+    // kills made meanwhile are rewarded here, like a step's
+    void runFor(float duration, float step, float* observations, float* rewards = nullptr);
+
+    uint32_t getWorldCount() const { return static_cast<uint32_t>(worlds.size()); }
+    uint32_t getThreadCount() const { return threadCount; }
+    SimulationWorld& getWorld(uint32_t index) { return *worlds[index]; }
+
+    static void applyAction(SimulationWorld& world, const PayloadSimAction& action);
+    static void writeObservation(const SimulationWorld& world, float* out);
+
+private:
+    // kills seen at the last step, used to turn running tallies into rewards
+    struct KillCount {
+        uint32_t enemy = 0;
+        uint32_t friendly = 0;
+    };
+
+    std::vector<std::unique_ptr<SimulationWorld>> worlds;
+    std::vector<KillCount> lastKills;
+    uint32_t threadCount;
+    // declared last so its threads stop before the worlds go away
+    std::unique_ptr<WorkerPool> pool;
+
+    void settleKills(size_t index, float* rewards);
+    void stepRange(size_t begin, size_t end, const PayloadSimAction* actions, float dt,
+                   float* observations, float* rewards);
+    template <typename Fn> void forEachRange(Fn fn) const;
+};
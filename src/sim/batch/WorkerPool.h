@@ -0,0 +1,101 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fixed set of threads started once and parked between jobs. run() hands the
+// same task to every participant, the calling thread included, and returns
+// when all of them have finished, so a batch step costs a wake-up instead of
+// a thread spawn and join per worker.
+class WorkerPool {
+public:
+    // threadCount counts the caller; threadCount - 1 threads are started
+    explicit WorkerPool(size_t threadCount) {
+        for (size_t index = 1; index < threadCount; ++index) {
+            workers.emplace_back(&WorkerPool::loop, this, index);
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    size_t getThreadCount() const { return workers.size() + 1; }
+
+    // calls task(index) once for each index in [0, getThreadCount()); the
+    // caller takes index 0. one job runs at a time, other callers wait
+    template <typename Task>
+    void run(Task& task) {
+        if (workers.empty()) {
+            task(size_t{0});
+            return;
+        }
+        std::lock_guard<std::mutex> serial(runMutex);
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            job = &invoke<Task>;
+            context = &task;
+            pending = workers.size();
+            ++generation;
+        }
+        wake.notify_all();
+        task(size_t{0});
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        job = nullptr;
+        context = nullptr;
+    }
+
+private:
+    using Job = void (*)(void*, size_t);
+
+    template <typename Task>
+    static void invoke(void* task, size_t index) { (*static_cast<Task*>(task))(index); }
+
+    void loop(size_t index) {
+        uint64_t seen = 0;
+        for (;;) {
+            Job current;
+            void* currentContext;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                current = job;
+                currentContext = context;
+            }
+            current(currentContext, index);
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                if (--pending == 0) done.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex runMutex;
+    std::mutex mutex;                // guards everything below
+    std::condition_variable wake;
+    std::condition_variable done;
+    Job job = nullptr;
+    void* context = nullptr;
+    uint64_t generation = 0;
+    size_t pending = 0;
+    bool stopping = false;
+};
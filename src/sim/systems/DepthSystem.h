@@ -2,14 +2,16 @@
 
 #include "../ISystem.h"
 #include <algorithm>
+#include <cstdint>
 #include <random>
 
 class DepthSystem : public ISystem {
 public:
-    DepthSystem() {
+    DepthSystem() : DepthSystem(std::random_device{}()) {}
+
+    explicit DepthSystem(uint32_t seed) {
         // generate random optimal depth
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        std::mt19937 gen(seed);
         std::uniform_real_distribution<float> dis(50.0f, 200.0f);
         optimalDepth = dis(gen);
         
@@ -38,6 +40,22 @@ public:
         state.depthClearanceMet = state.currentDepthMeters >= (optimalDepth - 5.0f) && state.currentDepthMeters <= (optimalDepth + 5.0f);
     }
 
+    // the throttle moves depth linearly up to the limits, so any dt is exact
+    bool integratesAnalytically() const override { return true; }
+
+    // the next clearance band edge or depth limit the throttle is heading for
+    float getNextDeadline(const SimulationState& /*state*/) const override {
+        const float rate = depthChange * depthChangeRate;
+        if (rate == 0.0f) return NO_DEADLINE;
+        const float marks[] = { optimalDepth - 5.0f, optimalDepth + 5.0f, minDepth, maxDepth };
+        float deadline = NO_DEADLINE;
+        for (float mark : marks) {
+            const float t = (mark - desiredDepth) / rate;
+            if (t > 0.0f) deadline = std::min(deadline, t);
+        }
+        return deadline;
+    }
+
     void setDepth(float meters) { desiredDepth = std::clamp(meters, minDepth, maxDepth); }
     float getDepth() const { return desiredDepth; }
     
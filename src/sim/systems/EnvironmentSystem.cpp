@@ -0,0 +1,81 @@
+#include "EnvironmentSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float TWO_PI = 6.28318531f;
+constexpr float CALM_SEA_STATE = 1.0f;
+constexpr float SEA_STATE_SWELL = 4.5f;
+}
+
+EnvironmentSystem::EnvironmentSystem(uint32_t seed) {
+    std::mt19937 gen(seed);
+    currents.seed(gen());
+    seaPhase = std::uniform_real_distribution<float>(0.0f, TWO_PI)(gen);
+    updateSeaState();
+    updateOwnShipCurrent();
+}
+
+void EnvironmentSystem::update(SimulationState& state, float dt) {
+    clock += dt;
+
+    // currents change over minutes, so a few tiles per refresh keep up. an
+    // update spanning several intervals refreshes the tiles they would have
+    refreshTimer -= dt;
+    if (refreshTimer <= 0.0f) {
+        const float overdue = -refreshTimer;
+        const size_t intervals = 1 + static_cast<size_t>(overdue / REFRESH_INTERVAL);
+        currents.refresh(clock, intervals * TILES_PER_REFRESH);
+        if (intervals == 1) {
+            refreshTimer += REFRESH_INTERVAL;
+        } else {
+            refreshTimer = REFRESH_INTERVAL - std::fmod(overdue, REFRESH_INTERVAL);
+        }
+    }
+    updateSeaState();
+    updateOwnShipCurrent();
+
+    state.launchConditionsFavorable = seaState <= launchLimits.maxSeaState &&
+                                      ownShipCurrent <= launchLimits.maxCurrent;
+    state.launchTubeIntegrity = true;
+}
+
+void EnvironmentSystem::updateSeaState() {
+    const float swell = 0.5f - 0.5f * std::cos(TWO_PI * clock / SEA_STATE_PERIOD + seaPhase);
+    seaState = CALM_SEA_STATE + SEA_STATE_SWELL * swell;
+}
+
+void EnvironmentSystem::updateOwnShipCurrent() {
+    const Vector2 current = currents.sample({0, 0});
+    ownShipCurrent = std::sqrt(current.x * current.x + current.y * current.y);
+}
+
+float EnvironmentSystem::getNextDeadline(const SimulationState& /*state*/) const {
+    return std::min(timeToSeaStateLimit(), timeToCurrentLimit());
+}
+
+// the limit is crossed where cos(theta) = c, twice per swell; 0 < theta < 2pi
+float EnvironmentSystem::timeToSeaStateLimit() const {
+    const float c = 1.0f - 2.0f * (launchLimits.maxSeaState - CALM_SEA_STATE) / SEA_STATE_SWELL;
+    // a swell that never reaches, or never drops below, the limit
+    if (!(c > -1.0f && c < 1.0f)) return NO_DEADLINE;
+
+    const float rising = std::acos(c);
+    const float omega = TWO_PI / SEA_STATE_PERIOD;
+    const float theta = std::fmod(omega * clock + seaPhase, TWO_PI);
+    float next = TWO_PI + rising;
+    if (theta < rising) next = rising;
+    else if (theta < TWO_PI - rising) next = TWO_PI - rising;
+    return (next - theta) / omega;
+}
+
+// own-ship current only changes when its tile refreshes, and a refreshed tile
+// can lag the water by up to one turnover of the grid
+float EnvironmentSystem::timeToCurrentLimit() const {
+    const float rate = currents.getMaxRateOfChange();
+    if (rate <= 0.0f) return NO_DEADLINE;
+    const size_t refreshes = (currents.getTileCount() + TILES_PER_REFRESH - 1) / TILES_PER_REFRESH;
+    const float turnover = static_cast<float>(refreshes) * REFRESH_INTERVAL;
+    const float gap = std::fabs(launchLimits.maxCurrent - ownShipCurrent);
+    return std::max(gap / rate - turnover, refreshTimer);
+}
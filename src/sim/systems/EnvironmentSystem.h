@@ -1,13 +1,65 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <random>
 #include "../ISystem.h"
+#include "../world/OceanCurrentField.h"
+#include "../world/SoundSpeedProfile.h"
+
+// launch weather limits, checked against own ship (the world origin)
+struct LaunchLimits {
+    float maxSeaState = 5.0f;     // douglas scale
+    float maxCurrent = 6.0f;      // units/s of water past the launch tubes
+};
 
 class EnvironmentSystem : public ISystem {
 public:
+    // the current field refreshes TILES_PER_REFRESH tiles every
+    // REFRESH_INTERVAL, so the whole grid turns over every couple of seconds
+    static constexpr float REFRESH_INTERVAL = 0.25f;
+    static constexpr size_t TILES_PER_REFRESH = 2;
+
+    EnvironmentSystem() : EnvironmentSystem(std::random_device{}()) {}
+    explicit EnvironmentSystem(uint32_t seed);
+
     const char* getName() const override { return "EnvironmentSystem"; }
-    void update(SimulationState& state, float /*dt*/) override {
-        state.launchConditionsFavorable = true;
-        state.launchTubeIntegrity = true;
+    void update(SimulationState& state, float dt) override;
+
+    // the next time the launch limits can flip: the sea state crossing
+    // maxSeaState, solved from its closed form, or the own-ship current
+    // reaching maxCurrent at the field's fastest rate of change. a longer
+    // update catches the tile refreshes up instead of scheduling each one
+    float getNextDeadline(const SimulationState& state) const override;
+
+    // water column for this scenario; the sonar solves its propagation from it at load
+    void setSoundSpeedProfile(const SoundSpeedProfile& profile) { soundSpeed = profile; }
+    const SoundSpeedProfile& getSoundSpeedProfile() const { return soundSpeed; }
+
+    const OceanCurrentField& getCurrentField() const { return currents; }
+
+    void setLaunchLimits(const LaunchLimits& limits) { launchLimits = limits; }
+    const LaunchLimits& getLaunchLimits() const { return launchLimits; }
+
+    float getSeaState() const { return seaState; }
+    float getOwnShipCurrent() const { return ownShipCurrent; }
+
+private:
+    void updateSeaState();
+    void updateOwnShipCurrent();
+    float timeToSeaStateLimit() const;
+    float timeToCurrentLimit() const;
+
+    SoundSpeedProfile soundSpeed = SoundSpeedProfile::typical();
+    OceanCurrentField currents;
+    LaunchLimits launchLimits;
+
+    float clock = 0.0f;
+    float refreshTimer = REFRESH_INTERVAL;
 
-    }
-};
\ No newline at end of file
+    // sea state swells and settles over SEA_STATE_PERIOD from a seeded phase
+    static constexpr float SEA_STATE_PERIOD = 1200.0f;
+    float seaPhase = 0.0f;
+    float seaState = 0.0f;
+    float ownShipCurrent = 0.0f;
+};
@@ -1,6 +1,7 @@
 #include "FriendlySafetySystem.h"
 #include "../SimulationState.h"
 #include <cmath>
+#include "../world/WorldKernels.h"
 
 void FriendlySafetySystem::update(SimulationState& state, float dt) {
     // use friendly blast radius check
@@ -25,18 +26,14 @@ bool FriendlySafetySystem::checkFriendlyUnitsInBlastRadius(Vector2 blastCenter)
         return true;
     }
     
-    // calcuate blast radius range
+    // gather visible friendlies, then scan them in one pass
+    friendlyPositions.clear();
     for (const auto& contact : contacts) {
         if (contact.type == ContactType::FriendlySub && contact.isVisible) {
-            float dx = contact.position.x - blastCenter.x;
-            float dy = contact.position.y - blastCenter.y;
-            float distance = std::sqrt(dx * dx + dy * dy);
-            
-            if (distance <= BLAST_RADIUS) {
-                return true;
-            }
+            friendlyPositions.push_back(contact.position);
         }
     }
     
-    return false;
+    return WorldKernels::firstWithinRadius(friendlyPositions.data(), friendlyPositions.size(),
+                                           blastCenter, BLAST_RADIUS) < friendlyPositions.size();
 }
@@ -4,6 +4,7 @@
 #include "../world/CrosshairManager.h"
 #include "../world/ContactManager.h"
 #include <raylib.h>
+#include <vector>
 
 class FriendlySafetySystem : public ISystem {
 public:
@@ -13,10 +14,16 @@ public:
     const char* getName() const override { return "FriendlySafetySystem"; }
     void update(SimulationState& state, float dt) override;
 
+    // re-checks the blast radius each update; nothing timed
+    float getNextDeadline(const SimulationState& /*state*/) const override { return NO_DEADLINE; }
+
 private:
     CrosshairManager& crosshairManager;
     ContactManager& contactManager;
     
     static constexpr float BLAST_RADIUS = 35.0f;
     bool checkFriendlyUnitsInBlastRadius(Vector2 blastCenter) const;
+
+    // scratch for the blast scan, reused every tick
+    mutable std::vector<Vector2> friendlyPositions;
 };
@@ -3,12 +3,10 @@
 #include <iomanip>
 
 bool ArmingPhase::isArmingComplete(float armingTimer) {
-    const float ARMING_DURATION = 2.0f;
     return armingTimer >= ARMING_DURATION;
 }
 
 std::string ArmingPhase::getArmingMessage(float armingTimer) {
-    const float ARMING_DURATION = 2.0f;
     int progress = static_cast<int>((armingTimer / ARMING_DURATION) * 100);
     
     std::stringstream ss;
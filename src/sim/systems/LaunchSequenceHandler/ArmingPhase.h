@@ -6,6 +6,8 @@
 
 class ArmingPhase {
 public:
+    static constexpr float ARMING_DURATION = 2.0f;   // seconds
+
     static bool isArmingComplete(float armingTimer);
     static std::string getArmingMessage(float armingTimer);
 };
\ No newline at end of file
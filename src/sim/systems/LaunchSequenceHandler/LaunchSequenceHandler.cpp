@@ -193,7 +193,7 @@ void LaunchSequenceHandler::update(SimulationState& state, float dt) {
     if (currentPhase == CurrentLaunchPhase::Launched) {
         launchedTimer += dt;
         
-        if (launchedTimer >= 2.0f) { 
+        if (launchedTimer >= LAUNCHED_DURATION) { 
             // reset flow after launch
             currentPhase = CurrentLaunchPhase::Resetting;
             launchedTimer = 0.0f;
@@ -255,6 +255,16 @@ void LaunchSequenceHandler::update(SimulationState& state, float dt) {
     }
 }
 
+float LaunchSequenceHandler::getNextDeadline(const SimulationState& /*state*/) const {
+    switch (currentPhase) {
+        case CurrentLaunchPhase::Arming: return ArmingPhase::ARMING_DURATION - armingTimer;
+        case CurrentLaunchPhase::Launching: return LaunchingPhase::LAUNCHING_DURATION - launchingTimer;
+        case CurrentLaunchPhase::Launched: return LAUNCHED_DURATION - launchedTimer;
+        case CurrentLaunchPhase::Resetting: return ResettingPhase::RESET_DURATION - resetTimer;
+        default: return NO_DEADLINE;
+    }
+}
+
 // methods to check simulation state conditions
 bool LaunchSequenceHandler::checkTargetValidated(const SimulationState& state) {
     return state.targetValidated;
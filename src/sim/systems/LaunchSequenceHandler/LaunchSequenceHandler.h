@@ -34,6 +34,8 @@ public:
     // ISystem interface implementation
     const char* getName() const override;
     void update(SimulationState& state, float dt) override;
+    // the running phase timer's expiry; other phases only react to state
+    float getNextDeadline(const SimulationState& state) const override;
 
     static bool checkTargetValidated(const SimulationState& state);
     static bool checkTargetAcquired(const SimulationState& state);
@@ -54,4 +56,6 @@ private:
     float armingTimer;
     float launchingTimer;
     float launchedTimer;
+
+    static constexpr float LAUNCHED_DURATION = 2.0f;   // seconds
 };
@@ -6,6 +6,8 @@
 
 class LaunchingPhase {
 public:
+    static constexpr float LAUNCHING_DURATION = 1.0f;   // seconds
+
     static bool isLaunchingComplete(float launchingTimer);
     static std::string getLaunchingMessage(float launchingTimer);
 };
@@ -6,6 +6,8 @@
 
 class ResettingPhase {
 public:
+    static constexpr float RESET_DURATION = 2.0f;   // seconds
+
     static bool isResetComplete(float resetTimer);
     static std::string getResetMessage(float resetTimer);
 };
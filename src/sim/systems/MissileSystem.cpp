@@ -1,5 +1,6 @@
 #include "MissileSystem.h"
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 
 // main missile system update loop - handles launches, targeting, and explosions
@@ -9,6 +10,7 @@ void MissileSystem::update(SimulationState& state, float dt) {
     }
     
     // if target is lost, explode the missile
+    size_t guidedIndex = SIZE_MAX;
     if (state.missileActive) {
         uint32_t trackedContactId = crosshairManager.getTrackedContactId();
         
@@ -30,26 +32,26 @@ void MissileSystem::update(SimulationState& state, float dt) {
             for (size_t i = 0; i < contacts.size(); ++i) {
                 if (contacts[i].id == trackedContactId) {
                     missileManager.updateMissileTargets(static_cast<uint32_t>(i));
+                    guidedIndex = i;
                     break;
                 }
             }
         }
     }
     
-    std::vector<Vector2> targetPositions = getTargetPositions();
-    missileManager.updateMissilePhysics(dt, targetPositions);
+    // contacts don't move during this update. collisions use where they
+    // really are; guidance steers for the crosshair's track estimate
+    fillTargetPositions(targetPositions);
+    guidancePositions = targetPositions;
+    if (guidedIndex < guidancePositions.size()) {
+        guidancePositions[guidedIndex] = crosshairManager.getCrosshairPosition();
+    }
+    missileManager.updateMissilePhysics(dt, guidancePositions);
     
     missileManager.updateExplosions(dt);
     
     // collision detection
-    std::vector<uint32_t> hitContactIds;
-    std::vector<Vector2> contactPositions;
-    
-    for (const auto& contact : contactManager.getActiveContacts()) {
-        contactPositions.push_back(contact.position);
-    }
-    
-    missileManager.checkCollisions(contactPositions, hitContactIds);
+    missileManager.checkCollisions(targetPositions, hitContactIds);
     
     if (!hitContactIds.empty()) {
         handleExplosions(hitContactIds);
@@ -105,15 +107,13 @@ void MissileSystem::triggerLaunch(SimulationState& state) {
     }
 }
 
-// getss all contact positions for missile guidance
-std::vector<Vector2> MissileSystem::getTargetPositions() const {
-    std::vector<Vector2> positions;
+// gets all contact positions for missile guidance
+void MissileSystem::fillTargetPositions(std::vector<Vector2>& positions) const {
+    positions.clear();
     
     for (const auto& contact : contactManager.getActiveContacts()) {
         positions.push_back(contact.position);
     }
-    
-    return positions;
 }
 
 // removes contacts that got blown up by missiles
@@ -122,6 +122,8 @@ void MissileSystem::handleExplosions(const std::vector<uint32_t>& hitContactIds)
         const auto& contacts = contactManager.getActiveContacts();
         if (contactIndex < contacts.size()) {
             uint32_t contactId = contacts[contactIndex].id;
+            if (contacts[contactIndex].type == ContactType::EnemySub) enemyKills++;
+            if (contacts[contactIndex].type == ContactType::FriendlySub) friendlyKills++;
             contactManager.removeContact(contactId);
         }
     }
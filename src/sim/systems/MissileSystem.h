@@ -14,14 +14,33 @@ public:
     const char* getName() const override { return "MissileSystem"; }
     void update(SimulationState& state, float dt) override;
 
+    // guidance and blasts need fixed steps; an idle tube has nothing scheduled
+    float getNextDeadline(const SimulationState& state) const override {
+        const bool busy = state.missileLaunched || state.missileActive ||
+                          !missileManager.getActiveMissiles().empty() ||
+                          !missileManager.getActiveExplosions().empty();
+        return busy ? 0.0f : NO_DEADLINE;
+    }
+
     // handles missile launch logic
     void triggerLaunch(SimulationState& state);
+
+    // running tally of contacts destroyed by type
+    uint32_t getEnemyKills() const { return enemyKills; }
+    uint32_t getFriendlyKills() const { return friendlyKills; }
     
 private:
     MissileManager& missileManager;
     ContactManager& contactManager;
     CrosshairManager& crosshairManager;
+    uint32_t enemyKills = 0;
+    uint32_t friendlyKills = 0;
+    
+    // per-tick scratch, reused to avoid reallocating
+    std::vector<Vector2> targetPositions;
+    std::vector<Vector2> guidancePositions;
+    std::vector<uint32_t> hitContactIds;
     
-    std::vector<Vector2> getTargetPositions() const;
+    void fillTargetPositions(std::vector<Vector2>& positions) const;
     void handleExplosions(const std::vector<uint32_t>& hitContactIds);
 };
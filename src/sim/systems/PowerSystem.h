@@ -20,6 +20,17 @@ public:
         state.powerSupplyStable = (desiredPower > 0.5f) && (batteryLevel > 0.0f);
     }
 
+    // linear charge and drain, clamped at the ends, so any dt is exact
+    bool integratesAnalytically() const override { return true; }
+
+    // the battery runs flat, or finishes charging, at a known time
+    float getNextDeadline(const SimulationState& /*state*/) const override {
+        if (desiredPower > 0.5f) {
+            return batteryLevel > 0.0f ? batteryLevel / batteryDrainRate : NO_DEADLINE;
+        }
+        return batteryLevel < 100.0f ? (100.0f - batteryLevel) / batteryChargeRate : NO_DEADLINE;
+    }
+
     void setPowerLevel(float level) { desiredPower = level; }
     void setPowerState(bool isOn) { desiredPower = isOn ? 1.0f : 0.0f; }
     float getPowerLevel() const { return desiredPower; }
@@ -1,40 +1,119 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include "../ISystem.h"
 #include "../SimulationState.h"
 #include "../world/ContactManager.h"
+#include "../world/ContactTracker.h"
+#include "../world/SonarDetection.h"
+#include "../world/SonarSweep.h"
+#include "../world/ScenarioLimits.h"
+
+// Passive: every contact is evaluated each ping. Sweep: a rotating beam
+// evaluates only the contacts it crosses each tick.
+enum class SonarMode { Passive, Sweep };
 
 class SonarSystem : public ISystem {
 public:
+    static constexpr float PING_INTERVAL = 0.5f;
+
     explicit SonarSystem(ContactManager& contacts) : contactManager(contacts) {}
     const char* getName() const override { return "SonarSystem"; }
 
-    // manages contact movement, spawning, and target selection
+    void seed(uint32_t value) { detection.seed(value); }
+
+    // manages contact movement, spawning, detection, tracking and target selection
     void update(SimulationState& state, float dt) override {
+        tracker.advance(dt);
         contactManager.updateContactPositions(dt);
         contactManager.updateSpawnTimer(dt);
         contactManager.spawnContactsIfNeeded();
         contactManager.removeOutOfBoundsContacts();
 
+        if (mode == SonarMode::Sweep) {
+            updateSweep(state, dt);
+        } else {
+            // the first update pings straight away so the display isn't empty
+            pingTimer -= dt;
+            if (pingTimer <= 0.0f) {
+                detection.setOwnDepth(state.currentDepthMeters);
+                detection.ping(contactManager);
+                tracker.update(contactManager);
+                pingTimer += PING_INTERVAL;
+                if (pingTimer <= 0.0f) pingTimer = PING_INTERVAL;
+            }
+        }
         
         // Ensure the selected target is valid
         if (selectedTargetId != 0 && !contactManager.isContactAlive(selectedTargetId)) {
             selectedTargetId = 0;
         }
         if (selectedTargetId == 0) {
-            selectedTargetId = contactManager.getNearestContactId({0,0});
+            selectedTargetId = tracker.getNearestContactId({0,0});
         }
+        updatedRevision = contactManager.getRevision();
+    }
+
+    // contacts that only drift can be jumped to the next ping or spawn.
+    // schooling fish, the sweep, and contacts added since the last update
+    // (whose schooling hasn't run yet) keep fixed steps
+    float getNextDeadline(const SimulationState& /*state*/) const override {
+        if (mode == SonarMode::Sweep || contactManager.getSchooling().getSteeredCount() > 0 ||
+            contactManager.getRevision() != updatedRevision) {
+            return 0.0f;
+        }
+        return std::min(pingTimer, contactManager.getTimeToNextSpawn());
     }
 
     void attemptManualLock(const Vector2& worldPos) {
-        selectedTargetId = contactManager.getNearestContactId(worldPos, 40.0f);
+        selectedTargetId = tracker.getNearestContactId(worldPos, 40.0f);
     }
 
     uint32_t getSelectedTargetId() const { return selectedTargetId; }
 
+    SonarDetectionModel& getDetectionModel() { return detection; }
+    const SonarDetectionModel& getDetectionModel() const { return detection; }
+
+    ContactTracker& getTracker() { return tracker; }
+    const ContactTracker& getTracker() const { return tracker; }
+
+    // sizes detection, tracking and sweep scratch for the scenario's contacts
+    void setFixedFootprint(const ScenarioLimits& limits) {
+        detection.reserve(limits.contactPool());
+        tracker.reserve(limits.contactPool());
+        sweep.reserve(limits.contactPool());
+    }
+
+    void setMode(SonarMode m) {
+        if (m == mode) return;
+        mode = m;
+        sweep.reset();
+        pingTimer = 0.0f;
+    }
+    SonarMode getMode() const { return mode; }
+    const SonarSweep& getSweep() const { return sweep; }
+
 private:
+    // contacts in the swept sector are detected every tick; the tracker
+    // takes the picture once per revolution, when every bearing has been seen
+    void updateSweep(SimulationState& state, float dt) {
+        detection.setOwnDepth(state.currentDepthMeters);
+        const bool scanComplete = sweep.advance(contactManager, dt);
+        const auto& swept = sweep.getSwept();
+        detection.pingContacts(contactManager, swept.data(), swept.size());
+        if (scanComplete) {
+            tracker.update(contactManager);
+            detection.startScan();
+        }
+    }
+
     ContactManager& contactManager;
+    SonarDetectionModel detection;
+    ContactTracker tracker;
+    SonarSweep sweep;
+    SonarMode mode = SonarMode::Passive;
+    float pingTimer = 0.0f;
+    uint32_t updatedRevision = 0;   // contact revision as of the last update
     uint32_t selectedTargetId = 0;
 };
-
-
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "../ISystem.h"
+#include "../SimulationState.h"
+#include "../world/ContactManager.h"
+#include "../world/MissileManager.h"
+#include "../world/SubmarineBehaviors.h"
+#include "../world/ScenarioLimits.h"
+
+// manoeuvres the enemy and friendly submarines. runs before the sonar moves
+// the contacts, so this tick's steering is integrated straight away.
+class SubmarineBehaviorSystem : public ISystem {
+public:
+    SubmarineBehaviorSystem(ContactManager& contacts, const MissileManager& missiles)
+        : contactManager(contacts), missileManager(missiles) {}
+    const char* getName() const override { return "SubmarineBehaviorSystem"; }
+
+    void seed(uint32_t value) { behaviors.seed(value); }
+
+    void update(SimulationState& /*state*/, float dt) override {
+        threats.clear();
+        for (const Missile& m : missileManager.getActiveMissiles()) {
+            if (m.active) threats.push_back(m.position);
+        }
+        behaviors.update(contactManager, threats, dt);
+    }
+
+    // steering is continuous, so fixed steps until every sub has settled on
+    // its course, then the next decision
+    float getNextDeadline(const SimulationState& /*state*/) const override {
+        return behaviors.getNextDeadline(contactManager);
+    }
+
+    void setFixedFootprint(const ScenarioLimits& limits) {
+        behaviors.reserve(limits.contactPool());
+        threats.reserve(limits.maxMissiles);
+    }
+    size_t getMemoryBytes() const { return behaviors.getMemoryBytes() + threats.capacity() * sizeof(Vector2); }
+
+    SubmarineBehaviors& getBehaviors() { return behaviors; }
+    const SubmarineBehaviors& getBehaviors() const { return behaviors; }
+
+private:
+    ContactManager& contactManager;
+    const MissileManager& missileManager;
+    SubmarineBehaviors behaviors;
+
+    // missile positions, reused every tick
+    std::vector<Vector2> threats;
+};
@@ -11,6 +11,9 @@ public:
         : crosshairManager(crosshair), contactManager(contacts) {}
     
     const char* getName() const override { return "TargetAcquisitionSystem"; }
+
+    // follows the crosshair each update; nothing timed
+    float getNextDeadline(const SimulationState& /*state*/) const override { return NO_DEADLINE; }
     
     // manages the targetAcquired condition if crosshair is tracking
     void update(SimulationState& state, float dt) override {
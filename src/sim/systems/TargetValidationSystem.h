@@ -12,6 +12,9 @@ public:
         : crosshairManager(crosshair), contactManager(contacts) {}
     
     const char* getName() const override { return "TargetValidationSystem"; }
+
+    // re-checks the tracked contact each update; nothing timed
+    float getNextDeadline(const SimulationState& /*state*/) const override { return NO_DEADLINE; }
     
     // check if acquired target is an enemy sub or not
     void update(SimulationState& state, float dt) override {
@@ -9,6 +9,7 @@ public:
     void update(SimulationState& state, float /*dt*/) override {
         state.targetingStability = stability;
     }
+    float getNextDeadline(const SimulationState& /*state*/) const override { return NO_DEADLINE; }
 
     void adjustStability(float delta) { stability = std::clamp(stability + delta, 0.0f, 1.0f); }
     float getStability() const { return stability; }
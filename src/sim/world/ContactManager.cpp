@@ -1,6 +1,10 @@
 #include "ContactManager.h"
+#include "WorldBounds.h"
+#include "WorldKernels.h"
 #include <cmath>
 #include <algorithm>
+#include <iostream>
+#include <limits>
 #include <random>
 #include <raylib.h>
 
@@ -8,29 +12,46 @@
 #define PI 3.14159265359f
 #endif
 
-static float rand01() {
-    static std::mt19937 rng{std::random_device{}()};
-    static std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    return dist(rng);
+ContactManager::ContactManager() : rng(std::random_device{}()) {
+    spawnTimer = 1.5f;
 }
 
-ContactManager::ContactManager() {
-    spawnTimer = 1.5f;
+// reseed for reproducible runs (headless worlds, tests)
+void ContactManager::seed(uint32_t value) {
+    rng.seed(value);
+}
+
+float ContactManager::rand01() {
+    return std::uniform_real_distribution<float>(0.0f, 1.0f)(rng);
+}
+
+int ContactManager::randInt(int min, int max) {
+    return std::uniform_int_distribution<int>(min, max)(rng);
+}
+
+void ContactManager::setFixedFootprint(const ScenarioLimits& limits) {
+    maxContacts = limits.contactPool();
+    activeContacts.reserve(maxContacts);
+    schooling.reserve(maxContacts);
+    fixedFootprint = true;
 }
 
 // creates a new contact with random position and type
 uint32_t ContactManager::spawnContact() {
+    if (fixedFootprint && activeContacts.size() >= maxContacts) {
+        std::cerr << "[ContactManager] contact pool full (" << maxContacts << "), spawn refused" << std::endl;
+        return 0;
+    }
+
     SonarContact c{};
     c.id = nextContactId++;
-    
-    if (nextContactId > 128) {
-        nextContactId = 1;
-    }
-    
-    c.position = { (float)GetRandomValue(-500, 500), (float)GetRandomValue(-300, 300) };
+
+    c.position = { (float)randInt(-500, 500), (float)randInt(-300, 300) };
+    c.previousPosition = c.position;
     
     c.velocityDirRad = rand01() * 2.0f * PI;
     c.speed = 10.0f + rand01() * 20.0f;
+    c.velocity = { cosf(c.velocityDirRad) * c.speed, sinf(c.velocityDirRad) * c.speed };
     
     // ensures at least one enemy is on the board
     bool hasEnemyAlready = false;
@@ -53,21 +74,59 @@ uint32_t ContactManager::spawnContact() {
     }
     
     activeContacts.push_back(c);
+    ++revision;
     return c.id;
 }
 
+size_t ContactManager::spawnSchool(Vector2 centre, size_t count, float radius) {
+    const float heading = rand01() * 2.0f * PI;
+    size_t spawned = 0;
+    for (; spawned < count; ++spawned) {
+        if (fixedFootprint && activeContacts.size() >= maxContacts) break;
+
+        SonarContact c{};
+        c.id = nextContactId++;
+
+        // uniform over the disc
+        const float r = radius * std::sqrt(rand01());
+        const float a = rand01() * 2.0f * PI;
+        c.position = { centre.x + cosf(a) * r, centre.y + sinf(a) * r };
+        c.previousPosition = c.position;
+
+        c.velocityDirRad = heading + (rand01() - 0.5f) * 0.6f;
+        c.speed = 10.0f + rand01() * 10.0f;
+        c.velocity = { cosf(c.velocityDirRad) * c.speed, sinf(c.velocityDirRad) * c.speed };
+        c.type = ContactType::Fish;
+        c.schooled = true;
+        activeContacts.push_back(c);
+    }
+    schooledCount += spawned;
+    if (spawned > 0) ++revision;
+    return spawned;
+}
+
 void ContactManager::removeContact(uint32_t id) {
+    for (const auto& c : activeContacts) {
+        if (c.id == id && c.schooled) --schooledCount;
+    }
     activeContacts.erase(std::remove_if(activeContacts.begin(), activeContacts.end(), [id](const SonarContact& c){return c.id==id;}), activeContacts.end());
+    ++revision;
 }
 
-void ContactManager::clearAllContacts() { activeContacts.clear(); }
+void ContactManager::clearAllContacts() {
+    activeContacts.clear();
+    schooledCount = 0;
+    ++revision;
+}
 
 uint32_t ContactManager::getNearestContactId(Vector2 position, float maxDistance) const {
     uint32_t bestId = 0;
     float bestDist2 = maxDistance * maxDistance;
     for (const auto& c : activeContacts) {
-        const float dx = c.position.x - position.x;
-        const float dy = c.position.y - position.y;
+        if (!c.isVisible) continue;
+        const Vector2 perceived = c.perceivedPosition();
+        const float dx = perceived.x - position.x;
+        const float dy = perceived.y - position.y;
         const float d2 = dx*dx + dy*dy;
         if (d2 < bestDist2) { bestDist2 = d2; bestId = c.id; }
     }
@@ -78,10 +137,47 @@ bool ContactManager::isContactAlive(uint32_t id) const {
     for (const auto& c : activeContacts) if (c.id == id) return true; return false;
 }
 
+void ContactManager::setVelocity(size_t index, Vector2 velocity) {
+    SonarContact& c = activeContacts[index];
+    c.velocity = velocity;
+    c.speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+    c.velocityDirRad = std::atan2(velocity.y, velocity.x);
+}
+
 void ContactManager::updateContactPositions(float dt) {
-    for (auto& contact : activeContacts) {
-        contact.position.x += cosf(contact.velocityDirRad) * contact.speed * dt;
-        contact.position.y += sinf(contact.velocityDirRad) * contact.speed * dt;
+    if (activeContacts.empty()) return;
+    schooling.update(activeContacts, dt);
+    SonarContact& first = activeContacts.front();
+    WorldKernels::integrate(&first.position, &first.previousPosition, &first.velocity,
+                            activeContacts.size(), sizeof(SonarContact), dt);
+    if (currentField) currentField->advect(&first.position, activeContacts.size(), sizeof(SonarContact), dt);
+}
+
+namespace {
+
+void applyDetection(SonarContact& c, bool detected, Vector2 error, uint8_t holdPings) {
+    if (detected) {
+        c.missedPings = 0;
+        c.detectionError = error;
+        c.isVisible = true;
+    } else if (c.missedPings != SonarContact::NEVER_DETECTED) {
+        if (c.missedPings < SonarContact::NEVER_DETECTED - 1) ++c.missedPings;
+        c.isVisible = c.missedPings <= holdPings;
+    }
+}
+
+}  // namespace
+
+void ContactManager::applyDetections(const uint8_t* detected, const Vector2* errors, uint8_t holdPings) {
+    for (size_t i = 0; i < activeContacts.size(); ++i) {
+        applyDetection(activeContacts[i], detected[i] != 0, errors[i], holdPings);
+    }
+}
+
+void ContactManager::applyDetections(const uint32_t* indices, size_t count, const uint8_t* detected,
+                                     const Vector2* errors, uint8_t holdPings) {
+    for (size_t k = 0; k < count; ++k) {
+        applyDetection(activeContacts[indices[k]], detected[k] != 0, errors[k], holdPings);
     }
 }
 
@@ -89,9 +185,18 @@ void ContactManager::updateSpawnTimer(float dt) {
     spawnTimer -= dt; 
 }
 
+float ContactManager::getTimeToNextSpawn() const {
+    if (isClutterShort()) return 0.0f;
+    if (getLonerCount() >= 20) return std::numeric_limits<float>::infinity();
+    return std::max(spawnTimer, 0.0f);
+}
+
+// the population caps count contacts spawned one at a time; schooled fish
+// are topped up separately, after them, so clutter never crowds out a sub
 void ContactManager::spawnContactsIfNeeded() {
-    while (activeContacts.size() < 10) {
-        spawnContact();
+    while (getLonerCount() < 10) {
+        // a fixed pool smaller than the minimum population stops here
+        if (spawnContact() == 0) break;
     }
     
     // force spawn an enemy if none exist
@@ -100,22 +205,29 @@ void ContactManager::spawnContactsIfNeeded() {
         for (const auto& c : activeContacts) {
             if (c.type == ContactType::EnemySub) { enemyPresent = true; break; }
         }
-        if (!enemyPresent && activeContacts.size() < 20) {
+        if (!enemyPresent && getLonerCount() < 20) {
             spawnContact();
         }
     }
 
-    if (spawnTimer <= 0.0f && activeContacts.size() < 20) {
+    if (spawnTimer <= 0.0f && getLonerCount() < 20) {
         spawnContact();
-        spawnTimer = 1.5f + ((float)GetRandomValue(0, 10000) / 10000.0f) * 2.0f;
+        spawnTimer = 1.5f + ((float)randInt(0, 10000) / 10000.0f) * 2.0f;
+    }
+
+    while (isClutterShort()) {
+        const Vector2 centre = { (float)randInt(-400, 400), (float)randInt(-220, 220) };
+        // a full fixed pool takes no more
+        if (spawnSchool(centre, schoolClutter.fishPerSchool, schoolClutter.radius) < schoolClutter.fishPerSchool) break;
     }
 }
 
 void ContactManager::removeOutOfBoundsContacts() {
     for (auto it = activeContacts.begin(); it != activeContacts.end(); ) {
-        if (it->position.x < -600 || it->position.x > 600 || 
-            it->position.y < -360 || it->position.y > 360) {
+        if (!WorldBounds::contains(it->position)) {
+            if (it->schooled) --schooledCount;
             it = activeContacts.erase(it);
+            ++revision;
         } else {
             ++it;
         }
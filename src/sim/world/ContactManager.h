@@ -1,44 +1,121 @@
 #pragma once
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
+#include <random>
 #include <raylib.h>
+#include "FishSchooling.h"
+#include "OceanCurrentField.h"
+#include "ScenarioLimits.h"
 
 enum class ContactType { EnemySub, FriendlySub, Fish, Debris };
 
 struct SonarContact {
     uint32_t id;
     Vector2 position;
+    Vector2 previousPosition;   // position before the last sim step, for render interpolation
     float velocityDirRad;
     float speed;
+    Vector2 velocity;           // from heading and speed, cached at spawn
     ContactType type;
-    bool isVisible = true;
+
+    // sonar picture: set by each ping, nothing is shown until the first detection
+    static constexpr uint8_t NEVER_DETECTED = 0xFF;
+    bool isVisible = false;
+    uint8_t missedPings = NEVER_DETECTED;
+    bool schooled = false;          // spawned in a school; outside the population caps
+    Vector2 detectionError{0, 0};   // perceived minus true position, from the last detection
+
+    Vector2 perceivedPosition() const { return { position.x + detectionError.x, position.y + detectionError.y }; }
+};
+
+// schools of fish kept on the board as sonar clutter, beside the contacts
+// spawned one at a time. none by default
+struct SchoolClutter {
+    size_t schools = 0;
+    size_t fishPerSchool = 0;
+    float radius = 80.0f;
+
+    size_t fish() const { return schools * fishPerSchool; }
 };
 
 class ContactManager {
 public:
     ContactManager();
 
+    void seed(uint32_t value);
+
     uint32_t spawnContact();
+    // count fish around centre sharing roughly one heading; returns how many fit
+    size_t spawnSchool(Vector2 centre, size_t count, float radius = 40.0f);
     void removeContact(uint32_t id);
     void clearAllContacts();
 
     const std::vector<SonarContact>& getActiveContacts() const { return activeContacts; }
+    // nearest sonar detection, by perceived position
     uint32_t getNearestContactId(Vector2 position, float maxDistance = 25.0f) const;
     bool isContactAlive(uint32_t id) const;
 
+    // contacts drift with the water on top of their own velocity; no field means still water
+    void setCurrentField(const OceanCurrentField* field) { currentField = field; }
+    // steering for the contact at this active index; speed and heading follow
+    void setVelocity(size_t index, Vector2 velocity);
+
+    // fish school first, then everything moves
     void updateContactPositions(float dt);
+    FishSchooling& getSchooling() { return schooling; }
+    const FishSchooling& getSchooling() const { return schooling; }
+    // the spawner forms a new school, at a spot drawn from this manager's
+    // stream, whenever a whole school's worth of clutter has been lost
+    void setSchoolClutter(const SchoolClutter& clutter) { schoolClutter = clutter; }
+    const SchoolClutter& getSchoolClutter() const { return schoolClutter; }
+    size_t getSchooledCount() const { return schooledCount; }
     void updateSpawnTimer(float dt);
+    // sim seconds until the spawn timer next adds a contact; infinite while full
+    float getTimeToNextSpawn() const;
     void spawnContactsIfNeeded();
     void removeOutOfBoundsContacts();
 
+    // one ping's results, indexed like getActiveContacts(). a missed contact
+    // keeps its last perceived offset until holdPings pings in a row miss it
+    void applyDetections(const uint8_t* detected, const Vector2* errors, uint8_t holdPings);
+    // the same for count contacts at the given active indices (one beam sector)
+    void applyDetections(const uint32_t* indices, size_t count, const uint8_t* detected, const Vector2* errors,
+                         uint8_t holdPings);
+
+    // bumped whenever contacts are added or removed, so indices into
+    // getActiveContacts() held across ticks know to refresh
+    uint32_t getRevision() const { return revision; }
+
+    // sizes the pool for limits.contactPool(); spawning past it then fails
+    void setFixedFootprint(const ScenarioLimits& limits);
+    bool isFixedFootprint() const { return fixedFootprint; }
+    size_t getMemoryBytes() const { return activeContacts.capacity() * sizeof(SonarContact); }
+
 
 
     
 private:
     std::vector<SonarContact> activeContacts;
-    uint32_t nextContactId = 1;
+    uint32_t nextContactId = 1;     // ids only go up, so each is unique for the run (0 is no contact)
+    uint32_t revision = 0;
     float spawnTimer = 0.0f;
+    SchoolClutter schoolClutter;
+    size_t schooledCount = 0;
+    bool fixedFootprint = false;
+    size_t maxContacts = 0;
+    const OceanCurrentField* currentField = nullptr;
+    FishSchooling schooling;
+
+    // per-instance rng so independent worlds don't share state
+    std::mt19937 rng;
+    float rand01();
+    int randInt(int min, int max);
+    size_t getLonerCount() const { return activeContacts.size() - schooledCount; }
+    bool isClutterShort() const {
+        return schoolClutter.fishPerSchool > 0 && schooledCount + schoolClutter.fishPerSchool <= schoolClutter.fish();
+    }
 
 };
 
@@ -0,0 +1,370 @@
+#include "ContactTracker.h"
+#include "WorldBounds.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CONTACT_TRACKER_SSE2 1
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define CONTACT_TRACKER_WASM_SIMD 1
+#endif
+
+#if defined(CONTACT_TRACKER_SSE2) || defined(CONTACT_TRACKER_WASM_SIMD)
+    #define CONTACT_TRACKER_VECTOR 1
+#endif
+
+namespace {
+
+// the grid covers the world plus this much, positions past it land in the edge cells
+constexpr float GRID_MARGIN = 100.0f;
+
+// four tracks per vector
+#if defined(CONTACT_TRACKER_SSE2)
+using Floats = __m128;
+inline Floats lanesSplat(float v) { return _mm_set1_ps(v); }
+inline Floats lanesLoad(const float* p) { return _mm_loadu_ps(p); }
+inline void lanesStore(float* p, Floats v) { _mm_storeu_ps(p, v); }
+inline Floats lanesAdd(Floats a, Floats b) { return _mm_add_ps(a, b); }
+inline Floats lanesSub(Floats a, Floats b) { return _mm_sub_ps(a, b); }
+inline Floats lanesMul(Floats a, Floats b) { return _mm_mul_ps(a, b); }
+inline Floats lanesDiv(Floats a, Floats b) { return _mm_div_ps(a, b); }
+#elif defined(CONTACT_TRACKER_WASM_SIMD)
+using Floats = v128_t;
+inline Floats lanesSplat(float v) { return wasm_f32x4_splat(v); }
+inline Floats lanesLoad(const float* p) { return wasm_v128_load(p); }
+inline void lanesStore(float* p, Floats v) { wasm_v128_store(p, v); }
+inline Floats lanesAdd(Floats a, Floats b) { return wasm_f32x4_add(a, b); }
+inline Floats lanesSub(Floats a, Floats b) { return wasm_f32x4_sub(a, b); }
+inline Floats lanesMul(Floats a, Floats b) { return wasm_f32x4_mul(a, b); }
+inline Floats lanesDiv(Floats a, Floats b) { return wasm_f32x4_div(a, b); }
+#endif
+
+// drops the entries of v whose track has missed more than maxMisses pings, preserving order
+template <typename T>
+void compact(std::vector<T>& v, const std::vector<uint8_t>& misses, uint8_t maxMisses) {
+    size_t out = 0;
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (misses[i] <= maxMisses) v[out++] = v[i];
+    }
+    v.resize(out);
+}
+
+}  // namespace
+
+bool ContactTracker::isVectorized() {
+#if defined(CONTACT_TRACKER_VECTOR)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ContactTracker::clear() {
+    for (auto* v : { &x, &y, &vx, &vy, &pPos, &pCross, &pVel }) v->clear();
+    trackIds.clear();
+    contactIds.clear();
+    types.clear();
+    misses.clear();
+    sinceUpdate = 0.0f;
+}
+
+void ContactTracker::reserve(size_t contacts) {
+    const size_t tracks = contacts * (static_cast<size_t>(params.maxMisses) + 1);
+    for (auto* v : { &x, &y, &vx, &vy, &pPos, &pCross, &pVel, &measuredX, &measuredY, &measurementVar,
+                     &hasMeasurement, &cellX, &cellY, &cellPosVar }) {
+        v->reserve(tracks);
+    }
+    for (auto* v : { &trackIds, &contactIds, &cellTracks, &trackCell }) v->reserve(tracks);
+    types.reserve(tracks);
+    misses.reserve(tracks);
+    cellClaimed.reserve(tracks);
+    unmatched.reserve(contacts);
+    unmatchedVar.reserve(contacts);
+    sizeGrid();
+    cellStart.reserve(gridColumns * gridRows + 1);
+}
+
+size_t ContactTracker::getMemoryBytes() const {
+    return (x.capacity() + y.capacity() + vx.capacity() + vy.capacity() + pPos.capacity() + pCross.capacity() +
+            pVel.capacity() + measuredX.capacity() + measuredY.capacity() + measurementVar.capacity() +
+            hasMeasurement.capacity() + cellX.capacity() + cellY.capacity() + cellPosVar.capacity() +
+            unmatchedVar.capacity()) *
+               sizeof(float) +
+           (trackIds.capacity() + contactIds.capacity() + cellStart.capacity() + cellTracks.capacity() +
+            trackCell.capacity()) *
+               sizeof(uint32_t) +
+           types.capacity() * sizeof(ContactType) + (misses.capacity() + cellClaimed.capacity()) * sizeof(uint8_t) +
+           unmatched.capacity() * sizeof(size_t);
+}
+
+float ContactTracker::getPositionSigma(size_t i) const {
+    return std::sqrt(pPos[i]);
+}
+
+void ContactTracker::update(const ContactManager& contacts, Vector2 origin) {
+    predict(sinceUpdate);
+    sinceUpdate = 0.0f;
+
+    const size_t count = x.size();
+    measuredX.assign(count, 0.0f);
+    measuredY.assign(count, 0.0f);
+    measurementVar.assign(count, 1.0f);
+    hasMeasurement.assign(count, 0.0f);
+
+    buildGrid();
+    associate(contacts.getActiveContacts(), origin);
+    correct();
+
+    for (size_t i = 0; i < count; ++i) {
+        if (hasMeasurement[i] != 0.0f) misses[i] = 0;
+        else if (misses[i] < 0xFF) ++misses[i];
+    }
+    retire();
+
+    const auto& active = contacts.getActiveContacts();
+    for (size_t k = 0; k < unmatched.size(); ++k) {
+        startTrack(active[unmatched[k]], unmatchedVar[k]);
+    }
+}
+
+// x += v dt and P = F P F' + Q for the continuous white-acceleration model
+void ContactTracker::predict(float dt) {
+    const size_t count = x.size();
+    const float q = params.processNoise;
+    const float qPos = q * dt * dt * dt / 3.0f;
+    const float qCross = q * dt * dt * 0.5f;
+    const float qVel = q * dt;
+
+    size_t i = 0;
+#if defined(CONTACT_TRACKER_VECTOR)
+    const Floats step = lanesSplat(dt);
+    const Floats two = lanesSplat(2.0f);
+    const Floats noisePos = lanesSplat(qPos), noiseCross = lanesSplat(qCross), noiseVel = lanesSplat(qVel);
+    for (; i + 4 <= count; i += 4) {
+        lanesStore(&x[i], lanesAdd(lanesLoad(&x[i]), lanesMul(lanesLoad(&vx[i]), step)));
+        lanesStore(&y[i], lanesAdd(lanesLoad(&y[i]), lanesMul(lanesLoad(&vy[i]), step)));
+
+        const Floats p00 = lanesLoad(&pPos[i]);
+        const Floats p01 = lanesLoad(&pCross[i]);
+        const Floats p11 = lanesLoad(&pVel[i]);
+        const Floats dtP11 = lanesMul(step, p11);
+        lanesStore(&pPos[i], lanesAdd(lanesAdd(p00, lanesMul(step, lanesAdd(lanesMul(two, p01), dtP11))), noisePos));
+        lanesStore(&pCross[i], lanesAdd(lanesAdd(p01, dtP11), noiseCross));
+        lanesStore(&pVel[i], lanesAdd(p11, noiseVel));
+    }
+#endif
+    for (; i < count; ++i) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+
+        const float p00 = pPos[i], p01 = pCross[i], p11 = pVel[i];
+        const float dtP11 = dt * p11;
+        pPos[i] = p00 + dt * (2.0f * p01 + dtP11) + qPos;
+        pCross[i] = p01 + dtP11 + qCross;
+        pVel[i] = p11 + qVel;
+    }
+}
+
+size_t ContactTracker::columnOf(float px) const {
+    const float g = (px + WorldBounds::HALF_WIDTH + GRID_MARGIN) / params.gridCell;
+    return static_cast<size_t>(std::min(std::max(g, 0.0f), static_cast<float>(gridColumns - 1)));
+}
+
+size_t ContactTracker::rowOf(float py) const {
+    const float g = (py + WorldBounds::HALF_HEIGHT + GRID_MARGIN) / params.gridCell;
+    return static_cast<size_t>(std::min(std::max(g, 0.0f), static_cast<float>(gridRows - 1)));
+}
+
+void ContactTracker::sizeGrid() {
+    gridColumns = static_cast<size_t>(std::ceil((WorldBounds::WIDTH + 2.0f * GRID_MARGIN) / params.gridCell));
+    gridRows = static_cast<size_t>(std::ceil((WorldBounds::HEIGHT + 2.0f * GRID_MARGIN) / params.gridCell));
+}
+
+// counting sort of the predicted tracks into cells: cellTracks holds track
+// indices grouped by cell, cellStart[c]..cellStart[c + 1] is cell c's range.
+// the fields the scan needs are copied in the same order so it reads them
+// contiguously
+void ContactTracker::buildGrid() {
+    sizeGrid();
+    const size_t cells = gridColumns * gridRows;
+    const size_t count = x.size();
+
+    cellStart.assign(cells + 1, 0);
+    trackCell.resize(count);
+    largestPosVar = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        trackCell[i] = static_cast<uint32_t>(rowOf(y[i]) * gridColumns + columnOf(x[i]));
+        ++cellStart[trackCell[i] + 1];
+        largestPosVar = std::max(largestPosVar, pPos[i]);
+    }
+    for (size_t c = 0; c < cells; ++c) cellStart[c + 1] += cellStart[c];
+
+    cellTracks.resize(count);
+    cellX.resize(count);
+    cellY.resize(count);
+    cellPosVar.resize(count);
+    cellClaimed.assign(count, 0);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t slot = cellStart[trackCell[i]]++;
+        cellTracks[slot] = static_cast<uint32_t>(i);
+        cellX[slot] = x[i];
+        cellY[slot] = y[i];
+        cellPosVar[slot] = pPos[i];
+    }
+    // the fill advanced each start to its end; shift back
+    for (size_t c = cells; c > 0; --c) cellStart[c] = cellStart[c - 1];
+    cellStart[0] = 0;
+}
+
+// each detection takes the free track with the smallest normalised
+// innovation inside the gate. the search covers the cells within the
+// widest gate any track could have for this detection; cells are row
+// major, so each row of the window is one contiguous run
+void ContactTracker::associate(const std::vector<SonarContact>& contacts, Vector2 origin) {
+    unmatched.clear();
+    unmatchedVar.clear();
+    const float gateSq = params.gateSigmas * params.gateSigmas;
+    const float minVar = params.minMeasurementNoise * params.minMeasurementNoise;
+
+    for (size_t d = 0; d < contacts.size(); ++d) {
+        const SonarContact& contact = contacts[d];
+        if (contact.missedPings != 0) continue;
+
+        const Vector2 m = contact.perceivedPosition();
+        const float rx = m.x - origin.x, ry = m.y - origin.y;
+        const float sigma = params.measurementNoiseFraction * std::sqrt(rx * rx + ry * ry);
+        const float variance = std::max(sigma * sigma, minVar);
+
+        const float reach = std::min(params.maxGate, params.gateSigmas * std::sqrt(largestPosVar + variance));
+        const float reachSq = reach * reach;
+        const size_t x0 = columnOf(m.x - reach), x1 = columnOf(m.x + reach);
+        const size_t y0 = rowOf(m.y - reach), y1 = rowOf(m.y + reach);
+        uint32_t bestSlot = 0;
+        float bestScore = gateSq;
+        bool found = false;
+        for (size_t ny = y0; ny <= y1; ++ny) {
+            const uint32_t end = cellStart[ny * gridColumns + x1 + 1];
+            for (uint32_t k = cellStart[ny * gridColumns + x0]; k < end; ++k) {
+                const float dx = m.x - cellX[k], dy = m.y - cellY[k];
+                const float distSq = dx * dx + dy * dy;
+                // both axes together: chi-square with two degrees of freedom
+                const float score = distSq / (cellPosVar[k] + variance);
+                if (distSq <= reachSq && score < bestScore && !cellClaimed[k]) {
+                    bestScore = score;
+                    bestSlot = k;
+                    found = true;
+                }
+            }
+        }
+
+        if (!found) {
+            unmatched.push_back(d);
+            unmatchedVar.push_back(variance);
+            continue;
+        }
+        cellClaimed[bestSlot] = 1;
+        const uint32_t best = cellTracks[bestSlot];
+        hasMeasurement[best] = 1.0f;
+        measuredX[best] = m.x;
+        measuredY[best] = m.y;
+        measurementVar[best] = variance;
+        contactIds[best] = contact.id;
+        types[best] = contact.type;
+    }
+}
+
+// kalman correction with H = [1 0]. tracks without a detection get zero
+// gain, so one branch-free pass covers them all
+void ContactTracker::correct() {
+    const size_t count = x.size();
+    size_t i = 0;
+#if defined(CONTACT_TRACKER_VECTOR)
+    for (; i + 4 <= count; i += 4) {
+        const Floats p00 = lanesLoad(&pPos[i]);
+        const Floats p01 = lanesLoad(&pCross[i]);
+        const Floats p11 = lanesLoad(&pVel[i]);
+        const Floats gain = lanesDiv(lanesLoad(&hasMeasurement[i]), lanesAdd(p00, lanesLoad(&measurementVar[i])));
+        const Floats k0 = lanesMul(p00, gain);
+        const Floats k1 = lanesMul(p01, gain);
+
+        const Floats px = lanesLoad(&x[i]), py = lanesLoad(&y[i]);
+        const Floats ix = lanesSub(lanesLoad(&measuredX[i]), px);
+        const Floats iy = lanesSub(lanesLoad(&measuredY[i]), py);
+        lanesStore(&x[i], lanesAdd(px, lanesMul(k0, ix)));
+        lanesStore(&y[i], lanesAdd(py, lanesMul(k0, iy)));
+        lanesStore(&vx[i], lanesAdd(lanesLoad(&vx[i]), lanesMul(k1, ix)));
+        lanesStore(&vy[i], lanesAdd(lanesLoad(&vy[i]), lanesMul(k1, iy)));
+
+        lanesStore(&pPos[i], lanesSub(p00, lanesMul(k0, p00)));
+        lanesStore(&pCross[i], lanesSub(p01, lanesMul(k0, p01)));
+        lanesStore(&pVel[i], lanesSub(p11, lanesMul(k1, p01)));
+    }
+#endif
+    for (; i < count; ++i) {
+        const float p00 = pPos[i], p01 = pCross[i], p11 = pVel[i];
+        const float gain = hasMeasurement[i] / (p00 + measurementVar[i]);
+        const float k0 = p00 * gain;
+        const float k1 = p01 * gain;
+
+        const float ix = measuredX[i] - x[i];
+        const float iy = measuredY[i] - y[i];
+        x[i] = x[i] + k0 * ix;
+        y[i] = y[i] + k0 * iy;
+        vx[i] = vx[i] + k1 * ix;
+        vy[i] = vy[i] + k1 * iy;
+
+        pPos[i] = p00 - k0 * p00;
+        pCross[i] = p01 - k0 * p01;
+        pVel[i] = p11 - k1 * p01;
+    }
+}
+
+void ContactTracker::retire() {
+    const uint8_t limit = params.maxMisses;
+    if (std::none_of(misses.begin(), misses.end(), [limit](uint8_t m) { return m > limit; })) return;
+
+    for (auto* v : { &x, &y, &vx, &vy, &pPos, &pCross, &pVel }) compact(*v, misses, limit);
+    compact(trackIds, misses, limit);
+    compact(contactIds, misses, limit);
+    compact(types, misses, limit);
+    compact(misses, misses, limit);
+}
+
+void ContactTracker::startTrack(const SonarContact& contact, float variance) {
+    const Vector2 m = contact.perceivedPosition();
+    x.push_back(m.x);
+    y.push_back(m.y);
+    vx.push_back(0.0f);
+    vy.push_back(0.0f);
+    pPos.push_back(variance);
+    pCross.push_back(0.0f);
+    pVel.push_back(params.initialSpeedSigma * params.initialSpeedSigma);
+    trackIds.push_back(nextTrackId++);
+    contactIds.push_back(contact.id);
+    types.push_back(contact.type);
+    misses.push_back(0);
+}
+
+size_t ContactTracker::findTrack(uint32_t contactId) const {
+    size_t best = NO_TRACK;
+    for (size_t i = 0; i < contactIds.size(); ++i) {
+        if (contactIds[i] != contactId) continue;
+        if (best == NO_TRACK || misses[i] < misses[best]) best = i;
+    }
+    return best;
+}
+
+uint32_t ContactTracker::getNearestContactId(Vector2 position, float maxDistance) const {
+    uint32_t bestId = 0;
+    float bestDist2 = maxDistance * maxDistance;
+    for (size_t i = 0; i < x.size(); ++i) {
+        const Vector2 p = getPosition(i);
+        const float dx = p.x - position.x;
+        const float dy = p.y - position.y;
+        const float d2 = dx * dx + dy * dy;
+        if (d2 < bestDist2) { bestDist2 = d2; bestId = contactIds[i]; }
+    }
+    return bestId;
+}
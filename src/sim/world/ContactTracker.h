@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <raylib.h>
+#include "ContactManager.h"
+
+struct TrackerParams {
+    float processNoise = 2.0f;              // white acceleration density, units^2/s^3
+    float measurementNoiseFraction = 0.025f; // 1 sigma detection error as a fraction of range
+    float minMeasurementNoise = 1.0f;       // units, 1 sigma
+    float initialSpeedSigma = 30.0f;        // units/s; a new track knows nothing of velocity
+    float gateSigmas = 3.0f;                // association gate on the innovation
+    float maxGate = 60.0f;                  // largest gate in units, however uncertain the track
+    float gridCell = 20.0f;                 // association grid cell size
+    uint8_t maxMisses = 2;                  // pings a track coasts without an update before it is dropped
+};
+
+// one constant-velocity kalman filter per sonar detection. x and y share
+// the motion model and the (isotropic) measurement noise, so a single 2x2
+// covariance [pos, cross; cross, vel] per track serves both axes. filters
+// live in structure-of-arrays form and each ping predicts and corrects all
+// of them in one pass, four tracks per vector (SSE2, or WebAssembly SIMD
+// with -msimd128; scalar otherwise). detections are matched to predicted
+// tracks through a uniform grid rebuilt every ping, nearest by innovation
+// distance inside the gate; unmatched detections start new tracks.
+class ContactTracker {
+public:
+    static constexpr size_t NO_TRACK = static_cast<size_t>(-1);
+
+    // true when this build uses a vector path
+    static bool isVectorized();
+
+    void setParams(const TrackerParams& p) { params = p; }
+    const TrackerParams& getParams() const { return params; }
+
+    // sim time since the last ping; estimates extrapolate over it
+    void advance(float dt) {
+        sinceUpdate += dt;
+        lastStep = dt;
+    }
+
+    // predicts every track to now and corrects it with this ping's detections
+    // (contacts with missedPings == 0), measured from origin
+    void update(const ContactManager& contacts, Vector2 origin = {0, 0});
+    void clear();
+
+    size_t getTrackCount() const { return x.size(); }
+    uint32_t getTrackId(size_t i) const { return trackIds[i]; }
+    // the contact whose detection last updated the track
+    uint32_t getContactId(size_t i) const { return contactIds[i]; }
+    ContactType getType(size_t i) const { return types[i]; }
+    uint8_t getMisses(size_t i) const { return misses[i]; }
+
+    // estimate now, and one sim step earlier for render interpolation
+    Vector2 getPosition(size_t i) const { return { x[i] + vx[i] * sinceUpdate, y[i] + vy[i] * sinceUpdate }; }
+    Vector2 getPreviousPosition(size_t i) const {
+        const float t = sinceUpdate - lastStep;
+        return { x[i] + vx[i] * t, y[i] + vy[i] * t };
+    }
+    Vector2 getVelocity(size_t i) const { return { vx[i], vy[i] }; }
+    // 1 sigma position uncertainty per axis at the last ping
+    float getPositionSigma(size_t i) const;
+
+    // freshest track on a contact, or NO_TRACK
+    size_t findTrack(uint32_t contactId) const;
+    // contact of the nearest track estimate within maxDistance, or 0
+    uint32_t getNearestContactId(Vector2 position, float maxDistance = 25.0f) const;
+
+    // sizes track state and scratch for up to `contacts` live contacts. a
+    // ping leaves at most one fresh track per contact and a track coasts
+    // maxMisses pings, so that bounds the track count
+    void reserve(size_t contacts);
+    size_t getMemoryBytes() const;
+
+private:
+    void predict(float dt);
+    void sizeGrid();
+    void buildGrid();
+    void associate(const std::vector<SonarContact>& contacts, Vector2 origin);
+    void correct();
+    void retire();
+    void startTrack(const SonarContact& contact, float variance);
+    size_t columnOf(float px) const;
+    size_t rowOf(float py) const;
+
+    TrackerParams params;
+    uint32_t nextTrackId = 1;
+    float sinceUpdate = 0.0f;
+    float lastStep = 0.0f;
+
+    // filter state, one entry per track
+    std::vector<float> x, y, vx, vy;
+    std::vector<float> pPos, pCross, pVel;
+    std::vector<uint32_t> trackIds;
+    std::vector<uint32_t> contactIds;
+    std::vector<ContactType> types;
+    std::vector<uint8_t> misses;
+
+    // per-ping scratch, reused to avoid reallocating
+    std::vector<float> measuredX, measuredY, measurementVar, hasMeasurement;
+    std::vector<uint32_t> cellStart, cellTracks, trackCell;
+    std::vector<float> cellX, cellY, cellPosVar;   // track fields in cell order
+    std::vector<uint8_t> cellClaimed;
+    std::vector<size_t> unmatched;
+    std::vector<float> unmatchedVar;
+    size_t gridColumns = 0, gridRows = 0;
+    float largestPosVar = 0.0f;
+};
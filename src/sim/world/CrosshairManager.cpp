@@ -3,13 +3,23 @@
 
 // keeps crosshair locked onto tracked contact
 void CrosshairManager::update(float dt) {
-    if (trackedContactId != 0) {
+    previousCrosshairPosition = crosshairPosition;
+    if (trackedContactId != 0 && tracker) {
+        // follows the track estimate; a track that is dropped is lost
+        const size_t track = tracker->findTrack(trackedContactId);
+        if (track != ContactTracker::NO_TRACK) {
+            crosshairPosition = tracker->getPosition(track);
+        } else {
+            trackedContactId = 0;
+        }
+    } else if (trackedContactId != 0) {
         const auto& contacts = contactManager.getActiveContacts();
         auto it = std::find_if(contacts.begin(), contacts.end(), 
             [this](const SonarContact& c) { return c.id == trackedContactId; });
         
-        if (it != contacts.end()) {
-            crosshairPosition = it->position;
+        // follows the sonar picture; a contact that fades out is lost
+        if (it != contacts.end() && it->isVisible) {
+            crosshairPosition = it->perceivedPosition();
         } else {
             trackedContactId = 0;
         }
@@ -23,18 +33,33 @@ void CrosshairManager::updateMousePosition(Vector2 mousePos, const Rectangle& so
                       mousePos.y >= sonarBounds.y && mousePos.y <= sonarBounds.y + sonarBounds.height);
 }
 
-// click on target = start tracking
-bool CrosshairManager::handleMouseClick(Vector2 mousePos, const Rectangle& sonarBounds) {
-    if (!mouseOverSonar) return false;
-    
-    Vector2 mouseWorldPos = screenToWorld(mousePos, sonarBounds);
-    
-    // check if clicked on contact
+// click on target = start tracking. the ui converts the click through its
+// sonar camera, headless agents pass world positions directly
+bool CrosshairManager::selectContactAt(Vector2 worldPos) {
+    if (tracker) {
+        for (size_t i = 0; i < tracker->getTrackCount(); ++i) {
+            const Vector2 estimate = tracker->getPosition(i);
+            if (isContactInSelectionCircle(estimate, worldPos)) {
+                trackedContactId = tracker->getContactId(i);
+                crosshairPosition = estimate;
+                previousCrosshairPosition = estimate;
+                return true;
+            }
+        }
+        trackedContactId = 0;
+        return false;
+    }
+
     const auto& contacts = contactManager.getActiveContacts();
     for (const auto& contact : contacts) {
-        if (isContactInSelectionCircle(contact.position, mouseWorldPos)) {
+        // only what the sonar shows can be picked, where it shows it
+        if (!contact.isVisible) continue;
+        const Vector2 perceived = contact.perceivedPosition();
+        if (isContactInSelectionCircle(perceived, worldPos)) {
             trackedContactId = contact.id;
-            crosshairPosition = contact.position;
+            // snap rather than sweep across from the old target
+            crosshairPosition = perceived;
+            previousCrosshairPosition = perceived;
             return true;
         }
     }
@@ -43,13 +68,6 @@ bool CrosshairManager::handleMouseClick(Vector2 mousePos, const Rectangle& sonar
     return false;
 }
 
-Vector2 CrosshairManager::screenToWorld(Vector2 screenPos, const Rectangle& sonarBounds) const {
-    float nx = (screenPos.x - sonarBounds.x) / sonarBounds.width;
-    float ny = (screenPos.y - sonarBounds.y) / sonarBounds.height;
-    
-    return { nx * 1200.0f - 600.0f, ny * 720.0f - 360.0f };
-}
-
 bool CrosshairManager::isContactInSelectionCircle(Vector2 contactWorldPos, Vector2 mouseWorldPos) const {
     float dx = contactWorldPos.x - mouseWorldPos.x;
     float dy = contactWorldPos.y - mouseWorldPos.y;
@@ -3,20 +3,26 @@
 #include <cstdint>
 #include <raylib.h>
 #include "ContactManager.h"
+#include "ContactTracker.h"
 
 class CrosshairManager {
 public:
     CrosshairManager(ContactManager& contacts) : contactManager(contacts) {}
 
+    // with a tracker the crosshair follows and selects track estimates;
+    // without one it uses the raw sonar picture
+    void setTracker(const ContactTracker* contactTracker) { tracker = contactTracker; }
+
     void update(float dt);
     void updateMousePosition(Vector2 mousePos, const Rectangle& sonarBounds);
     
-    // returns true if a contact was selected
-    bool handleMouseClick(Vector2 mousePos, const Rectangle& sonarBounds);
+    // world-space selection; returns true if a contact was selected
+    bool selectContactAt(Vector2 worldPos);
     
     bool isTracking() const { return trackedContactId != 0; }
     uint32_t getTrackedContactId() const { return trackedContactId; }
     Vector2 getCrosshairPosition() const { return crosshairPosition; }
+    Vector2 getPreviousCrosshairPosition() const { return previousCrosshairPosition; }
     Vector2 getMousePosition() const { return mousePosition; }
     bool isMouseOverSonar() const { return mouseOverSonar; }
     
@@ -24,14 +30,15 @@ public:
 
 private:
     ContactManager& contactManager;
+    const ContactTracker* tracker = nullptr;
     
     uint32_t trackedContactId = 0;
     Vector2 crosshairPosition = {0, 0};
+    Vector2 previousCrosshairPosition = {0, 0};
     
     Vector2 mousePosition = {0, 0};
     bool mouseOverSonar = false;
     
     static constexpr float SELECTION_RADIUS = 20.0f;
-    Vector2 screenToWorld(Vector2 screenPos, const Rectangle& sonarBounds) const;
     bool isContactInSelectionCircle(Vector2 contactWorldPos, Vector2 mouseWorldPos) const;
 };
@@ -0,0 +1,295 @@
+#include "FishSchooling.h"
+#include "ContactManager.h"
+#include "WorldBounds.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define FISH_SCHOOLING_SSE2 1
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define FISH_SCHOOLING_WASM_SIMD 1
+#endif
+
+#if defined(FISH_SCHOOLING_SSE2) || defined(FISH_SCHOOLING_WASM_SIMD)
+    #define FISH_SCHOOLING_VECTOR 1
+#endif
+
+namespace {
+
+// the grid covers the world plus this much, positions past it land in the edge cells
+constexpr float GRID_MARGIN = 50.0f;
+// padding entries sit this far away, outside any perception radius
+constexpr float SENTINEL = 1.0e9f;
+// keeps 1/d^2 finite for fish on top of each other
+constexpr float MIN_DISTANCE_SQ = 1.0e-4f;
+
+// four neighbours per vector
+#if defined(FISH_SCHOOLING_SSE2)
+using Floats = __m128;
+inline Floats lanesSplat(float v) { return _mm_set1_ps(v); }
+inline Floats lanesLoad(const float* p) { return _mm_loadu_ps(p); }
+inline void lanesStore(float* p, Floats v) { _mm_storeu_ps(p, v); }
+inline Floats lanesAdd(Floats a, Floats b) { return _mm_add_ps(a, b); }
+inline Floats lanesSub(Floats a, Floats b) { return _mm_sub_ps(a, b); }
+inline Floats lanesMul(Floats a, Floats b) { return _mm_mul_ps(a, b); }
+inline Floats lanesDiv(Floats a, Floats b) { return _mm_div_ps(a, b); }
+inline Floats lanesMax(Floats a, Floats b) { return _mm_max_ps(a, b); }
+// all ones per lane where the comparison holds
+inline Floats lanesLess(Floats a, Floats b) { return _mm_cmplt_ps(a, b); }
+inline Floats lanesAnd(Floats a, Floats b) { return _mm_and_ps(a, b); }
+#elif defined(FISH_SCHOOLING_WASM_SIMD)
+using Floats = v128_t;
+inline Floats lanesSplat(float v) { return wasm_f32x4_splat(v); }
+inline Floats lanesLoad(const float* p) { return wasm_v128_load(p); }
+inline void lanesStore(float* p, Floats v) { wasm_v128_store(p, v); }
+inline Floats lanesAdd(Floats a, Floats b) { return wasm_f32x4_add(a, b); }
+inline Floats lanesSub(Floats a, Floats b) { return wasm_f32x4_sub(a, b); }
+inline Floats lanesMul(Floats a, Floats b) { return wasm_f32x4_mul(a, b); }
+inline Floats lanesDiv(Floats a, Floats b) { return wasm_f32x4_div(a, b); }
+inline Floats lanesMax(Floats a, Floats b) { return wasm_f32x4_pmax(a, b); }
+inline Floats lanesLess(Floats a, Floats b) { return wasm_f32x4_lt(a, b); }
+inline Floats lanesAnd(Floats a, Floats b) { return wasm_v128_and(a, b); }
+#endif
+
+// neighbour sums for one fish, one slot per lane
+struct NeighbourSums {
+    float count[4] = {};
+    float velocityX[4] = {}, velocityY[4] = {};
+    float offsetX[4] = {}, offsetY[4] = {};
+    float pushX[4] = {}, pushY[4] = {};
+};
+
+inline float total(const float (&lanes)[4]) {
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+}  // namespace
+
+bool FishSchooling::isVectorized() {
+#if defined(FISH_SCHOOLING_VECTOR)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FishSchooling::reserve(size_t count) {
+    fish.reserve(count);
+    for (auto* v : { &px, &py, &vx, &vy, &steeredX, &steeredY }) v->reserve(count);
+    fishCell.reserve(count);
+    // worst case every fish alone in its cell, padded to four
+    for (auto* v : { &cellX, &cellY, &cellVx, &cellVy }) v->reserve(count * 4);
+    sizeGrid();
+}
+
+void FishSchooling::sizeGrid() {
+    gridColumns = static_cast<size_t>(std::ceil((WorldBounds::WIDTH + 2.0f * GRID_MARGIN) / params.perceptionRadius));
+    gridRows = static_cast<size_t>(std::ceil((WorldBounds::HEIGHT + 2.0f * GRID_MARGIN) / params.perceptionRadius));
+    cellStart.resize(gridColumns * gridRows + 1);
+    cellFill.resize(gridColumns * gridRows);
+}
+
+size_t FishSchooling::getMemoryBytes() const {
+    return (fish.capacity() + fishCell.capacity() + cellStart.capacity() + cellFill.capacity()) * sizeof(uint32_t) +
+           (px.capacity() + py.capacity() + vx.capacity() + vy.capacity() + steeredX.capacity() +
+            steeredY.capacity() + cellX.capacity() + cellY.capacity() + cellVx.capacity() + cellVy.capacity()) *
+               sizeof(float);
+}
+
+void FishSchooling::update(std::vector<SonarContact>& contacts, float dt) {
+    steered = 0;
+    gather(contacts);
+    if (fish.empty()) return;
+
+    buildGrid();
+    steer(dt);
+
+    for (size_t k = 0; k < fish.size(); ++k) {
+        if (steeredX[k] == vx[k] && steeredY[k] == vy[k]) continue;
+        ++steered;
+        SonarContact& c = contacts[fish[k]];
+        c.velocity = { steeredX[k], steeredY[k] };
+        c.speed = std::sqrt(steeredX[k] * steeredX[k] + steeredY[k] * steeredY[k]);
+        c.velocityDirRad = std::atan2(steeredY[k], steeredX[k]);
+    }
+}
+
+// the only pass that reads the AoS contacts
+void FishSchooling::gather(const std::vector<SonarContact>& contacts) {
+    fish.clear();
+    px.clear();
+    py.clear();
+    vx.clear();
+    vy.clear();
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        const SonarContact& c = contacts[i];
+        if (c.type != ContactType::Fish) continue;
+        fish.push_back(static_cast<uint32_t>(i));
+        px.push_back(c.position.x);
+        py.push_back(c.position.y);
+        vx.push_back(c.velocity.x);
+        vy.push_back(c.velocity.y);
+    }
+}
+
+size_t FishSchooling::cellOf(float x, float y) const {
+    const float cell = params.perceptionRadius;
+    const float gx = (x + WorldBounds::HALF_WIDTH + GRID_MARGIN) / cell;
+    const float gy = (y + WorldBounds::HALF_HEIGHT + GRID_MARGIN) / cell;
+    const size_t column = static_cast<size_t>(std::min(std::max(gx, 0.0f), static_cast<float>(gridColumns - 1)));
+    const size_t row = static_cast<size_t>(std::min(std::max(gy, 0.0f), static_cast<float>(gridRows - 1)));
+    return row * gridColumns + column;
+}
+
+// counting sort into cell order, each cell's run rounded up to four
+void FishSchooling::buildGrid() {
+    sizeGrid();
+    const size_t cells = gridColumns * gridRows;
+    const size_t count = fish.size();
+
+    std::fill(cellFill.begin(), cellFill.end(), 0u);
+    fishCell.resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        fishCell[k] = static_cast<uint32_t>(cellOf(px[k], py[k]));
+        ++cellFill[fishCell[k]];
+    }
+
+    cellStart[0] = 0;
+    for (size_t c = 0; c < cells; ++c) {
+        cellStart[c + 1] = cellStart[c] + ((cellFill[c] + 3u) & ~3u);
+        cellFill[c] = cellStart[c];
+    }
+
+    const size_t padded = cellStart[cells];
+    cellX.assign(padded, SENTINEL);
+    cellY.assign(padded, SENTINEL);
+    cellVx.assign(padded, 0.0f);
+    cellVy.assign(padded, 0.0f);
+    for (size_t k = 0; k < count; ++k) {
+        const uint32_t slot = cellFill[fishCell[k]]++;
+        cellX[slot] = px[k];
+        cellY[slot] = py[k];
+        cellVx[slot] = vx[k];
+        cellVy[slot] = vy[k];
+    }
+}
+
+// the three cells of a grid row around a fish are one contiguous run, so
+// a fish reads three runs. sentinels and the fish itself (distance 0)
+// fall outside the mask.
+void FishSchooling::steer(float dt) {
+    const size_t count = fish.size();
+    steeredX.resize(count);
+    steeredY.resize(count);
+
+    const float reachSq = params.perceptionRadius * params.perceptionRadius;
+    const float separationSq = params.separationRadius * params.separationRadius;
+    slotsRead = 0;
+
+#if defined(FISH_SCHOOLING_VECTOR)
+    const Floats zero = lanesSplat(0.0f);
+    const Floats one = lanesSplat(1.0f);
+    const Floats reachV = lanesSplat(reachSq);
+    const Floats separationV = lanesSplat(separationSq);
+    const Floats minDistanceV = lanesSplat(MIN_DISTANCE_SQ);
+#endif
+
+    for (size_t k = 0; k < count; ++k) {
+        const float x = px[k], y = py[k];
+        const size_t column = fishCell[k] % gridColumns;
+        const size_t row = fishCell[k] / gridColumns;
+        const size_t firstColumn = column > 0 ? column - 1 : column;
+        const size_t lastColumn = std::min(column + 1, gridColumns - 1);
+        const size_t firstRow = row > 0 ? row - 1 : row;
+        const size_t lastRow = std::min(row + 1, gridRows - 1);
+
+        NeighbourSums sums;
+#if defined(FISH_SCHOOLING_VECTOR)
+        const Floats fx = lanesSplat(x), fy = lanesSplat(y);
+        Floats n = zero, sumVx = zero, sumVy = zero, sumDx = zero, sumDy = zero, pushX = zero, pushY = zero;
+        for (size_t r = firstRow; r <= lastRow; ++r) {
+            const size_t begin = cellStart[r * gridColumns + firstColumn];
+            const size_t end = cellStart[r * gridColumns + lastColumn + 1];
+            slotsRead += end - begin;
+            for (size_t j = begin; j < end; j += 4) {
+                const Floats dx = lanesSub(lanesLoad(&cellX[j]), fx);
+                const Floats dy = lanesSub(lanesLoad(&cellY[j]), fy);
+                const Floats d2 = lanesAdd(lanesMul(dx, dx), lanesMul(dy, dy));
+                const Floats near = lanesAnd(lanesLess(d2, reachV), lanesLess(zero, d2));
+                const Floats close = lanesAnd(near, lanesLess(d2, separationV));
+                const Floats inv = lanesDiv(one, lanesMax(d2, minDistanceV));
+                n = lanesAdd(n, lanesAnd(near, one));
+                sumVx = lanesAdd(sumVx, lanesAnd(near, lanesLoad(&cellVx[j])));
+                sumVy = lanesAdd(sumVy, lanesAnd(near, lanesLoad(&cellVy[j])));
+                sumDx = lanesAdd(sumDx, lanesAnd(near, dx));
+                sumDy = lanesAdd(sumDy, lanesAnd(near, dy));
+                pushX = lanesAdd(pushX, lanesAnd(close, lanesMul(dx, inv)));
+                pushY = lanesAdd(pushY, lanesAnd(close, lanesMul(dy, inv)));
+            }
+        }
+        lanesStore(sums.count, n);
+        lanesStore(sums.velocityX, sumVx);
+        lanesStore(sums.velocityY, sumVy);
+        lanesStore(sums.offsetX, sumDx);
+        lanesStore(sums.offsetY, sumDy);
+        lanesStore(sums.pushX, pushX);
+        lanesStore(sums.pushY, pushY);
+#else
+        // slot j % 4 mirrors the vector lane a neighbour lands in
+        for (size_t r = firstRow; r <= lastRow; ++r) {
+            const size_t begin = cellStart[r * gridColumns + firstColumn];
+            const size_t end = cellStart[r * gridColumns + lastColumn + 1];
+            slotsRead += end - begin;
+            for (size_t j = begin; j < end; ++j) {
+                const float dx = cellX[j] - x;
+                const float dy = cellY[j] - y;
+                const float d2 = dx * dx + dy * dy;
+                if (!(d2 < reachSq && 0.0f < d2)) continue;
+                const size_t lane = j & 3;
+                sums.count[lane] += 1.0f;
+                sums.velocityX[lane] += cellVx[j];
+                sums.velocityY[lane] += cellVy[j];
+                sums.offsetX[lane] += dx;
+                sums.offsetY[lane] += dy;
+                if (d2 < separationSq) {
+                    const float inv = 1.0f / std::max(d2, MIN_DISTANCE_SQ);
+                    sums.pushX[lane] += dx * inv;
+                    sums.pushY[lane] += dy * inv;
+                }
+            }
+        }
+#endif
+
+        const float neighbours = total(sums.count);
+        if (neighbours == 0.0f) {
+            steeredX[k] = vx[k];
+            steeredY[k] = vy[k];
+            continue;
+        }
+
+        const float invN = 1.0f / neighbours;
+        const float ax = params.cohesionRate * (total(sums.offsetX) * invN) +
+                         params.alignmentRate * (total(sums.velocityX) * invN - vx[k]) -
+                         params.separationWeight * total(sums.pushX);
+        const float ay = params.cohesionRate * (total(sums.offsetY) * invN) +
+                         params.alignmentRate * (total(sums.velocityY) * invN - vy[k]) -
+                         params.separationWeight * total(sums.pushY);
+        float nx = vx[k] + ax * dt;
+        float ny = vy[k] + ay * dt;
+
+        const float speed = std::sqrt(nx * nx + ny * ny);
+        if (speed > params.maxSpeed) {
+            const float scale = params.maxSpeed / speed;
+            nx *= scale;
+            ny *= scale;
+        } else if (speed < params.minSpeed && speed > 0.0f) {
+            const float scale = params.minSpeed / speed;
+            nx *= scale;
+            ny *= scale;
+        }
+        steeredX[k] = nx;
+        steeredY[k] = ny;
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <raylib.h>
+
+struct SonarContact;
+
+struct SchoolingParams {
+    float perceptionRadius = 30.0f;   // fish react to neighbours this close; also the grid cell size
+    float separationRadius = 8.0f;
+    float separationWeight = 100.0f;  // push away from close neighbours, falling off with 1/distance
+    float alignmentRate = 1.5f;       // 1/s, pull toward the neighbours' mean velocity
+    float cohesionRate = 0.4f;        // 1/s^2, pull toward the neighbours' centre
+    float minSpeed = 8.0f;
+    float maxSpeed = 30.0f;
+};
+
+// boids for Fish contacts: separation, alignment and cohesion over the
+// neighbours within perceptionRadius. fish are gathered into
+// structure-of-arrays form and binned into a uniform grid of
+// perceptionRadius cells, so each fish only reads the 3x3 cells around it.
+// every cell's run is padded to a multiple of four with far-away
+// sentinels, and the neighbour sums run four neighbours per vector
+// (SSE2, or WebAssembly SIMD with -msimd128; scalar otherwise) with the
+// same per-lane order in every build, so results match bit for bit.
+class FishSchooling {
+public:
+    // true when this build uses a vector path
+    static bool isVectorized();
+
+    void setParams(const SchoolingParams& p) { params = p; }
+    const SchoolingParams& getParams() const { return params; }
+
+    // steers every fish by dt, rewriting velocity, speed and heading. other
+    // types, and fish with no neighbours, keep their course.
+    void update(std::vector<SonarContact>& contacts, float dt);
+
+    // sizes the scratch for count fish up front
+    void reserve(size_t count);
+
+    size_t getFishCount() const { return fish.size(); }
+    // fish whose course the last update changed; 0 when none are schooling
+    size_t getSteeredCount() const { return steered; }
+    // grid slots the last update binned fish into, padding included, and
+    // the neighbour slots it read across every fish's 3x3 cells
+    size_t getGridSlots() const { return cellStart.empty() ? 0 : cellStart.back(); }
+    size_t getNeighbourSlotsRead() const { return slotsRead; }
+    size_t getMemoryBytes() const;
+
+private:
+    void gather(const std::vector<SonarContact>& contacts);
+    void sizeGrid();
+    void buildGrid();
+    void steer(float dt);
+    size_t cellOf(float x, float y) const;
+
+    SchoolingParams params;
+    size_t steered = 0;
+    size_t slotsRead = 0;
+    size_t gridColumns = 0, gridRows = 0;
+
+    // one entry per fish, in contact order
+    std::vector<uint32_t> fish;          // index into the contacts
+    std::vector<float> px, py, vx, vy;
+    std::vector<uint32_t> fishCell;
+    std::vector<float> steeredX, steeredY;
+
+    // fish in cell order; cellStart[c] is a multiple of four
+    std::vector<uint32_t> cellStart, cellFill;
+    std::vector<float> cellX, cellY, cellVx, cellVy;
+};
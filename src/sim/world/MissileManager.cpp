@@ -1,20 +1,54 @@
 #include "MissileManager.h"
+#include "WorldBounds.h"
+#include "WorldKernels.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
+#include <random>
 
 #ifndef PI
 #define PI 3.14159265359f
 #endif
 
-MissileManager::MissileManager() {
+MissileManager::MissileManager() : rng(std::random_device{}()) {
     nextMissileId = 1;
 }
 
+void MissileManager::seed(uint32_t value) {
+    rng.seed(value);
+}
+
+void MissileManager::setFixedFootprint(const ScenarioLimits& scenarioLimits) {
+    limits = scenarioLimits;
+    activeMissiles.reserve(limits.maxMissiles);
+    activeExplosions.reserve(limits.maxExplosions);
+
+    // one trail buffer per missile slot, handed out on launch
+    spareTrails.reserve(limits.maxMissiles);
+    while (spareTrails.size() + activeMissiles.size() < limits.maxMissiles) {
+        spareTrails.emplace_back();
+        spareTrails.back().reserve(Missile::MAX_TRAIL_POINTS + 1);
+    }
+    fixedFootprint = true;
+}
+
+size_t MissileManager::getTrailBytes() const {
+    size_t points = 0;
+    for (const auto& missile : activeMissiles) points += missile.trailPoints.capacity();
+    for (const auto& trail : spareTrails) points += trail.capacity();
+    return points * sizeof(Vector2);
+}
+
 uint32_t MissileManager::launchMissile(Vector2 startPosition, uint32_t targetId) {
+    if (fixedFootprint && activeMissiles.size() >= limits.maxMissiles) {
+        std::cerr << "[MissileManager] missile pool full (" << limits.maxMissiles << "), launch refused" << std::endl;
+        return 0;
+    }
+
     Missile missile{};
     missile.id = nextMissileId++;
     missile.position = startPosition;
+    missile.previousPosition = startPosition;
     missile.targetId = targetId;
     missile.speed = 160.0f;
     missile.maxTurnRate = 3.0f;
@@ -22,38 +56,62 @@ uint32_t MissileManager::launchMissile(Vector2 startPosition, uint32_t targetId)
     missile.active = true;
     
     // start missile in random direction-- then correct path
-    float randomAngle = ((float)GetRandomValue(0, 1000) / 1000.0f) * 2.0f * PI;
+    float randomAngle = ((float)std::uniform_int_distribution<int>(0, 1000)(rng) / 1000.0f) * 2.0f * PI;
     missile.velocity = { cosf(randomAngle) * missile.speed, sinf(randomAngle) * missile.speed };
     
+    // reuse a retired trail buffer when there is one
+    if (!spareTrails.empty()) {
+        missile.trailPoints = std::move(spareTrails.back());
+        spareTrails.pop_back();
+    } else {
+        missile.trailPoints.reserve(Missile::MAX_TRAIL_POINTS + 1);
+    }
     missile.trailPoints.clear();
     missile.trailPoints.push_back(missile.position);
     
-    activeMissiles.push_back(missile);
-    return missile.id;
+    const uint32_t id = missile.id;
+    activeMissiles.push_back(std::move(missile));
+    return id;
 }
 
 void MissileManager::removeMissile(uint32_t id) {
-    activeMissiles.erase(
-        std::remove_if(activeMissiles.begin(), activeMissiles.end(), 
-            [id](const Missile& m) { return m.id == id; }), 
-        activeMissiles.end()
-    );
+    for (auto& missile : activeMissiles) {
+        if (missile.id == id) missile.active = false;
+    }
+    removeInactiveMissiles();
 }
 
 void MissileManager::clearAllMissiles() {
-    activeMissiles.clear();
+    for (auto& missile : activeMissiles) missile.active = false;
+    removeInactiveMissiles();
     activeExplosions.clear();
 }
 
+// drops inactive missiles, keeping their trail buffers for later launches
+void MissileManager::removeInactiveMissiles() {
+    for (auto& missile : activeMissiles) {
+        if (!missile.active && missile.trailPoints.capacity() > 0) {
+            missile.trailPoints.clear();
+            spareTrails.push_back(std::move(missile.trailPoints));
+        }
+    }
+    activeMissiles.erase(
+        std::remove_if(activeMissiles.begin(), activeMissiles.end(), 
+            [](const Missile& m) { return !m.active; }), 
+        activeMissiles.end()
+    );
+}
+
 // explodes all missiles
 void MissileManager::explodeAllMissiles() {
-    for (const auto& missile : activeMissiles) {
+    for (auto& missile : activeMissiles) {
         if (missile.active) {
             createExplosion(missile.position);
         }
+        missile.active = false;
     }
     
-    activeMissiles.clear();
+    removeInactiveMissiles();
 }
 
 bool MissileManager::isMissileActive(uint32_t id) const {
@@ -84,27 +142,24 @@ void MissileManager::updateMissilePhysics(float dt, const std::vector<Vector2>&
         }
         
         Vector2 oldPosition = missile.position;
-        missile.position.x += missile.velocity.x * dt;
-        missile.position.y += missile.velocity.y * dt;
+        missile.previousPosition = oldPosition;
+        const Vector2 current = currentField ? currentField->sample(missile.position) : Vector2{0, 0};
+        missile.position.x += (missile.velocity.x + current.x) * dt;
+        missile.position.y += (missile.velocity.y + current.y) * dt;
         
         missile.trailPoints.push_back(missile.position);
         
         // trail logic
-        if (missile.trailPoints.size() > 20) {
+        if (missile.trailPoints.size() > Missile::MAX_TRAIL_POINTS) {
             missile.trailPoints.erase(missile.trailPoints.begin());
         }
         
-        if (missile.position.x < -600 || missile.position.x > 600 || 
-            missile.position.y < -360 || missile.position.y > 360) {
+        if (!WorldBounds::contains(missile.position)) {
             missile.active = false;
         }
     }
     
-    activeMissiles.erase(
-        std::remove_if(activeMissiles.begin(), activeMissiles.end(), 
-            [](const Missile& m) { return !m.active; }), 
-        activeMissiles.end()
-    );
+    removeInactiveMissiles();
 }
 
 // explosion animation
@@ -142,26 +197,24 @@ void MissileManager::checkCollisions(const std::vector<Vector2>& contactPosition
     for (auto& missile : activeMissiles) {
         if (!missile.active) continue;
         
-        for (size_t i = 0; i < contactPositions.size(); ++i) {
-            Vector2 contactPos = contactPositions[i];
-            float dx = missile.position.x - contactPos.x;
-            float dy = missile.position.y - contactPos.y;
-            float distance = sqrtf(dx*dx + dy*dy);
+        const size_t hit = WorldKernels::firstWithinRadius(contactPositions.data(), contactPositions.size(),
+                                                           missile.position, HIT_RADIUS);
+        if (hit < contactPositions.size()) {
+            createExplosion(missile.position);
             
-            if (distance < 15.0f) {
-                createExplosion(missile.position);
-                
-                missile.active = false;
-                
-                hitContactIds.push_back(static_cast<uint32_t>(i));
-                
-                break;
-            }
+            missile.active = false;
+            
+            hitContactIds.push_back(static_cast<uint32_t>(hit));
         }
     }
 }
 
 void MissileManager::createExplosion(Vector2 position) {
+    if (fixedFootprint && activeExplosions.size() >= limits.maxExplosions) {
+        std::cerr << "[MissileManager] explosion pool full (" << limits.maxExplosions << "), explosion dropped" << std::endl;
+        return;
+    }
+
     Explosion explosion{};
     explosion.position = position;
     explosion.duration = 1.5f;
@@ -194,35 +247,23 @@ Vector2 MissileManager::calculateHeatSeekingVelocity(Vector2 missilePos, Vector2
     float currentSpeed = sqrtf(missileVel.x * missileVel.x + missileVel.y * missileVel.y);
     Vector2 currentDir = { missileVel.x / currentSpeed, missileVel.y / currentSpeed };
 
-    // compute angle between current direction and desired direction
-    float dotProduct = currentDir.x * desiredDir.x + currentDir.y * desiredDir.y;
-    dotProduct = std::max(-1.0f, std::min(1.0f, dotProduct));  // Clamp for safety
-    float angleDiff = acosf(dotProduct);
-
-    // calculate turning radius
+    // within the turn limit the missile points straight at the target. the
+    // limit is compared on cosines, so no acos is needed per missile.
     float maxAngleChange = maxTurnRate * dt;
-    if (angleDiff > maxAngleChange) {
-        angleDiff = maxAngleChange;
+    float dotProduct = currentDir.x * desiredDir.x + currentDir.y * desiredDir.y;
+    if (dotProduct >= cosf(maxAngleChange)) {
+        return { desiredDir.x * currentSpeed, desiredDir.y * currentSpeed };
     }
 
-    // determine turn left or right
+    // otherwise turn by the full limit, left or right
     float crossZ = currentDir.x * desiredDir.y - currentDir.y * desiredDir.x;
-    if (crossZ < 0) angleDiff = -angleDiff;
-
-    float cosAngle = cosf(angleDiff);
-    float sinAngle = sinf(angleDiff);
-    Vector2 newVel = {
-        missileVel.x * cosAngle - missileVel.y * sinAngle,
-        missileVel.x * sinAngle + missileVel.y * cosAngle
+    float angle = (crossZ < 0) ? -maxAngleChange : maxAngleChange;
+    float cosAngle = cosf(angle);
+    float sinAngle = sinf(angle);
+    return {
+        (currentDir.x * cosAngle - currentDir.y * sinAngle) * currentSpeed,
+        (currentDir.x * sinAngle + currentDir.y * cosAngle) * currentSpeed
     };
-
-    float newSpeed = sqrtf(newVel.x * newVel.x + newVel.y * newVel.y);
-    if (newSpeed > 0) {
-        newVel.x = (newVel.x / newSpeed) * currentSpeed;
-        newVel.y = (newVel.y / newSpeed) * currentSpeed;
-    }
-
-    return newVel;
 }
 
 void MissileManager::updateMissileTargets(uint32_t newTargetId) {
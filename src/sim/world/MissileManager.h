@@ -2,11 +2,15 @@
 
 #include <vector>
 #include <cstdint>
+#include <random>
 #include <raylib.h>
+#include "OceanCurrentField.h"
+#include "ScenarioLimits.h"
 
 struct Missile {
     uint32_t id;
     Vector2 position;
+    Vector2 previousPosition;   // position before the last sim step, for render interpolation
     Vector2 velocity;
     uint32_t targetId;
     float speed;
@@ -16,6 +20,7 @@ struct Missile {
     
     std::vector<Vector2> trailPoints;
     static constexpr float MAX_TRAIL_LENGTH = 60.0f;
+    static constexpr size_t MAX_TRAIL_POINTS = 20;
 };
 
 struct Explosion {
@@ -35,6 +40,8 @@ class MissileManager {
 public:
     MissileManager();
 
+    void seed(uint32_t value);
+
     uint32_t launchMissile(Vector2 startPosition, uint32_t targetId);
     void removeMissile(uint32_t id);
     void clearAllMissiles();
@@ -44,15 +51,38 @@ public:
     const std::vector<Explosion>& getActiveExplosions() const { return activeExplosions; }
     bool isMissileActive(uint32_t id) const;
 
+    // missiles are carried by the water as well as their own thrust; no field means still water
+    void setCurrentField(const OceanCurrentField* field) { currentField = field; }
     void updateMissilePhysics(float dt, const std::vector<Vector2>& targetPositions);
     void updateExplosions(float dt);
     void checkCollisions(const std::vector<Vector2>& contactPositions, std::vector<uint32_t>& hitContactIds);
     void updateMissileTargets(uint32_t newTargetId);
 
+    // sizes missile, trail and explosion pools up front; launches and
+    // explosions past the limits then fail instead of allocating
+    void setFixedFootprint(const ScenarioLimits& limits);
+    bool isFixedFootprint() const { return fixedFootprint; }
+
+    size_t getMissileBytes() const { return activeMissiles.capacity() * sizeof(Missile); }
+    size_t getTrailBytes() const;
+    size_t getExplosionBytes() const { return activeExplosions.capacity() * sizeof(Explosion); }
+
 private:
     std::vector<Missile> activeMissiles;
     std::vector<Explosion> activeExplosions;
     uint32_t nextMissileId = 1;
+    std::mt19937 rng;
+
+    // trail buffers of removed missiles, reused by the next launch
+    std::vector<std::vector<Vector2>> spareTrails;
+
+    bool fixedFootprint = false;
+    ScenarioLimits limits;
+    const OceanCurrentField* currentField = nullptr;
+
+    static constexpr float HIT_RADIUS = 15.0f;
+    
+    void removeInactiveMissiles();
     
     void createExplosion(Vector2 position);
     Vector2 calculateHeatSeekingVelocity(Vector2 missilePos, Vector2 missileVel, Vector2 targetPos, float maxTurnRate, float dt);
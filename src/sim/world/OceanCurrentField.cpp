@@ -0,0 +1,278 @@
+#include "OceanCurrentField.h"
+#include "WorldBounds.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define OCEAN_CURRENT_SSE2 1
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define OCEAN_CURRENT_WASM_SIMD 1
+#endif
+
+#if defined(OCEAN_CURRENT_SSE2) || defined(OCEAN_CURRENT_WASM_SIMD)
+    #define OCEAN_CURRENT_VECTOR 1
+#endif
+
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be two packed floats");
+
+namespace {
+
+constexpr float TWO_PI = 6.28318531f;
+constexpr size_t ADVECT_CHUNK = 64;
+
+template <typename T>
+inline T* strided(T* base, size_t i, size_t strideBytes) {
+    using Byte = std::conditional_t<std::is_const_v<T>, const char, char>;
+    return reinterpret_cast<T*>(reinterpret_cast<Byte*>(base) + i * strideBytes);
+}
+
+inline float lerp(float a, float b, float f) { return a + (b - a) * f; }
+
+// four points per vector
+#if defined(OCEAN_CURRENT_SSE2)
+using Floats = __m128;
+using Ints = __m128i;
+inline Floats lanesSplat(float v) { return _mm_set1_ps(v); }
+inline Floats lanesLoad(const float* p) { return _mm_loadu_ps(p); }
+inline void lanesStore(int32_t* p, Ints v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+// two Vector2s from unrelated addresses into one vector
+inline Floats lanesLoadPair(const float* lo, const float* hi) {
+    return _mm_castpd_ps(_mm_loadh_pd(_mm_load_sd(reinterpret_cast<const double*>(lo)),
+                                      reinterpret_cast<const double*>(hi)));
+}
+inline Floats lanesAdd(Floats a, Floats b) { return _mm_add_ps(a, b); }
+inline Floats lanesSub(Floats a, Floats b) { return _mm_sub_ps(a, b); }
+inline Floats lanesMul(Floats a, Floats b) { return _mm_mul_ps(a, b); }
+inline Floats lanesMin(Floats a, Floats b) { return _mm_min_ps(a, b); }
+inline Floats lanesMax(Floats a, Floats b) { return _mm_max_ps(a, b); }
+inline Ints lanesTruncate(Floats a) { return _mm_cvttps_epi32(a); }
+inline Floats lanesToFloat(Ints a) { return _mm_cvtepi32_ps(a); }
+// [x0 y0 x1 y1] [x2 y2 x3 y3] -> [x0 x1 x2 x3] and [y0 y1 y2 y3]
+inline Floats lanesEvens(Floats a, Floats b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)); }
+inline Floats lanesOdds(Floats a, Floats b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)); }
+// [x0 x1 x2 x3] [y0 y1 y2 y3] -> x0 y0 x1 y1 x2 y2 x3 y3
+inline void lanesStoreInterleaved(float* p, Floats x, Floats y) {
+    _mm_storeu_ps(p, _mm_unpacklo_ps(x, y));
+    _mm_storeu_ps(p + 4, _mm_unpackhi_ps(x, y));
+}
+#elif defined(OCEAN_CURRENT_WASM_SIMD)
+using Floats = v128_t;
+using Ints = v128_t;
+inline Floats lanesSplat(float v) { return wasm_f32x4_splat(v); }
+inline Floats lanesLoad(const float* p) { return wasm_v128_load(p); }
+inline void lanesStore(int32_t* p, Ints v) { wasm_v128_store(p, v); }
+inline Floats lanesLoadPair(const float* lo, const float* hi) {
+    return wasm_v128_load64_lane(hi, wasm_v128_load64_zero(lo), 1);
+}
+inline Floats lanesAdd(Floats a, Floats b) { return wasm_f32x4_add(a, b); }
+inline Floats lanesSub(Floats a, Floats b) { return wasm_f32x4_sub(a, b); }
+inline Floats lanesMul(Floats a, Floats b) { return wasm_f32x4_mul(a, b); }
+inline Floats lanesMin(Floats a, Floats b) { return wasm_f32x4_pmin(a, b); }
+inline Floats lanesMax(Floats a, Floats b) { return wasm_f32x4_pmax(a, b); }
+inline Ints lanesTruncate(Floats a) { return wasm_i32x4_trunc_sat_f32x4(a); }
+inline Floats lanesToFloat(Ints a) { return wasm_f32x4_convert_i32x4(a); }
+inline Floats lanesEvens(Floats a, Floats b) { return wasm_i32x4_shuffle(a, b, 0, 2, 4, 6); }
+inline Floats lanesOdds(Floats a, Floats b) { return wasm_i32x4_shuffle(a, b, 1, 3, 5, 7); }
+inline void lanesStoreInterleaved(float* p, Floats x, Floats y) {
+    wasm_v128_store(p, wasm_i32x4_shuffle(x, y, 0, 4, 1, 5));
+    wasm_v128_store(p + 4, wasm_i32x4_shuffle(x, y, 2, 6, 3, 7));
+}
+#endif
+
+#if defined(OCEAN_CURRENT_VECTOR)
+inline Floats lanesLerp(Floats a, Floats b, Floats f) { return lanesAdd(a, lanesMul(lanesSub(b, a), f)); }
+#endif
+
+}  // namespace
+
+bool OceanCurrentField::isVectorized() {
+#if defined(OCEAN_CURRENT_VECTOR)
+    return true;
+#else
+    return false;
+#endif
+}
+
+OceanCurrentField::OceanCurrentField() {
+    seed(0);
+}
+
+void OceanCurrentField::seed(uint32_t value, const CurrentFieldParams& p) {
+    params = p;
+
+    const float width = WorldBounds::WIDTH + 2.0f * params.margin;
+    const float height = WorldBounds::HEIGHT + 2.0f * params.margin;
+    const size_t cellsX = static_cast<size_t>(std::ceil(width / params.cellSize));
+    const size_t cellsY = static_cast<size_t>(std::ceil(height / params.cellSize));
+    tilesX = (cellsX + TILE - 1) / TILE;
+    tilesY = (cellsY + TILE - 1) / TILE;
+    origin = { -WorldBounds::HALF_WIDTH - params.margin, -WorldBounds::HALF_HEIGHT - params.margin };
+    invCellSize = 1.0f / params.cellSize;
+    // keeps the last cell's fraction just under 1, so the corners stay in the tile
+    maxCellX = static_cast<float>(tilesX * TILE) - 1.0f / 1024.0f;
+    maxCellY = static_cast<float>(tilesY * TILE) - 1.0f / 1024.0f;
+
+    std::mt19937 rng(value);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    eddies.clear();
+    for (int i = 0; i < params.eddyCount; ++i) {
+        Eddy eddy;
+        eddy.home = { (unit(rng) * 2.0f - 1.0f) * WorldBounds::HALF_WIDTH,
+                      (unit(rng) * 2.0f - 1.0f) * WorldBounds::HALF_HEIGHT };
+        eddy.phase = unit(rng) * TWO_PI;
+        eddy.spin = unit(rng) < 0.5f ? -1.0f : 1.0f;
+        eddies.push_back(eddy);
+    }
+
+    nodes.assign(getTileCount() * TILE_NODES, Vector2{0, 0});
+    nextTile = 0;
+    refreshAll(0.0f);
+}
+
+// a slowly turning tidal stream plus gaussian eddies that wander on
+// lissajous loops. each eddy swirls fastest (eddySpeed) at eddyRadius
+Vector2 OceanCurrentField::velocityAt(Vector2 position, float time) const {
+    const float tide = TWO_PI * time / params.tidalPeriod;
+    Vector2 v = { std::cos(tide) * params.tidalSpeed, std::sin(tide) * params.tidalSpeed };
+
+    const float wander = TWO_PI * time / params.eddyPeriod;
+    const float invRadiusSq = 1.0f / (params.eddyRadius * params.eddyRadius);
+    const float peak = params.eddySpeed / params.eddyRadius;
+    for (const Eddy& eddy : eddies) {
+        const float cx = eddy.home.x + params.eddyWander * std::sin(wander + eddy.phase);
+        const float cy = eddy.home.y + params.eddyWander * std::cos(0.7f * wander + eddy.phase);
+        const float dx = position.x - cx;
+        const float dy = position.y - cy;
+        const float k = eddy.spin * peak * std::exp(0.5f * (1.0f - (dx * dx + dy * dy) * invRadiusSq));
+        v.x -= k * dy;
+        v.y += k * dx;
+    }
+    return v;
+}
+
+// the tide turns at tidalSpeed * 2pi / tidalPeriod. an eddy's velocity
+// gradient peaks at 2 * peak (at r = eddyRadius), and its centre moves at
+// most eddyWander * 2pi / eddyPeriod * sqrt(1 + 0.7^2)
+float OceanCurrentField::getMaxRateOfChange() const {
+    const float tide = params.tidalSpeed * TWO_PI / params.tidalPeriod;
+    const float centreSpeed = params.eddyWander * TWO_PI / params.eddyPeriod * std::sqrt(1.0f + 0.7f * 0.7f);
+    const float gradient = 2.0f * params.eddySpeed / params.eddyRadius;
+    return tide + static_cast<float>(eddies.size()) * gradient * centreSpeed;
+}
+
+void OceanCurrentField::refreshTile(size_t tile, float time) {
+    const size_t tx = tile % tilesX;
+    const size_t ty = tile / tilesX;
+    Vector2* out = &nodes[tile * TILE_NODES];
+    for (size_t ly = 0; ly < TILE_EDGE; ++ly) {
+        const float y = origin.y + static_cast<float>(ty * TILE + ly) * params.cellSize;
+        for (size_t lx = 0; lx < TILE_EDGE; ++lx) {
+            const float x = origin.x + static_cast<float>(tx * TILE + lx) * params.cellSize;
+            *out++ = velocityAt({x, y}, time);
+        }
+    }
+}
+
+void OceanCurrentField::refresh(float time, size_t tiles) {
+    const size_t count = getTileCount();
+    tiles = std::min(tiles, count);
+    for (size_t i = 0; i < tiles; ++i) {
+        refreshTile(nextTile, time);
+        nextTile = (nextTile + 1) % count;
+    }
+}
+
+void OceanCurrentField::refreshAll(float time) {
+    for (size_t tile = 0; tile < getTileCount(); ++tile) refreshTile(tile, time);
+    nextTile = 0;
+}
+
+Vector2 OceanCurrentField::sample(Vector2 position) const {
+    Vector2 out;
+    sample(&position, 1, sizeof(Vector2), &out);
+    return out;
+}
+
+// the grid coordinate is clamped and split into cell and fraction in
+// lanes; the corner fetches are scalar, then the lerps go back to lanes.
+// both paths use the same operations, so a point gets the same answer in
+// any lane or in the tail.
+void OceanCurrentField::sample(const Vector2* positions, size_t count, size_t strideBytes, Vector2* out) const {
+    auto nodeIndex = [this](int32_t cx, int32_t cy) {
+        const size_t x = static_cast<size_t>(cx), y = static_cast<size_t>(cy);
+        const size_t tile = (y / TILE) * tilesX + x / TILE;
+        return tile * TILE_NODES + (y % TILE) * TILE_EDGE + x % TILE;
+    };
+
+    size_t i = 0;
+#if defined(OCEAN_CURRENT_VECTOR)
+    const Floats ox = lanesSplat(origin.x), oy = lanesSplat(origin.y);
+    const Floats scale = lanesSplat(invCellSize);
+    const Floats zero = lanesSplat(0.0f);
+    const Floats maxX = lanesSplat(maxCellX), maxY = lanesSplat(maxCellY);
+    alignas(16) int32_t cellX[4], cellY[4];
+    alignas(16) float u00[4], v00[4], u10[4], v10[4], u01[4], v01[4], u11[4], v11[4];
+    for (; i + 4 <= count; i += 4) {
+        const Floats a = lanesLoadPair(&strided(positions, i, strideBytes)->x,
+                                       &strided(positions, i + 1, strideBytes)->x);
+        const Floats b = lanesLoadPair(&strided(positions, i + 2, strideBytes)->x,
+                                       &strided(positions, i + 3, strideBytes)->x);
+        const Floats gx = lanesMin(lanesMax(lanesMul(lanesSub(lanesEvens(a, b), ox), scale), zero), maxX);
+        const Floats gy = lanesMin(lanesMax(lanesMul(lanesSub(lanesOdds(a, b), oy), scale), zero), maxY);
+        const Ints cx = lanesTruncate(gx);
+        const Ints cy = lanesTruncate(gy);
+        const Floats fx = lanesSub(gx, lanesToFloat(cx));
+        const Floats fy = lanesSub(gy, lanesToFloat(cy));
+
+        lanesStore(cellX, cx);
+        lanesStore(cellY, cy);
+        for (int k = 0; k < 4; ++k) {
+            const Vector2* n = &nodes[nodeIndex(cellX[k], cellY[k])];
+            u00[k] = n[0].x;             v00[k] = n[0].y;
+            u10[k] = n[1].x;             v10[k] = n[1].y;
+            u01[k] = n[TILE_EDGE].x;     v01[k] = n[TILE_EDGE].y;
+            u11[k] = n[TILE_EDGE + 1].x; v11[k] = n[TILE_EDGE + 1].y;
+        }
+
+        const Floats uTop = lanesLerp(lanesLoad(u00), lanesLoad(u10), fx);
+        const Floats uBottom = lanesLerp(lanesLoad(u01), lanesLoad(u11), fx);
+        const Floats vTop = lanesLerp(lanesLoad(v00), lanesLoad(v10), fx);
+        const Floats vBottom = lanesLerp(lanesLoad(v01), lanesLoad(v11), fx);
+        lanesStoreInterleaved(&out[i].x, lanesLerp(uTop, uBottom, fy), lanesLerp(vTop, vBottom, fy));
+    }
+#endif
+    for (; i < count; ++i) {
+        const Vector2 p = *strided(positions, i, strideBytes);
+        const float gx = std::min(std::max((p.x - origin.x) * invCellSize, 0.0f), maxCellX);
+        const float gy = std::min(std::max((p.y - origin.y) * invCellSize, 0.0f), maxCellY);
+        const int32_t cx = static_cast<int32_t>(gx);
+        const int32_t cy = static_cast<int32_t>(gy);
+        const float fx = gx - static_cast<float>(cx);
+        const float fy = gy - static_cast<float>(cy);
+
+        const Vector2* n = &nodes[nodeIndex(cx, cy)];
+        const float uTop = lerp(n[0].x, n[1].x, fx);
+        const float uBottom = lerp(n[TILE_EDGE].x, n[TILE_EDGE + 1].x, fx);
+        const float vTop = lerp(n[0].y, n[1].y, fx);
+        const float vBottom = lerp(n[TILE_EDGE].y, n[TILE_EDGE + 1].y, fx);
+        out[i] = { lerp(uTop, uBottom, fy), lerp(vTop, vBottom, fy) };
+    }
+}
+
+void OceanCurrentField::advect(Vector2* positions, size_t count, size_t strideBytes, float dt) const {
+    Vector2 current[ADVECT_CHUNK];
+    for (size_t start = 0; start < count; start += ADVECT_CHUNK) {
+        const size_t n = std::min(ADVECT_CHUNK, count - start);
+        Vector2* first = strided(positions, start, strideBytes);
+        sample(first, n, strideBytes, current);
+        for (size_t i = 0; i < n; ++i) {
+            Vector2* p = strided(first, i, strideBytes);
+            p->x += current[i].x * dt;
+            p->y += current[i].y * dt;
+        }
+    }
+}
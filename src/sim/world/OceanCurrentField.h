@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <raylib.h>
+
+struct CurrentFieldParams {
+    float cellSize = 40.0f;       // world units between grid nodes
+    float margin = 80.0f;         // grid reaches this far past WorldBounds
+    float tidalSpeed = 2.0f;      // uniform flow, turning once per tidal period
+    float tidalPeriod = 600.0f;   // seconds
+    int eddyCount = 5;
+    float eddySpeed = 5.0f;       // peak swirl, at eddyRadius from the centre
+    float eddyRadius = 140.0f;
+    float eddyWander = 120.0f;    // how far eddy centres stray from where they formed
+    float eddyPeriod = 900.0f;    // seconds for one wander loop
+};
+
+// water velocity over the world in units/s, time-varying. nodes live in
+// square tiles of TILE x TILE cells, each tile holding its own copy of the
+// shared edge nodes, so the four corners of any bilinear sample sit in one
+// 648-byte block. the field is refreshed a few tiles at a time on a coarse
+// schedule, not recomputed every tick; sampling is four points per vector
+// (SSE2, or WebAssembly SIMD with -msimd128; scalar otherwise).
+class OceanCurrentField {
+public:
+    static constexpr size_t TILE = 8;
+    static constexpr size_t TILE_EDGE = TILE + 1;
+    static constexpr size_t TILE_NODES = TILE_EDGE * TILE_EDGE;
+
+    // true when this build uses a vector path
+    static bool isVectorized();
+
+    OceanCurrentField();
+
+    // places the eddies from the seed and fills every tile at time 0
+    void seed(uint32_t value, const CurrentFieldParams& params = {});
+    const CurrentFieldParams& getParams() const { return params; }
+
+    // recomputes the next `tiles` tiles, round robin, at time seconds
+    void refresh(float time, size_t tiles);
+    void refreshAll(float time);
+
+    // bilinear; points outside the grid take the nearest edge
+    Vector2 sample(Vector2 position) const;
+
+    // count points strideBytes apart (so they can sit inside AoS structs)
+    // into count contiguous velocities
+    void sample(const Vector2* positions, size_t count, size_t strideBytes, Vector2* out) const;
+
+    // position += current * dt for count points strideBytes apart
+    void advect(Vector2* positions, size_t count, size_t strideBytes, float dt) const;
+
+    // upper bound on how fast the water velocity at any fixed point changes,
+    // in units/s per second; bilinear samples of the grid are held to it too
+    float getMaxRateOfChange() const;
+
+    size_t getTileCount() const { return tilesX * tilesY; }
+    size_t getMemoryBytes() const { return nodes.capacity() * sizeof(Vector2); }
+
+private:
+    struct Eddy {
+        Vector2 home;
+        float phase;
+        float spin;     // +1 counter-clockwise, -1 clockwise
+    };
+
+    Vector2 velocityAt(Vector2 position, float time) const;
+    void refreshTile(size_t tile, float time);
+
+    CurrentFieldParams params;
+    std::vector<Eddy> eddies;
+
+    Vector2 origin{0, 0};         // world position of the first node
+    float invCellSize = 0.0f;
+    size_t tilesX = 0, tilesY = 0;
+    float maxCellX = 0.0f, maxCellY = 0.0f;
+    size_t nextTile = 0;
+    std::vector<Vector2> nodes;   // tile-major, TILE_NODES per tile, row-major within
+};
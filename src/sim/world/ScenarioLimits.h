@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+// upper bounds for one scenario. in fixed-footprint mode every world pool
+// is sized from these up front and refuses to grow past them. a refused
+// spawn is only logged, so size them from the scenario: the defaults cover
+// the contacts spawned one at a time, and a scenario with school clutter
+// must set maxSchooledFish to SchoolClutter::fish()
+struct ScenarioLimits {
+    size_t maxContacts = 32;       // contacts spawned one at a time
+    size_t maxSchooledFish = 0;    // fish in schools, on top of maxContacts
+    size_t maxMissiles = 8;
+    size_t maxExplosions = 16;
+
+    // every contact at once; the contact-indexed pools are this long
+    size_t contactPool() const { return maxContacts + maxSchooledFish; }
+};
+
+// bytes held by the world's pools (capacity, not just live objects)
+struct WorldMemory {
+    size_t contacts = 0;
+    size_t missiles = 0;
+    size_t trails = 0;
+    size_t explosions = 0;
+    size_t schooling = 0;    // fish schooling scratch
+    size_t detection = 0;    // sonar detection scratch and propagation table
+    size_t tracks = 0;       // contact tracker filters and association scratch
+    size_t sweep = 0;        // sweep bearing bins
+    size_t behaviors = 0;    // submarine behaviour state
+    size_t currents = 0;     // ocean current nodes
+
+    size_t total() const {
+        return contacts + missiles + trails + explosions + schooling + detection + tracks + sweep + behaviors +
+               currents;
+    }
+};
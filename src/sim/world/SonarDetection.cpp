@@ -0,0 +1,400 @@
+#include "SonarDetection.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SONAR_DETECTION_SSE2 1
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define SONAR_DETECTION_WASM_SIMD 1
+#endif
+
+#if defined(SONAR_DETECTION_SSE2) || defined(SONAR_DETECTION_WASM_SIMD)
+    #define SONAR_DETECTION_VECTOR 1
+#endif
+
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be two packed floats");
+
+namespace {
+
+constexpr float LN2 = 0.69314718f;
+
+// the approximations are bit-level so the vector paths reproduce them
+// exactly; a contact gets the same result whichever lane it lands in.
+
+// 1/sqrt(x) from the bit-level estimate plus two newton steps, ~5e-6 relative
+inline float fastInvSqrt(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5F375A86u - (bits >> 1);
+    float y;
+    std::memcpy(&y, &bits, sizeof(y));
+    const float half = x * 0.5f;
+    y = y * (1.5f - half * y * y);
+    y = y * (1.5f - half * y * y);
+    return y;
+}
+
+// 2^x by splitting into an exponent and a cubic on the fraction
+inline float fastExp2(float x) {
+    x = std::min(std::max(x, -126.0f), 126.0f);
+    int32_t whole = static_cast<int32_t>(x);
+    whole -= (x < static_cast<float>(whole)) ? 1 : 0;   // floor for negatives
+    const float f = x - static_cast<float>(whole);
+    const float p = 1.0f + f * (0.69606564f + f * (0.22449434f + f * 0.07944024f));
+    uint32_t bits = static_cast<uint32_t>(whole + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+// 32-bit integer hash, good avalanche for sequential keys
+inline uint32_t mix(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// roughly unit normal from the four bytes of h (sum of four uniforms)
+inline float byteNormal(uint32_t h) {
+    const uint32_t sum = (h & 0xFFu) + ((h >> 8) & 0xFFu) + ((h >> 16) & 0xFFu) + (h >> 24);
+    return (static_cast<float>(sum) * (1.0f / 255.0f) - 2.0f) * 1.7320508f;
+}
+
+// four contacts per vector
+#if defined(SONAR_DETECTION_SSE2)
+using Floats = __m128;
+using Ints = __m128i;
+inline Floats lanesSplat(float v) { return _mm_set1_ps(v); }
+inline Ints lanesSplat(uint32_t v) { return _mm_set1_epi32(static_cast<int>(v)); }
+inline Floats lanesLoad(const float* p) { return _mm_loadu_ps(p); }
+inline Ints lanesLoad(const uint32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline void lanesStore(float* p, Floats v) { _mm_storeu_ps(p, v); }
+inline Floats lanesAddF(Floats a, Floats b) { return _mm_add_ps(a, b); }
+inline Floats lanesSubF(Floats a, Floats b) { return _mm_sub_ps(a, b); }
+inline Floats lanesMulF(Floats a, Floats b) { return _mm_mul_ps(a, b); }
+inline Floats lanesDivF(Floats a, Floats b) { return _mm_div_ps(a, b); }
+inline Floats lanesMin(Floats a, Floats b) { return _mm_min_ps(a, b); }
+inline Floats lanesMax(Floats a, Floats b) { return _mm_max_ps(a, b); }
+inline Floats lanesAbs(Floats a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+// bit per lane, set when a < b
+inline int lanesLess(Floats a, Floats b) { return _mm_movemask_ps(_mm_cmplt_ps(a, b)); }
+// -1 per lane where a < b
+inline Ints lanesLessMask(Floats a, Floats b) { return _mm_castps_si128(_mm_cmplt_ps(a, b)); }
+inline Ints lanesBits(Floats a) { return _mm_castps_si128(a); }
+inline Floats lanesFloats(Ints a) { return _mm_castsi128_ps(a); }
+inline Floats lanesToFloat(Ints a) { return _mm_cvtepi32_ps(a); }
+inline Ints lanesTruncate(Floats a) { return _mm_cvttps_epi32(a); }
+inline Ints lanesAdd(Ints a, Ints b) { return _mm_add_epi32(a, b); }
+inline Ints lanesSub(Ints a, Ints b) { return _mm_sub_epi32(a, b); }
+inline Ints lanesAnd(Ints a, Ints b) { return _mm_and_si128(a, b); }
+inline Ints lanesXor(Ints a, Ints b) { return _mm_xor_si128(a, b); }
+template <int N> inline Ints lanesShiftRight(Ints a) { return _mm_srli_epi32(a, N); }
+template <int N> inline Ints lanesShiftLeft(Ints a) { return _mm_slli_epi32(a, N); }
+// sse2 only multiplies the even lanes (to 64 bits), so do evens and odds and repack
+inline Ints lanesMul(Ints a, Ints b) {
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+// [x0 x1 x2 x3] [y0 y1 y2 y3] -> x0 y0 x1 y1 x2 y2 x3 y3
+inline void lanesStoreInterleaved(float* p, Floats x, Floats y) {
+    _mm_storeu_ps(p, _mm_unpacklo_ps(x, y));
+    _mm_storeu_ps(p + 4, _mm_unpackhi_ps(x, y));
+}
+#elif defined(SONAR_DETECTION_WASM_SIMD)
+using Floats = v128_t;
+using Ints = v128_t;
+inline Floats lanesSplat(float v) { return wasm_f32x4_splat(v); }
+inline Ints lanesSplat(uint32_t v) { return wasm_u32x4_splat(v); }
+inline Floats lanesLoad(const float* p) { return wasm_v128_load(p); }
+inline Ints lanesLoad(const uint32_t* p) { return wasm_v128_load(p); }
+inline void lanesStore(float* p, Floats v) { wasm_v128_store(p, v); }
+inline Floats lanesAddF(Floats a, Floats b) { return wasm_f32x4_add(a, b); }
+inline Floats lanesSubF(Floats a, Floats b) { return wasm_f32x4_sub(a, b); }
+inline Floats lanesMulF(Floats a, Floats b) { return wasm_f32x4_mul(a, b); }
+inline Floats lanesDivF(Floats a, Floats b) { return wasm_f32x4_div(a, b); }
+inline Floats lanesMin(Floats a, Floats b) { return wasm_f32x4_pmin(a, b); }
+inline Floats lanesMax(Floats a, Floats b) { return wasm_f32x4_pmax(a, b); }
+inline Floats lanesAbs(Floats a) { return wasm_f32x4_abs(a); }
+inline int lanesLess(Floats a, Floats b) { return (int)wasm_i32x4_bitmask(wasm_f32x4_lt(a, b)); }
+inline Ints lanesLessMask(Floats a, Floats b) { return wasm_f32x4_lt(a, b); }
+inline Ints lanesBits(Floats a) { return a; }
+inline Floats lanesFloats(Ints a) { return a; }
+inline Floats lanesToFloat(Ints a) { return wasm_f32x4_convert_i32x4(a); }
+inline Ints lanesTruncate(Floats a) { return wasm_i32x4_trunc_sat_f32x4(a); }
+inline Ints lanesAdd(Ints a, Ints b) { return wasm_i32x4_add(a, b); }
+inline Ints lanesSub(Ints a, Ints b) { return wasm_i32x4_sub(a, b); }
+inline Ints lanesAnd(Ints a, Ints b) { return wasm_v128_and(a, b); }
+inline Ints lanesXor(Ints a, Ints b) { return wasm_v128_xor(a, b); }
+template <int N> inline Ints lanesShiftRight(Ints a) { return wasm_u32x4_shr(a, N); }
+template <int N> inline Ints lanesShiftLeft(Ints a) { return wasm_i32x4_shl(a, N); }
+inline Ints lanesMul(Ints a, Ints b) { return wasm_i32x4_mul(a, b); }
+inline void lanesStoreInterleaved(float* p, Floats x, Floats y) {
+    wasm_v128_store(p, wasm_i32x4_shuffle(x, y, 0, 4, 1, 5));
+    wasm_v128_store(p + 4, wasm_i32x4_shuffle(x, y, 2, 6, 3, 7));
+}
+#endif
+
+#if defined(SONAR_DETECTION_VECTOR)
+// lane versions of the scalar approximations, step for step
+
+inline Floats lanesInvSqrt(Floats x) {
+    Floats y = lanesFloats(lanesSub(lanesSplat(0x5F375A86u), lanesShiftRight<1>(lanesBits(x))));
+    const Floats half = lanesMulF(x, lanesSplat(0.5f));
+    const Floats threeHalves = lanesSplat(1.5f);
+    y = lanesMulF(y, lanesSubF(threeHalves, lanesMulF(lanesMulF(half, y), y)));
+    y = lanesMulF(y, lanesSubF(threeHalves, lanesMulF(lanesMulF(half, y), y)));
+    return y;
+}
+
+inline Floats lanesExp2(Floats x) {
+    x = lanesMin(lanesMax(x, lanesSplat(-126.0f)), lanesSplat(126.0f));
+    Ints whole = lanesTruncate(x);
+    whole = lanesAdd(whole, lanesLessMask(x, lanesToFloat(whole)));   // floor for negatives
+    const Floats f = lanesSubF(x, lanesToFloat(whole));
+    Floats p = lanesAddF(lanesSplat(0.22449434f), lanesMulF(f, lanesSplat(0.07944024f)));
+    p = lanesAddF(lanesSplat(0.69606564f), lanesMulF(f, p));
+    p = lanesAddF(lanesSplat(1.0f), lanesMulF(f, p));
+    const Floats scale = lanesFloats(lanesShiftLeft<23>(lanesAdd(whole, lanesSplat(127u))));
+    return lanesMulF(p, scale);
+}
+
+inline Ints lanesMix(Ints x) {
+    x = lanesXor(x, lanesShiftRight<16>(x));
+    x = lanesMul(x, lanesSplat(0x7FEB352Du));
+    x = lanesXor(x, lanesShiftRight<15>(x));
+    x = lanesMul(x, lanesSplat(0x846CA68Bu));
+    x = lanesXor(x, lanesShiftRight<16>(x));
+    return x;
+}
+
+inline Floats lanesByteNormal(Ints h) {
+    const Ints byte = lanesSplat(0xFFu);
+    const Ints sum = lanesAdd(lanesAdd(lanesAdd(lanesAnd(h, byte), lanesAnd(lanesShiftRight<8>(h), byte)),
+                                       lanesAnd(lanesShiftRight<16>(h), byte)),
+                              lanesShiftRight<24>(h));
+    return lanesMulF(lanesSubF(lanesMulF(lanesToFloat(sum), lanesSplat(1.0f / 255.0f)), lanesSplat(2.0f)),
+                     lanesSplat(1.7320508f));
+}
+#endif
+
+}  // namespace
+
+bool SonarDetectionModel::isVectorized() {
+#if defined(SONAR_DETECTION_VECTOR)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SonarDetectionModel::setPropagation(const SoundSpeedProfile& profile, const PropagationParams& p) {
+    propagation.build(profile, p);
+    rowDepth = -1.0f;
+}
+
+void SonarDetectionModel::ping(ContactManager& contacts, Vector2 origin) {
+    const auto& active = contacts.getActiveContacts();
+    ++pingCount;
+    if (active.empty()) return;
+
+    prepare();
+    const size_t count = active.size();
+    gather(active, nullptr, count, origin);
+    computeProbabilities(count);
+    drawDetections(count);
+    contacts.applyDetections(detected.data(), errors.data(), params.holdPings);
+}
+
+void SonarDetectionModel::pingContacts(ContactManager& contacts, const uint32_t* indices, size_t count, Vector2 origin) {
+    if (count == 0) return;
+
+    prepare();
+    gather(contacts.getActiveContacts(), indices, count, origin);
+    computeProbabilities(count);
+    drawDetections(count);
+    contacts.applyDetections(indices, count, detected.data(), errors.data(), params.holdPings);
+}
+
+void SonarDetectionModel::prepare() {
+    if (!propagation.isBuilt()) setPropagation(SoundSpeedProfile::typical());
+    if (ownDepth != rowDepth) {
+        propagation.sampleDepth(ownDepth, lossRow);
+        rowDepth = ownDepth;
+    }
+}
+
+// the only pass that touches the AoS contacts; indices selects a subset, null means all
+void SonarDetectionModel::gather(const std::vector<SonarContact>& contacts, const uint32_t* indices, size_t count,
+                                 Vector2 origin) {
+    dx.resize(count);
+    dy.resize(count);
+    headingX.resize(count);
+    headingY.resize(count);
+    sourceLevel.resize(count);
+    ids.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const SonarContact& c = contacts[indices ? indices[i] : i];
+        dx[i] = c.position.x - origin.x;
+        dy[i] = c.position.y - origin.y;
+        const float invSpeed = c.speed > 0.0f ? 1.0f / c.speed : 0.0f;
+        headingX[i] = c.velocity.x * invSpeed;
+        headingY[i] = c.velocity.y * invSpeed;
+        sourceLevel[i] = params.sourceLevelDb[static_cast<int>(c.type)];
+        ids[i] = c.id;
+    }
+}
+
+// signal excess = SL - aspect loss - TL - NL - DT, then a logistic in dB.
+// range and aspect run in vector, transmission loss is a fetch from the
+// own-depth row, then the probabilities run in vector again.
+void SonarDetectionModel::computeProbabilities(size_t count) {
+    range.resize(count);
+    signalExcess.resize(count);
+    probability.resize(count);
+
+    const float aspectLoss = params.aspectLossDb;
+    const float floorDb = params.noiseLevelDb + params.detectionThresholdDb;
+    const float slope = -1.0f / (params.detectionSpreadDb * LN2);
+
+    const float* x = dx.data();
+    const float* y = dy.data();
+    const float* hx = headingX.data();
+    const float* hy = headingY.data();
+    const float* sl = sourceLevel.data();
+    float* r = range.data();
+    float* se = signalExcess.data();
+    float* p = probability.data();
+
+    // received source level after the aspect term
+    size_t i = 0;
+#if defined(SONAR_DETECTION_VECTOR)
+    const Floats one = lanesSplat(1.0f);
+    const Floats aspectLossV = lanesSplat(aspectLoss);
+    for (; i + 4 <= count; i += 4) {
+        const Floats px = lanesLoad(x + i);
+        const Floats py = lanesLoad(y + i);
+        const Floats r2 = lanesMax(lanesAddF(lanesMulF(px, px), lanesMulF(py, py)), one);
+        const Floats invR = lanesInvSqrt(r2);
+        const Floats cross = lanesSubF(lanesMulF(lanesLoad(hx + i), py), lanesMulF(lanesLoad(hy + i), px));
+        const Floats beam = lanesMulF(lanesAbs(cross), invR);
+        lanesStore(r + i, lanesMulF(r2, invR));
+        lanesStore(se + i, lanesSubF(lanesLoad(sl + i), lanesMulF(aspectLossV, lanesSubF(one, beam))));
+    }
+#endif
+    for (; i < count; ++i) {
+        const float r2 = std::max(x[i] * x[i] + y[i] * y[i], 1.0f);
+        const float invR = fastInvSqrt(r2);
+        // |sin| of the angle between heading and line of sight: 1 beam-on, 0 end-on
+        const float beam = std::fabs(hx[i] * y[i] - hy[i] * x[i]) * invR;
+        r[i] = r2 * invR;
+        se[i] = sl[i] - aspectLoss * (1.0f - beam);
+    }
+
+    const float* row = lossRow.data();
+    for (i = 0; i < count; ++i) {
+        se[i] = se[i] - propagation.lookupRow(row, r[i]) - floorDb;
+    }
+
+    i = 0;
+#if defined(SONAR_DETECTION_VECTOR)
+    const Floats slopeV = lanesSplat(slope);
+    for (; i + 4 <= count; i += 4) {
+        lanesStore(p + i, lanesDivF(one, lanesAddF(one, lanesExp2(lanesMulF(lanesLoad(se + i), slopeV)))));
+    }
+#endif
+    for (; i < count; ++i) {
+        p[i] = 1.0f / (1.0f + fastExp2(se[i] * slope));
+    }
+}
+
+// detection draw and a perceived-position error per contact. the error is
+// split into range (along the line of sight) and bearing (across it), both
+// proportional to range and shrinking as the signal gets stronger. dx, dy
+// already carry the range, so they serve as the scaled line of sight.
+void SonarDetectionModel::drawDetections(size_t count) {
+    detected.resize(count);
+    errors.resize(count);
+
+    const uint32_t pingKey = seedValue ^ (pingCount * 0x9E3779B9u);
+    const float rangeNoise = params.rangeNoiseFraction;
+    const float bearingNoise = params.bearingNoiseRad;
+
+    const float* x = dx.data();
+    const float* y = dy.data();
+    const uint32_t* id = ids.data();
+    const float* se = signalExcess.data();
+    const float* p = probability.data();
+    uint8_t* hit = detected.data();
+    float* error = reinterpret_cast<float*>(errors.data());
+
+    size_t i = 0;
+#if defined(SONAR_DETECTION_VECTOR)
+    const Ints key = lanesSplat(pingKey);
+    const Floats zero = lanesSplat(0.0f);
+    const Floats one = lanesSplat(1.0f);
+    const Floats tenth = lanesSplat(0.1f);
+    const Floats toUnit = lanesSplat(1.0f / 16777216.0f);
+    const Floats rangeNoiseV = lanesSplat(rangeNoise);
+    const Floats bearingNoiseV = lanesSplat(bearingNoise);
+    for (; i + 4 <= count; i += 4) {
+        const Ints h1 = lanesMix(lanesXor(key, lanesMul(lanesLoad(id + i), lanesSplat(0x85EBCA6Bu))));
+        const Ints h2 = lanesMix(lanesAdd(h1, lanesSplat(0x68E31DA4u)));
+        const Ints h3 = lanesMix(lanesAdd(h2, lanesSplat(0xB5297A4Du)));
+
+        const Floats u = lanesMulF(lanesToFloat(lanesShiftRight<8>(h1)), toUnit);
+        const int hits = lanesLess(u, lanesLoad(p + i));
+        for (int k = 0; k < 4; ++k) hit[i + k] = static_cast<uint8_t>((hits >> k) & 1);
+
+        const Floats quality = lanesDivF(one, lanesAddF(one, lanesMulF(lanesMax(lanesLoad(se + i), zero), tenth)));
+        const Floats along = lanesMulF(lanesMulF(rangeNoiseV, quality), lanesByteNormal(h2));
+        const Floats across = lanesMulF(lanesMulF(bearingNoiseV, quality), lanesByteNormal(h3));
+        const Floats px = lanesLoad(x + i);
+        const Floats py = lanesLoad(y + i);
+        lanesStoreInterleaved(error + 2 * i,
+                              lanesSubF(lanesMulF(px, along), lanesMulF(py, across)),
+                              lanesAddF(lanesMulF(py, along), lanesMulF(px, across)));
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint32_t h1 = mix(pingKey ^ (id[i] * 0x85EBCA6Bu));
+        const uint32_t h2 = mix(h1 + 0x68E31DA4u);
+        const uint32_t h3 = mix(h2 + 0xB5297A4Du);
+
+        const float u = static_cast<float>(h1 >> 8) * (1.0f / 16777216.0f);
+        hit[i] = u < p[i] ? 1 : 0;
+
+        const float quality = 1.0f / (1.0f + std::max(se[i], 0.0f) * 0.1f);
+        const float along = rangeNoise * quality * byteNormal(h2);
+        const float across = bearingNoise * quality * byteNormal(h3);
+        error[2 * i] = x[i] * along - y[i] * across;
+        error[2 * i + 1] = y[i] * along + x[i] * across;
+    }
+}
+
+void SonarDetectionModel::reserve(size_t count) {
+    lossRow.reserve(propagation.getColumns());
+    for (auto* v : { &dx, &dy, &headingX, &headingY, &sourceLevel, &range, &signalExcess, &probability }) {
+        v->reserve(count);
+    }
+    ids.reserve(count);
+    detected.reserve(count);
+    errors.reserve(count);
+}
+
+size_t SonarDetectionModel::getMemoryBytes() const {
+    return propagation.getMemoryBytes() +
+           (lossRow.capacity() + dx.capacity() + dy.capacity() + headingX.capacity() + headingY.capacity() +
+            sourceLevel.capacity() + range.capacity() + signalExcess.capacity() + probability.capacity()) *
+               sizeof(float) +
+           ids.capacity() * sizeof(uint32_t) + detected.capacity() * sizeof(uint8_t) +
+           errors.capacity() * sizeof(Vector2);
+}
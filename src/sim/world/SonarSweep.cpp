@@ -0,0 +1,95 @@
+#include "SonarSweep.h"
+#include <algorithm>
+#include <cmath>
+
+void SonarSweep::setParams(const SweepParams& p) {
+    params = p;
+    params.buckets = std::max<size_t>(params.buckets, 1);
+    reset();
+}
+
+void SonarSweep::reset() {
+    beamTurns = 0.0f;
+    nextBucket = 0;
+    for (auto& bin : bins) bin.clear();
+    indexed = false;
+    swept.clear();
+    visited = 0;
+}
+
+void SonarSweep::reserve(size_t count) {
+    bins.resize(params.buckets);
+    for (auto& bin : bins) bin.reserve(count);
+    swept.reserve(count);
+}
+
+size_t SonarSweep::getMemoryBytes() const {
+    size_t indices = swept.capacity();
+    for (const auto& bin : bins) indices += bin.capacity();
+    return bins.capacity() * sizeof(std::vector<uint32_t>) + indices * sizeof(uint32_t);
+}
+
+bool SonarSweep::advance(const ContactManager& contacts, float dt, Vector2 origin) {
+    const auto& active = contacts.getActiveContacts();
+    if (!indexed || contacts.getRevision() != indexedRevision) {
+        rebuild(active, origin);
+        indexedRevision = contacts.getRevision();
+    }
+
+    swept.clear();
+    visited = 0;
+
+    // bins whose leading edge the beam passes this tick; a long tick
+    // still sweeps each bin once
+    const float step = std::min(dt / params.period, 1.0f);
+    const float turns = beamTurns + step;
+    const size_t count = params.buckets;
+    const size_t target = std::min(static_cast<size_t>(turns * static_cast<float>(count)), nextBucket + count);
+    for (; nextBucket < target; ++nextBucket) {
+        sweepBucket(nextBucket % count, active, origin);
+    }
+
+    const bool scanComplete = turns >= 1.0f;
+    if (scanComplete) {
+        nextBucket -= count;
+        beamTurns = turns - 1.0f;
+    } else {
+        beamTurns = turns;
+    }
+    return scanComplete;
+}
+
+void SonarSweep::rebuild(const std::vector<SonarContact>& contacts, Vector2 origin) {
+    bins.resize(params.buckets);
+    for (auto& bin : bins) bin.clear();
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        bins[bucketOf(contacts[i].position, origin)].push_back(static_cast<uint32_t>(i));
+    }
+    indexed = true;
+}
+
+void SonarSweep::sweepBucket(size_t bucket, const std::vector<SonarContact>& contacts, Vector2 origin) {
+    std::vector<uint32_t>& bin = bins[bucket];
+    visited += bin.size();
+    for (size_t k = 0; k < bin.size();) {
+        const uint32_t index = bin[k];
+        const size_t now = bucketOf(contacts[index].position, origin);
+        if (now == bucket) {
+            swept.push_back(index);
+            ++k;
+            continue;
+        }
+        // drifted: file it where it is now. a bin ahead of the beam is
+        // swept later this revolution, one behind it on the next
+        bins[now].push_back(index);
+        bin[k] = bin.back();
+        bin.pop_back();
+    }
+}
+
+size_t SonarSweep::bucketOf(Vector2 position, Vector2 origin) const {
+    float turns = std::atan2(position.x - origin.x, origin.y - position.y) * (1.0f / 6.28318531f);
+    if (turns < 0.0f) turns += 1.0f;
+    const size_t bucket = static_cast<size_t>(turns * static_cast<float>(params.buckets));
+    return std::min(bucket, params.buckets - 1);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <raylib.h>
+#include "ContactManager.h"
+
+struct SweepParams {
+    float period = 4.0f;     // seconds per beam revolution
+    size_t buckets = 256;    // angular bins over the full circle
+};
+
+// rotating active-sonar beam. contacts are binned by bearing from the
+// sonar, and each tick the beam walks only the bins it crossed, so the
+// work per tick follows the population of the swept wedge. a contact that
+// has drifted out of its bin is moved to the right one when its old bin
+// is swept; the index is rebuilt only when contacts spawn or leave.
+// bearings run clockwise from north (screen up).
+class SonarSweep {
+public:
+    void setParams(const SweepParams& p);
+    const SweepParams& getParams() const { return params; }
+
+    // beam back to north, index dropped (the bins keep their storage)
+    void reset();
+
+    // sizes every bin and the swept list for count contacts, the worst case
+    // of all of them on one bearing
+    void reserve(size_t count);
+    size_t getMemoryBytes() const;
+
+    // turns the beam by dt (at most one revolution) and collects the
+    // contacts it crossed into getSwept(). returns true when the beam
+    // passed north, completing a scan.
+    bool advance(const ContactManager& contacts, float dt, Vector2 origin = {0, 0});
+
+    // active contact indices swept by the last advance
+    const std::vector<uint32_t>& getSwept() const { return swept; }
+    // contacts looked at by the last advance, swept or moved to another bin
+    size_t getVisited() const { return visited; }
+
+    // beam bearing in turns, 0..1
+    float getBeamTurns() const { return beamTurns; }
+    float getBeamBearing() const { return beamTurns * 6.28318531f; }
+
+private:
+    void rebuild(const std::vector<SonarContact>& contacts, Vector2 origin);
+    void sweepBucket(size_t bucket, const std::vector<SonarContact>& contacts, Vector2 origin);
+    size_t bucketOf(Vector2 position, Vector2 origin) const;
+
+    SweepParams params;
+    float beamTurns = 0.0f;
+    size_t nextBucket = 0;        // first bin the beam has not crossed this revolution
+
+    std::vector<std::vector<uint32_t>> bins;   // active contact indices per bearing bin
+    bool indexed = false;
+    uint32_t indexedRevision = 0;
+    std::vector<uint32_t> swept;
+    size_t visited = 0;
+};
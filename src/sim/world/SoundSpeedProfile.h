@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// sound speed (m/s) against depth (m), linear between points sorted by
+// depth and constant past either end
+struct SoundSpeedProfile {
+    struct Point {
+        float depthMeters;
+        float speed;
+    };
+    std::vector<Point> points;
+
+    // warm mixed layer over a thermocline, then the slow rise with pressure
+    static SoundSpeedProfile typical() {
+        return { { {0.0f, 1520.0f}, {80.0f, 1521.3f}, {350.0f, 1490.0f}, {1500.0f, 1509.5f} } };
+    }
+
+    // no refraction at all
+    static SoundSpeedProfile isovelocity(float speed = 1500.0f) {
+        return { { {0.0f, speed} } };
+    }
+
+    float speedAt(float depthMeters) const {
+        const size_t i = segmentAt(depthMeters);
+        if (i + 1 >= points.size()) return points.empty() ? 1500.0f : points.back().speed;
+        if (depthMeters <= points[i].depthMeters) return points[i].speed;
+        return points[i].speed + gradientOf(i) * (depthMeters - points[i].depthMeters);
+    }
+
+    // dc/dz in 1/s; zero past the ends
+    float gradientAt(float depthMeters) const {
+        const size_t i = segmentAt(depthMeters);
+        if (i + 1 >= points.size() || depthMeters < points[i].depthMeters) return 0.0f;
+        return gradientOf(i);
+    }
+
+private:
+    // last point at or above the depth (0 when shallower than all of them)
+    size_t segmentAt(float depthMeters) const {
+        size_t i = 0;
+        while (i + 1 < points.size() && points[i + 1].depthMeters <= depthMeters) ++i;
+        return i;
+    }
+
+    float gradientOf(size_t i) const {
+        return (points[i + 1].speed - points[i].speed) / (points[i + 1].depthMeters - points[i].depthMeters);
+    }
+};
@@ -0,0 +1,194 @@
+#include "SubmarineBehaviors.h"
+#include "WorldBounds.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+bool isSub(ContactType type) {
+    return type == ContactType::EnemySub || type == ContactType::FriendlySub;
+}
+
+// v scaled to length, or zero when v is
+Vector2 scaledTo(Vector2 v, float length) {
+    const float l = std::sqrt(v.x * v.x + v.y * v.y);
+    if (l <= 0.0f) return { 0.0f, 0.0f };
+    return { v.x * (length / l), v.y * (length / l) };
+}
+
+}  // namespace
+
+SubmarineBehaviors::SubmarineBehaviors() : rng(std::random_device{}()) {}
+
+float SubmarineBehaviors::randRange(float lo, float hi) {
+    return std::uniform_real_distribution<float>(lo, hi)(rng);
+}
+
+void SubmarineBehaviors::update(ContactManager& contacts, const std::vector<Vector2>& threats, float dt, Vector2 ownShip) {
+    if (!synced || contacts.getRevision() != syncedRevision) {
+        resync(contacts.getActiveContacts());
+        syncedRevision = contacts.getRevision();
+    }
+
+    const auto& active = contacts.getActiveContacts();
+
+    // this tick's share of decisions
+    decisions = 0;
+    if (!subs.empty() && params.decisionInterval > 0.0f) {
+        pending += static_cast<float>(subs.size()) * dt / params.decisionInterval;
+        const size_t due = std::min(static_cast<size_t>(pending), subs.size());
+        pending -= static_cast<float>(due);
+        for (size_t k = 0; k < due; ++k) {
+            cursor %= subs.size();
+            const uint32_t index = subs[cursor++];
+            decide(index, active[index], threats, ownShip);
+        }
+        decisions = due;
+    }
+
+    // every sub eases toward its desired velocity
+    const float step = params.acceleration * dt;
+    converging = 0;
+    for (uint32_t index : subs) {
+        const Vector2 v = active[index].velocity;
+        const float dx = desiredX[index] - v.x;
+        const float dy = desiredY[index] - v.y;
+        if (dx == 0.0f && dy == 0.0f) continue;
+
+        const float gap = std::sqrt(dx * dx + dy * dy);
+        if (gap <= step) {
+            contacts.setVelocity(index, { desiredX[index], desiredY[index] });
+        } else {
+            contacts.setVelocity(index, { v.x + dx * (step / gap), v.y + dy * (step / gap) });
+            ++converging;
+        }
+    }
+}
+
+float SubmarineBehaviors::getNextDeadline(const ContactManager& contacts) const {
+    if (!synced || contacts.getRevision() != syncedRevision || converging > 0) return 0.0f;
+    if (subs.empty() || params.decisionInterval <= 0.0f) return std::numeric_limits<float>::infinity();
+    return (1.0f - pending) * params.decisionInterval / static_cast<float>(subs.size());
+}
+
+// contacts are appended on spawn and erased in order, so walking the old
+// and new lists together carries each survivor's state across; the first
+// contact with no old state starts the freshly spawned tail. new contacts
+// hold their spawn velocity until their first decision.
+void SubmarineBehaviors::resync(const std::vector<SonarContact>& contacts) {
+    const size_t count = contacts.size();
+    size_t old = 0;
+    size_t kept = 0;
+    for (; kept < count; ++kept) {
+        const SonarContact& c = contacts[kept];
+        while (old < ids.size() && (ids[old] != c.id || types[old] != c.type)) ++old;
+        if (old == ids.size()) break;
+        // kept <= old, so moving down never overwrites a state still to be read
+        ids[kept] = ids[old];
+        types[kept] = types[old];
+        behavior[kept] = behavior[old];
+        waypointX[kept] = waypointX[old];
+        waypointY[kept] = waypointY[old];
+        desiredX[kept] = desiredX[old];
+        desiredY[kept] = desiredY[old];
+        hasWaypoint[kept] = hasWaypoint[old];
+        ++old;
+    }
+
+    ids.resize(count);
+    types.resize(count);
+    behavior.resize(count);
+    waypointX.resize(count);
+    waypointY.resize(count);
+    desiredX.resize(count);
+    desiredY.resize(count);
+    hasWaypoint.resize(count);
+    for (size_t i = kept; i < count; ++i) {
+        const SonarContact& c = contacts[i];
+        ids[i] = c.id;
+        types[i] = c.type;
+        behavior[i] = SubBehavior::Patrol;
+        desiredX[i] = c.velocity.x;
+        desiredY[i] = c.velocity.y;
+        hasWaypoint[i] = 0;
+    }
+
+    subs.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (isSub(types[i])) subs.push_back(static_cast<uint32_t>(i));
+    }
+    if (!subs.empty()) cursor %= subs.size();
+    synced = true;
+}
+
+void SubmarineBehaviors::decide(size_t index, const SonarContact& contact, const std::vector<Vector2>& threats,
+                                Vector2 ownShip) {
+    const Vector2 p = contact.position;
+
+    // the nearest missile in range wins over everything else
+    float nearest = params.evadeRange * params.evadeRange;
+    const Vector2* threat = nullptr;
+    for (const Vector2& t : threats) {
+        const float d2 = (p.x - t.x) * (p.x - t.x) + (p.y - t.y) * (p.y - t.y);
+        if (d2 < nearest) {
+            nearest = d2;
+            threat = &t;
+        }
+    }
+    if (threat) {
+        behavior[index] = SubBehavior::Evade;
+        Vector2 away = scaledTo({ p.x - threat->x, p.y - threat->y }, params.evadeSpeed);
+        if (away.x == 0.0f && away.y == 0.0f) away = scaledTo(contact.velocity, params.evadeSpeed);
+        desiredX[index] = away.x;
+        desiredY[index] = away.y;
+        return;
+    }
+
+    const Vector2 toShip = { ownShip.x - p.x, ownShip.y - p.y };
+    const float shipRange = std::sqrt(toShip.x * toShip.x + toShip.y * toShip.y);
+    if (contact.type == ContactType::EnemySub && shipRange < params.closeRange) {
+        behavior[index] = SubBehavior::Close;
+        // run in, then circle at the standoff range
+        const Vector2 v = shipRange > params.standoffRange
+            ? scaledTo(toShip, params.closeSpeed)
+            : scaledTo({ -toShip.y, toShip.x }, params.patrolSpeed);
+        desiredX[index] = v.x;
+        desiredY[index] = v.y;
+        return;
+    }
+
+    behavior[index] = SubBehavior::Patrol;
+    const float wx = waypointX[index] - p.x;
+    const float wy = waypointY[index] - p.y;
+    if (!hasWaypoint[index] || wx * wx + wy * wy < params.waypointRadius * params.waypointRadius) {
+        pickWaypoint(index);
+    }
+    const Vector2 v = scaledTo({ waypointX[index] - p.x, waypointY[index] - p.y }, params.patrolSpeed);
+    desiredX[index] = v.x;
+    desiredY[index] = v.y;
+}
+
+void SubmarineBehaviors::pickWaypoint(size_t index) {
+    const float halfWidth = WorldBounds::HALF_WIDTH - params.patrolMargin;
+    const float halfHeight = WorldBounds::HALF_HEIGHT - params.patrolMargin;
+    waypointX[index] = randRange(-halfWidth, halfWidth);
+    waypointY[index] = randRange(-halfHeight, halfHeight);
+    hasWaypoint[index] = 1;
+}
+
+void SubmarineBehaviors::reserve(size_t count) {
+    ids.reserve(count);
+    types.reserve(count);
+    behavior.reserve(count);
+    for (auto* v : { &waypointX, &waypointY, &desiredX, &desiredY }) v->reserve(count);
+    hasWaypoint.reserve(count);
+    subs.reserve(count);
+}
+
+size_t SubmarineBehaviors::getMemoryBytes() const {
+    return (ids.capacity() + subs.capacity()) * sizeof(uint32_t) + types.capacity() * sizeof(ContactType) +
+           behavior.capacity() * sizeof(SubBehavior) +
+           (waypointX.capacity() + waypointY.capacity() + desiredX.capacity() + desiredY.capacity()) * sizeof(float) +
+           hasWaypoint.capacity() * sizeof(uint8_t);
+}
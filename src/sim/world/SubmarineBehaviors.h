@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <raylib.h>
+#include "ContactManager.h"
+
+enum class SubBehavior : uint8_t { Patrol, Close, Evade };
+
+struct BehaviorParams {
+    float decisionInterval = 1.0f;   // seconds between decisions for any one sub
+    float patrolSpeed = 12.0f;
+    float closeSpeed = 20.0f;
+    float evadeSpeed = 28.0f;
+    float acceleration = 8.0f;       // units/s^2 of velocity change toward the desired velocity
+    float closeRange = 350.0f;       // enemies this near own ship close on it...
+    float standoffRange = 120.0f;    // ...and circle it from here
+    float evadeRange = 250.0f;       // a missile this near sends any sub running
+    float waypointRadius = 25.0f;
+    float patrolMargin = 60.0f;      // waypoints stay this far inside WorldBounds
+};
+
+// manoeuvring for EnemySub and FriendlySub contacts: patrol between
+// waypoints, run from missiles, and (enemies) close on own ship. state is
+// kept in flat arrays beside the active contacts. decisions are made
+// round robin, a slice of the subs per tick so each is revisited every
+// decisionInterval; in between, every sub just steers toward the
+// velocity its last decision chose.
+class SubmarineBehaviors {
+public:
+    SubmarineBehaviors();
+
+    void seed(uint32_t value) { rng.seed(value); }
+
+    void setParams(const BehaviorParams& p) { params = p; }
+    const BehaviorParams& getParams() const { return params; }
+
+    // threats are live missile positions; ownShip is what enemies close on
+    void update(ContactManager& contacts, const std::vector<Vector2>& threats, float dt, Vector2 ownShip = {0, 0});
+
+    size_t getSubCount() const { return subs.size(); }
+    // decisions made by the last update
+    size_t getDecisionCount() const { return decisions; }
+    // subs the last update left short of their desired velocity
+    size_t getConvergingCount() const { return converging; }
+    // sim seconds the subs can go without steering: 0 while any is still
+    // converging or the contacts changed since the last update, otherwise
+    // until the next round-robin decision
+    float getNextDeadline(const ContactManager& contacts) const;
+    // behaviour of the contact at this active index (Patrol for non-subs)
+    SubBehavior getBehavior(size_t contactIndex) const { return behavior[contactIndex]; }
+    Vector2 getWaypoint(size_t contactIndex) const { return { waypointX[contactIndex], waypointY[contactIndex] }; }
+
+    // sizes the per-contact arrays for count contacts up front
+    void reserve(size_t count);
+    size_t getMemoryBytes() const;
+
+private:
+    void resync(const std::vector<SonarContact>& contacts);
+    void decide(size_t index, const SonarContact& contact, const std::vector<Vector2>& threats, Vector2 ownShip);
+    void pickWaypoint(size_t index);
+    float randRange(float lo, float hi);
+
+    BehaviorParams params;
+    std::mt19937 rng;
+
+    // one entry per active contact, index-aligned with getActiveContacts()
+    std::vector<uint32_t> ids;
+    std::vector<ContactType> types;
+    std::vector<SubBehavior> behavior;
+    std::vector<float> waypointX, waypointY;
+    std::vector<float> desiredX, desiredY;
+    std::vector<uint8_t> hasWaypoint;
+
+    std::vector<uint32_t> subs;     // active indices of the submarines
+    bool synced = false;
+    uint32_t syncedRevision = 0;
+    size_t cursor = 0;              // next sub to decide, round robin
+    float pending = 0.0f;           // fractional decisions carried between ticks
+    size_t decisions = 0;
+    size_t converging = 0;
+};
@@ -0,0 +1,108 @@
+#include "TransmissionLossTable.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr int FAN_RAYS = 9;
+constexpr float FAN_HALF_ANGLE = 0.07f;   // about 4 degrees either side of horizontal
+constexpr float STEP_METERS = 20.0f;
+
+}  // namespace
+
+void TransmissionLossTable::build(const SoundSpeedProfile& profile, const PropagationParams& p) {
+    params = p;
+    rows = static_cast<size_t>(params.maxDepthMeters / params.depthStepMeters) + 1;
+    columns = static_cast<size_t>(params.maxRange / params.rangeStep) + 1;
+    rows = std::max<size_t>(rows, 2);
+    columns = std::max<size_t>(columns, 2);
+    invRangeStep = 1.0f / params.rangeStep;
+
+    // ray curvature g/c per meter of depth, so the trace doesn't walk the profile every step
+    const size_t levels = static_cast<size_t>(params.bottomMeters) + 1;
+    curvature.resize(levels);
+    for (size_t z = 0; z < levels; ++z) {
+        const float depth = static_cast<float>(z) + 0.5f;
+        curvature[z] = profile.gradientAt(depth) / profile.speedAt(depth);
+    }
+
+    table.resize(rows * columns);
+    for (size_t r = 0; r < rows; ++r) {
+        traceRow(static_cast<float>(r) * params.depthStepMeters, &table[r * columns]);
+    }
+    curvature.clear();
+    curvature.shrink_to_fit();
+}
+
+// marches the fan in range, all rays side by side. a ray's angle changes by
+// -g/c per meter of range (snell's law for a linear profile), and it
+// reflects off the surface and the bottom. per column we keep the closest
+// any ray gets to the source depth; where none come back the contacts are
+// in shadow.
+void TransmissionLossTable::traceRow(float sourceDepth, float* out) {
+    closest.assign(columns, std::numeric_limits<float>::max());
+    const float columnMeters = params.rangeStep * params.metersPerUnit;
+    const float bottom = params.bottomMeters;
+    const size_t deepest = curvature.size() - 1;
+
+    float angle[FAN_RAYS];
+    float depth[FAN_RAYS];
+    for (int k = 0; k < FAN_RAYS; ++k) {
+        angle[k] = -FAN_HALF_ANGLE + 2.0f * FAN_HALF_ANGLE * static_cast<float>(k) / (FAN_RAYS - 1);
+        depth[k] = sourceDepth;
+    }
+
+    for (float x = 0.0f;; x += STEP_METERS) {
+        const size_t column = static_cast<size_t>(x / columnMeters + 0.5f);
+        if (column >= columns) break;
+
+        float nearest = closest[column];
+        for (int k = 0; k < FAN_RAYS; ++k) {
+            nearest = std::min(nearest, std::fabs(depth[k] - sourceDepth));
+
+            float a = angle[k] - curvature[std::min(static_cast<size_t>(depth[k]), deepest)] * STEP_METERS;
+            // fan angles stay small, so tan to third order is plenty
+            float z = depth[k] + (a + a * a * a * (1.0f / 3.0f)) * STEP_METERS;
+            if (z < 0.0f) {
+                z = -z;
+                a = -a;
+            } else if (z > bottom) {
+                z = 2.0f * bottom - z;
+                a = -a;
+            }
+            angle[k] = a;
+            depth[k] = z;
+        }
+        closest[column] = nearest;
+    }
+
+    const float band = params.contactBandMeters;
+    for (size_t c = 0; c < columns; ++c) {
+        const float range = static_cast<float>(c) * params.rangeStep;
+        const float spreading = 20.0f * std::log10(std::max(range, 1.0f));
+        const float shadow = std::min(std::max((closest[c] - band) / band, 0.0f), 1.0f);
+        out[c] = spreading + params.absorptionDbPerUnit * range + params.shadowLossDb * shadow;
+    }
+}
+
+float TransmissionLossTable::lookup(float depthMeters, float range) const {
+    const float at = std::min(std::max(depthMeters, 0.0f), params.maxDepthMeters) / params.depthStepMeters;
+    const size_t r = std::min(static_cast<size_t>(at), rows - 2);
+    const float f = at - static_cast<float>(r);
+    const float shallow = lookupRow(&table[r * columns], range);
+    const float deep = lookupRow(&table[(r + 1) * columns], range);
+    return shallow + (deep - shallow) * f;
+}
+
+void TransmissionLossTable::sampleDepth(float depthMeters, std::vector<float>& row) const {
+    const float at = std::min(std::max(depthMeters, 0.0f), params.maxDepthMeters) / params.depthStepMeters;
+    const size_t r = std::min(static_cast<size_t>(at), rows - 2);
+    const float f = at - static_cast<float>(r);
+    const float* shallow = &table[r * columns];
+    const float* deep = &table[(r + 1) * columns];
+
+    row.resize(columns);
+    for (size_t c = 0; c < columns; ++c) {
+        row[c] = shallow[c] + (deep[c] - shallow[c]) * f;
+    }
+}
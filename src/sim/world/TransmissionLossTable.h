@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "SoundSpeedProfile.h"
+
+struct PropagationParams {
+    float metersPerUnit = 10.0f;          // world units to meters for the ray trace
+    float absorptionDbPerUnit = 0.02f;
+    float shadowLossDb = 8.0f;            // extra loss once every ray has left the contact band
+    float contactBandMeters = 50.0f;      // contacts are taken to be this close to own depth
+    float bottomMeters = 1500.0f;
+    float maxDepthMeters = 500.0f;        // table rows, own depth 0..max
+    float depthStepMeters = 10.0f;
+    float maxRange = 720.0f;              // table columns, world units 0..max
+    float rangeStep = 5.0f;
+};
+
+// transmission loss in dB by own depth and range, solved once per sound
+// speed profile. each row traces a small fan of rays from that depth through
+// the profile: spherical spreading plus absorption, and a shadow loss where
+// refraction has carried every ray away from the contacts' depth band.
+// lookups are bilinear; a ping samples the own-depth row once and then
+// costs one lerp per contact.
+class TransmissionLossTable {
+public:
+    void build(const SoundSpeedProfile& profile, const PropagationParams& params = {});
+    bool isBuilt() const { return !table.empty(); }
+    const PropagationParams& getParams() const { return params; }
+
+    // bilinear in depth and range, both clamped to the table
+    float lookup(float depthMeters, float range) const;
+
+    // the row for one own depth, interpolated between the two nearest rows
+    void sampleDepth(float depthMeters, std::vector<float>& row) const;
+
+    // linear lookup along a row from sampleDepth
+    float lookupRow(const float* row, float range) const {
+        const float at = std::min(std::max(range, 0.0f), params.maxRange) * invRangeStep;
+        const size_t i = std::min(static_cast<size_t>(at), columns - 2);
+        const float f = at - static_cast<float>(i);
+        return row[i] + (row[i + 1] - row[i]) * f;
+    }
+
+    size_t getRows() const { return rows; }
+    size_t getColumns() const { return columns; }
+    size_t getMemoryBytes() const { return (table.capacity() + curvature.capacity() + closest.capacity()) * sizeof(float); }
+
+private:
+    void traceRow(float sourceDepth, float* out);
+
+    PropagationParams params;
+    size_t rows = 0;
+    size_t columns = 0;
+    float invRangeStep = 0.0f;
+    std::vector<float> table;     // rows * columns, row-major by depth
+    std::vector<float> curvature; // build scratch: g/c per meter of depth
+    std::vector<float> closest;   // build scratch: per-column closest ray
+};
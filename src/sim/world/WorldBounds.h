@@ -0,0 +1,15 @@
+#pragma once
+
+#include <raylib.h>
+
+// sonar world extents in world units, centred on own ship
+struct WorldBounds {
+    static constexpr float HALF_WIDTH = 600.0f;
+    static constexpr float HALF_HEIGHT = 360.0f;
+    static constexpr float WIDTH = 2.0f * HALF_WIDTH;
+    static constexpr float HEIGHT = 2.0f * HALF_HEIGHT;
+
+    static bool contains(Vector2 p) {
+        return p.x >= -HALF_WIDTH && p.x <= HALF_WIDTH && p.y >= -HALF_HEIGHT && p.y <= HALF_HEIGHT;
+    }
+};
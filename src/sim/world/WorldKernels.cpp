@@ -0,0 +1,125 @@
+#include "WorldKernels.h"
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define WORLD_KERNELS_SSE2 1
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define WORLD_KERNELS_WASM_SIMD 1
+#endif
+
+#if defined(WORLD_KERNELS_SSE2) || defined(WORLD_KERNELS_WASM_SIMD)
+    #define WORLD_KERNELS_VECTOR 1
+#endif
+
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be two packed floats");
+
+#if defined(WORLD_KERNELS_SSE2)
+using Lanes = __m128;
+static inline Lanes lanesSplat(float v) { return _mm_set1_ps(v); }
+static inline Lanes lanesLoad(const float* p) { return _mm_loadu_ps(p); }
+// two Vector2s from unrelated addresses into one vector
+static inline Lanes lanesLoadPair(const float* lo, const float* hi) {
+    return _mm_castpd_ps(_mm_loadh_pd(_mm_load_sd(reinterpret_cast<const double*>(lo)),
+                                      reinterpret_cast<const double*>(hi)));
+}
+static inline void lanesStorePair(float* lo, float* hi, Lanes v) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(lo), v);
+    _mm_storeh_pi(reinterpret_cast<__m64*>(hi), v);
+}
+static inline Lanes lanesMulAdd(Lanes v, Lanes m, Lanes a) { return _mm_add_ps(_mm_mul_ps(v, m), a); }
+static inline Lanes lanesSub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+static inline Lanes lanesMul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+// [x0 y0 x1 y1] [x2 y2 x3 y3] -> [x0 x1 x2 x3] and [y0 y1 y2 y3]
+static inline Lanes lanesEvens(Lanes a, Lanes b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)); }
+static inline Lanes lanesOdds(Lanes a, Lanes b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)); }
+// bit per lane, set when v <= limit
+static inline int lanesAtMost(Lanes v, Lanes limit) { return _mm_movemask_ps(_mm_cmple_ps(v, limit)); }
+#elif defined(WORLD_KERNELS_WASM_SIMD)
+using Lanes = v128_t;
+static inline Lanes lanesSplat(float v) { return wasm_f32x4_splat(v); }
+static inline Lanes lanesLoad(const float* p) { return wasm_v128_load(p); }
+static inline Lanes lanesLoadPair(const float* lo, const float* hi) {
+    return wasm_v128_load64_lane(hi, wasm_v128_load64_zero(lo), 1);
+}
+static inline void lanesStorePair(float* lo, float* hi, Lanes v) {
+    wasm_v128_store64_lane(lo, v, 0);
+    wasm_v128_store64_lane(hi, v, 1);
+}
+static inline Lanes lanesMulAdd(Lanes v, Lanes m, Lanes a) { return wasm_f32x4_add(wasm_f32x4_mul(v, m), a); }
+static inline Lanes lanesSub(Lanes a, Lanes b) { return wasm_f32x4_sub(a, b); }
+static inline Lanes lanesMul(Lanes a, Lanes b) { return wasm_f32x4_mul(a, b); }
+static inline Lanes lanesEvens(Lanes a, Lanes b) { return wasm_i32x4_shuffle(a, b, 0, 2, 4, 6); }
+static inline Lanes lanesOdds(Lanes a, Lanes b) { return wasm_i32x4_shuffle(a, b, 1, 3, 5, 7); }
+static inline int lanesAtMost(Lanes v, Lanes limit) { return (int)wasm_i32x4_bitmask(wasm_f32x4_le(v, limit)); }
+#endif
+
+static inline int lowestBit(int mask) {
+    int bit = 0;
+    while (!(mask & (1 << bit))) ++bit;
+    return bit;
+}
+
+bool WorldKernels::isVectorized() {
+#if defined(WORLD_KERNELS_VECTOR)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void WorldKernels::integrate(Vector2* positions, Vector2* previous, const Vector2* velocities,
+                             size_t count, size_t strideBytes, float dt) {
+    auto at = [strideBytes](auto* base, size_t i) {
+        using T = std::remove_pointer_t<decltype(base)>;
+        using Byte = std::conditional_t<std::is_const_v<T>, const char, char>;
+        return reinterpret_cast<T*>(reinterpret_cast<Byte*>(base) + i * strideBytes);
+    };
+
+    size_t i = 0;
+#if defined(WORLD_KERNELS_VECTOR)
+    const Lanes step = lanesSplat(dt);
+    for (; i + 2 <= count; i += 2) {
+        float* p0 = &at(positions, i)->x;
+        float* p1 = &at(positions, i + 1)->x;
+        const Lanes p = lanesLoadPair(p0, p1);
+        if (previous) lanesStorePair(&at(previous, i)->x, &at(previous, i + 1)->x, p);
+        const Lanes v = lanesLoadPair(&at(velocities, i)->x, &at(velocities, i + 1)->x);
+        lanesStorePair(p0, p1, lanesMulAdd(v, step, p));
+    }
+#endif
+    for (; i < count; ++i) {
+        Vector2& p = *at(positions, i);
+        const Vector2& v = *at(velocities, i);
+        if (previous) *at(previous, i) = p;
+        p.x += v.x * dt;
+        p.y += v.y * dt;
+    }
+}
+
+size_t WorldKernels::firstWithinRadius(const Vector2* points, size_t count, Vector2 center, float radius) {
+    const float radiusSq = radius * radius;
+    size_t i = 0;
+#if defined(WORLD_KERNELS_VECTOR)
+    const float* in = reinterpret_cast<const float*>(points);
+    const Lanes cx = lanesSplat(center.x);
+    const Lanes cy = lanesSplat(center.y);
+    const Lanes limit = lanesSplat(radiusSq);
+    for (; i + 4 <= count; i += 4) {
+        const Lanes a = lanesLoad(in + 2 * i);
+        const Lanes b = lanesLoad(in + 2 * i + 4);
+        const Lanes dx = lanesSub(lanesEvens(a, b), cx);
+        const Lanes dy = lanesSub(lanesOdds(a, b), cy);
+        const int hits = lanesAtMost(lanesMulAdd(dx, dx, lanesMul(dy, dy)), limit);
+        if (hits) return i + static_cast<size_t>(lowestBit(hits));
+    }
+#endif
+    for (; i < count; ++i) {
+        const float dx = points[i].x - center.x;
+        const float dy = points[i].y - center.y;
+        if (dx * dx + dy * dy <= radiusSq) return i;
+    }
+    return count;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <raylib.h>
+
+// hot per-step loops over world objects. built with SSE2 on desktop and with
+// WebAssembly SIMD when the web build enables -msimd128; otherwise scalar.
+struct WorldKernels {
+    // true when this build uses a vector path
+    static bool isVectorized();
+
+    // position += velocity * dt for count objects, two per vector. elements
+    // are strideBytes apart so the fields can live inside AoS structs; the
+    // old position is copied to previous first when previous is non-null.
+    static void integrate(Vector2* positions, Vector2* previous, const Vector2* velocities,
+                          size_t count, size_t strideBytes, float dt);
+
+    // index of the first of count contiguous points within radius of
+    // center (inclusive), or count when there is none. four points per vector.
+    static size_t firstWithinRadius(const Vector2* points, size_t count, Vector2 center, float radius);
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+// running total of heap allocations made through global operator new,
+// counted by the replacement operators in AllocationCounter.cpp. those are
+// only compiled with PAYLOAD_SIM_COUNT_ALLOCATIONS, which the app target
+// sets; everywhere else the count stays 0.
+uint64_t getAllocationCount();
+bool isAllocationCountingEnabled();
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <raylib.h>
+
+// decides per tick whether the scene needs redrawing. while the sim runs or
+// the operator is interacting every tick is drawn; otherwise the screen is
+// refreshed at a low heartbeat and skipped ticks only poll input and sleep.
+class FramePacer {
+public:
+    explicit FramePacer(float heartbeatHz = 4.0f, float activeFps = 60.0f)
+        : heartbeatInterval(1.0 / heartbeatHz), idleSleep(1.0 / activeFps) {}
+
+    // wall-clock frame time. measured here because GetFrameTime() only
+    // advances inside EndDrawing, which idle ticks skip.
+    float beginFrame() {
+        const double now = GetTime();
+        const double dt = (lastTime < 0.0) ? 0.0 : now - lastTime;
+        lastTime = now;
+        // a minimized or stalled window should not fast-forward the sim
+        return static_cast<float>(std::min(dt, maxFrameTime));
+    }
+
+    // true when this tick should go through BeginDrawing/EndDrawing
+    bool shouldDraw(bool sceneAnimating) {
+        // nothing to show while minimized or hidden
+        if (IsWindowMinimized() || IsWindowHidden()) return false;
+
+        if (sceneAnimating || hasInput() || IsWindowResized()) {
+            idleSince = -1.0;
+            return true;
+        }
+
+        // first idle tick still draws, so the last change is on screen
+        if (idleSince < 0.0) {
+            idleSince = lastTime;
+            return true;
+        }
+        return lastTime - lastDrawTime >= heartbeatInterval;
+    }
+
+    void frameDrawn() {
+        lastDrawTime = lastTime;
+    }
+
+    // stands in for the input polling and frame wait EndDrawing would do
+    void frameSkipped() const {
+        PollInputEvents();
+#ifndef PLATFORM_WEB
+        // on the web requestAnimationFrame already paces the loop, and
+        // WaitTime would busy-wait the browser thread
+        WaitTime(idleSleep);
+#endif
+    }
+
+    bool isIdle() const { return idleSince >= 0.0; }
+
+private:
+    static bool hasInput() {
+        const Vector2 delta = GetMouseDelta();
+        if (delta.x != 0.0f || delta.y != 0.0f) return true;
+        if (GetMouseWheelMove() != 0.0f) return true;
+        for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; ++button) {
+            if (IsMouseButtonDown(button) || IsMouseButtonReleased(button)) return true;
+        }
+        // reads key state only: GetKeyPressed would pop raylib's shared
+        // press queue, and a held key would stop counting after one tick
+        for (int key = KEY_SPACE; key <= KEY_KB_MENU; ++key) {
+            if (IsKeyDown(key) || IsKeyPressed(key) || IsKeyReleased(key)) return true;
+        }
+        return false;
+    }
+
+    static constexpr double maxFrameTime = 0.25;
+
+    double heartbeatInterval;
+    double idleSleep;
+    double lastTime = -1.0;
+    double lastDrawTime = 0.0;
+    double idleSince = -1.0;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include "AllocationCounter.h"
+
+// per-frame cpu timings for the main loop, split into sim, ui update and draw,
+// kept as a short rolling history for the profiler overlay
+class FrameProfiler {
+public:
+    enum Section { SIM = 0, UI_UPDATE, DRAW, SECTION_COUNT };
+
+    struct Sample {
+        float sectionMs[SECTION_COUNT] = {};
+        uint32_t allocations = 0;
+
+        float totalMs() const { return sectionMs[SIM] + sectionMs[UI_UPDATE] + sectionMs[DRAW]; }
+    };
+
+    static constexpr size_t historySize = 120;
+
+    // where allocation totals are read from; the global counter by default
+    using AllocationSource = uint64_t (*)();
+    explicit FrameProfiler(AllocationSource allocations = getAllocationCount) : allocationSource(allocations) {}
+
+    void beginFrame() {
+        current = Sample{};
+        sectionStart = Clock::now();
+        allocationsAtStart = allocationSource();
+    }
+
+    // closes the running section and starts timing the next one
+    void mark(Section section) {
+        const auto now = Clock::now();
+        current.sectionMs[section] += std::chrono::duration<float, std::milli>(now - sectionStart).count();
+        sectionStart = now;
+    }
+
+    void endFrame() {
+        current.allocations = static_cast<uint32_t>(allocationSource() - allocationsAtStart);
+        head = (head + 1) % historySize;
+        history[head] = current;
+        if (count < historySize) ++count;
+    }
+
+    // age 0 is the most recent frame
+    const Sample& getSample(size_t age) const { return history[(head + historySize - age) % historySize]; }
+    size_t getSampleCount() const { return count; }
+
+    float getAverageMs(Section section) const {
+        if (count == 0) return 0.0f;
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i) sum += getSample(i).sectionMs[section];
+        return sum / count;
+    }
+
+    float getPeakTotalMs() const {
+        float peak = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            const float total = getSample(i).totalMs();
+            if (total > peak) peak = total;
+        }
+        return peak;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    AllocationSource allocationSource;
+    std::array<Sample, historySize> history{};
+    size_t head = 0;
+    size_t count = 0;
+
+    Sample current;
+    Clock::time_point sectionStart;
+    uint64_t allocationsAtStart = 0;
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <raylib.h>
+#include "Widget.h"
+
+// flat snapshot of the widget tree for pointer hit testing. widgets are
+// stored in pre-order (parents before children, siblings in draw order) and
+// bucketed into a uniform grid of their cached bounds, so a lookup only
+// tests the few widgets overlapping the cursor's cell.
+class HitTestIndex {
+public:
+    static constexpr int NO_HIT = -1;
+
+    void rebuild(const std::vector<Widget*>& roots) {
+        entries.clear();
+        for (Widget* root : roots) {
+            if (root) add(*root, NO_HIT);
+        }
+        buildGrid();
+    }
+
+    // topmost (deepest) widget containing p, or NO_HIT
+    int hitTest(Vector2 p) const {
+        if (columns == 0 || p.x < area.x || p.y < area.y) return NO_HIT;
+        const int cx = static_cast<int>((p.x - area.x) / CELL_SIZE);
+        const int cy = static_cast<int>((p.y - area.y) / CELL_SIZE);
+        if (cx >= columns || cy >= rows) return NO_HIT;
+
+        // later entries are drawn on top, so scan the cell back to front
+        const int cell = cy * columns + cx;
+        for (uint32_t i = cellStart[cell + 1]; i > cellStart[cell]; --i) {
+            const int e = static_cast<int>(cellEntries[i - 1]);
+            if (CheckCollisionPointRec(p, entries[e].bounds)) return e;
+        }
+        return NO_HIT;
+    }
+
+    Widget* getWidget(int entry) const { return entries[entry].widget; }
+    int getParent(int entry) const { return entries[entry].parent; }
+    size_t size() const { return entries.size(); }
+
+private:
+    static constexpr float CELL_SIZE = 32.0f;
+
+    struct Entry {
+        Widget* widget;
+        int parent;
+        Rectangle bounds;
+    };
+
+    void add(Widget& widget, int parent) {
+        const int self = static_cast<int>(entries.size());
+        entries.push_back({ &widget, parent, widget.getHitBounds() });
+        widget.forEachChild([this, self](Widget& child) { add(child, self); });
+    }
+
+    // cell range covered by r, clamped to the grid
+    void cellRange(const Rectangle& r, int& x0, int& y0, int& x1, int& y1) const {
+        x0 = std::max(0, static_cast<int>((r.x - area.x) / CELL_SIZE));
+        y0 = std::max(0, static_cast<int>((r.y - area.y) / CELL_SIZE));
+        x1 = std::min(columns - 1, static_cast<int>((r.x + r.width - area.x) / CELL_SIZE));
+        y1 = std::min(rows - 1, static_cast<int>((r.y + r.height - area.y) / CELL_SIZE));
+    }
+
+    static bool hasArea(const Rectangle& r) { return r.width > 0.0f && r.height > 0.0f; }
+
+    // compressed cell lists: cell c owns cellEntries[cellStart[c], cellStart[c + 1])
+    void buildGrid() {
+        columns = rows = 0;
+        cellStart.clear();
+        cellEntries.clear();
+
+        bool any = false;
+        float minX = 0, minY = 0, maxX = 0, maxY = 0;
+        for (const Entry& e : entries) {
+            if (!hasArea(e.bounds)) continue;
+            if (!any) {
+                minX = e.bounds.x; minY = e.bounds.y;
+                maxX = e.bounds.x + e.bounds.width; maxY = e.bounds.y + e.bounds.height;
+                any = true;
+            }
+            minX = std::min(minX, e.bounds.x);
+            minY = std::min(minY, e.bounds.y);
+            maxX = std::max(maxX, e.bounds.x + e.bounds.width);
+            maxY = std::max(maxY, e.bounds.y + e.bounds.height);
+        }
+        if (!any) return;
+
+        area = { minX, minY, maxX - minX, maxY - minY };
+        columns = static_cast<int>(std::floor(area.width / CELL_SIZE)) + 1;
+        rows = static_cast<int>(std::floor(area.height / CELL_SIZE)) + 1;
+        cellStart.assign(static_cast<size_t>(columns * rows) + 1, 0);
+
+        // count, prefix sum, then fill in entry order
+        forEachCell([this](int cell, int) { ++cellStart[cell + 1]; });
+        for (size_t c = 1; c < cellStart.size(); ++c) cellStart[c] += cellStart[c - 1];
+        cellEntries.resize(cellStart.back());
+        std::vector<uint32_t> cursor(cellStart.begin(), cellStart.end() - 1);
+        forEachCell([this, &cursor](int cell, int entry) { cellEntries[cursor[cell]++] = static_cast<uint16_t>(entry); });
+    }
+
+    template <typename Fn>
+    void forEachCell(Fn fn) const {
+        for (size_t e = 0; e < entries.size(); ++e) {
+            if (!hasArea(entries[e].bounds)) continue;
+            int x0, y0, x1, y1;
+            cellRange(entries[e].bounds, x0, y0, x1, y1);
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    fn(y * columns + x, static_cast<int>(e));
+                }
+            }
+        }
+    }
+
+    std::vector<Entry> entries;
+    Rectangle area{0, 0, 0, 0};
+    int columns = 0;
+    int rows = 0;
+    std::vector<uint32_t> cellStart;
+    std::vector<uint16_t> cellEntries;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include "../sim/world/ScenarioLimits.h"
+
+// per-frame memory accounting for the world pools and ui caches, with the
+// high-water mark of each since startup. sampled from UIRoot::update.
+class MemoryTracker {
+public:
+    struct Snapshot {
+        WorldMemory world;
+        size_t uiCaches = 0;
+
+        size_t total() const { return world.total() + uiCaches; }
+    };
+
+    void sample(const WorldMemory& world, size_t uiCaches) {
+        current.world = world;
+        current.uiCaches = uiCaches;
+
+        peak.world.contacts = std::max(peak.world.contacts, world.contacts);
+        peak.world.missiles = std::max(peak.world.missiles, world.missiles);
+        peak.world.trails = std::max(peak.world.trails, world.trails);
+        peak.world.explosions = std::max(peak.world.explosions, world.explosions);
+        peak.world.schooling = std::max(peak.world.schooling, world.schooling);
+        peak.world.detection = std::max(peak.world.detection, world.detection);
+        peak.world.tracks = std::max(peak.world.tracks, world.tracks);
+        peak.world.sweep = std::max(peak.world.sweep, world.sweep);
+        peak.world.behaviors = std::max(peak.world.behaviors, world.behaviors);
+        peak.world.currents = std::max(peak.world.currents, world.currents);
+        peak.uiCaches = std::max(peak.uiCaches, uiCaches);
+        peakTotal = std::max(peakTotal, current.total());
+    }
+
+    const Snapshot& getCurrent() const { return current; }
+    // per-field peaks; each may come from a different frame
+    const Snapshot& getPeak() const { return peak; }
+    // highest combined total seen in any single frame
+    size_t getPeakTotal() const { return peakTotal; }
+
+private:
+    Snapshot current;
+    Snapshot peak;
+    size_t peakTotal = 0;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <raylib.h>
+#include "HitTestIndex.h"
+#include "Widget.h"
+
+// routes mouse events through the hit-test index. events go to the widget
+// under the cursor and bubble to its ancestors until one handles them; the
+// widget that handles a press captures the pointer until release.
+class PointerDispatcher {
+public:
+    // call after construction and whenever layout changes
+    void rebuild(const std::vector<Widget*>& roots) {
+        index.rebuild(roots);
+        captured = nullptr;
+        hovered = nullptr;
+    }
+
+    // returns the widget that took the press, or nullptr
+    Widget* mouseDown(Vector2 pos) {
+        Widget* handler = bubble(index.hitTest(pos), [pos](Widget& w) { return w.onMouseDown(pos); });
+        captured = handler;
+        return handler;
+    }
+
+    void mouseUp(Vector2 pos) {
+        if (captured) {
+            Widget* target = captured;
+            captured = nullptr;
+            target->onMouseUp(pos);
+            return;
+        }
+        bubble(index.hitTest(pos), [pos](Widget& w) { return w.onMouseUp(pos); });
+    }
+
+    // only the captured widget sees moves during a drag; otherwise the widget
+    // under the cursor, plus the one it just left so it can drop hover state
+    void mouseMove(Vector2 pos) {
+        if (captured) {
+            captured->onMouseMove(pos);
+            return;
+        }
+        const int hit = index.hitTest(pos);
+        Widget* target = (hit != HitTestIndex::NO_HIT) ? index.getWidget(hit) : nullptr;
+        if (hovered && hovered != target) {
+            hovered->onMouseMove(pos);
+        }
+        hovered = target;
+        bubble(hit, [pos](Widget& w) { return w.onMouseMove(pos); });
+    }
+
+    Widget* getCaptured() const { return captured; }
+    const HitTestIndex& getIndex() const { return index; }
+
+private:
+    template <typename Handler>
+    Widget* bubble(int entry, Handler handle) {
+        for (; entry != HitTestIndex::NO_HIT; entry = index.getParent(entry)) {
+            Widget* widget = index.getWidget(entry);
+            if (handle(*widget)) return widget;
+        }
+        return nullptr;
+    }
+
+    HitTestIndex index;
+    Widget* captured = nullptr;
+    Widget* hovered = nullptr;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <raylib.h>
+#include <rlgl.h>
+
+// offscreen layer for ui content that rarely changes. the layer is rendered
+// into a texture once and blitted every frame until it is resized or invalidated.
+class RenderCache {
+public:
+    RenderCache() = default;
+    ~RenderCache() { release(); }
+
+    RenderCache(const RenderCache&) = delete;
+    RenderCache& operator=(const RenderCache&) = delete;
+
+    // renders the layer if needed, then blits it at bounds.
+    // drawLayer receives the layer rectangle in texture space (origin 0,0).
+    // returns false when no gpu context exists so the caller can draw directly.
+    template <typename DrawFn>
+    bool draw(const Rectangle& bounds, DrawFn drawLayer) {
+        if (!IsWindowReady()) return false;
+
+        const int width = static_cast<int>(bounds.width);
+        const int height = static_cast<int>(bounds.height);
+        if (width <= 0 || height <= 0) return false;
+
+        if (target.id == 0 || target.texture.width != width || target.texture.height != height) {
+            release();
+            target = LoadRenderTexture(width, height);
+            if (target.id == 0) return false;
+            dirty = true;
+        }
+
+        if (dirty) {
+            BeginTextureMode(target);
+            ClearBackground(BLANK);
+            // accumulate premultiplied colour but keep coverage alpha, so
+            // translucent layers composite the same as drawing them directly
+            rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                                      RL_FUNC_ADD, RL_FUNC_ADD);
+            BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+            drawLayer(Rectangle{0.0f, 0.0f, (float)width, (float)height});
+            EndBlendMode();
+            EndTextureMode();
+            // EndTextureMode falls back to the screen; resume an offscreen frame
+            if (frameTarget) BeginTextureMode(*frameTarget);
+            dirty = false;
+        }
+
+        // render textures are stored bottom-up, hence the negative source height
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        DrawTextureRec(target.texture, Rectangle{0.0f, 0.0f, (float)width, -(float)height},
+                       Vector2{bounds.x, bounds.y}, WHITE);
+        EndBlendMode();
+        return true;
+    }
+
+    // same as draw(), for layers that render at their on-screen position
+    // (for example child widgets holding absolute bounds)
+    template <typename DrawFn>
+    bool drawInPlace(const Rectangle& bounds, DrawFn drawLayer) {
+        return draw(bounds, [&](Rectangle) {
+            rlPushMatrix();
+            rlTranslatef(-bounds.x, -bounds.y, 0.0f);
+            drawLayer();
+            rlPopMatrix();
+        });
+    }
+
+    void invalidate() { dirty = true; }
+
+    // texture memory held by the layer (RGBA8)
+    size_t getByteSize() const {
+        return target.id != 0 ? static_cast<size_t>(target.texture.width) * target.texture.height * 4 : 0;
+    }
+
+    // render a whole frame offscreen (headless snapshots). raylib texture
+    // modes don't nest, so caches refreshed mid-frame re-enter this target.
+    static void beginFrameTarget(RenderTexture2D& frame) {
+        frameTarget = &frame;
+        BeginTextureMode(frame);
+    }
+    static void endFrameTarget() {
+        EndTextureMode();
+        frameTarget = nullptr;
+    }
+
+private:
+    void release() {
+        if (target.id != 0) {
+            UnloadRenderTexture(target);
+            target = RenderTexture2D{};
+        }
+    }
+
+    RenderTexture2D target{};
+    bool dirty = true;
+
+    static inline RenderTexture2D* frameTarget = nullptr;
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <raylib.h>
+
+// blend factor between the previous and current sim state, shared by the
+// views that draw moving objects. alpha 1 draws the latest state as is.
+class RenderInterpolation {
+public:
+    void setAlpha(float value) { alpha = value; }
+    float getAlpha() const { return alpha; }
+
+    Vector2 at(Vector2 previous, Vector2 current) const {
+        return { previous.x + (current.x - previous.x) * alpha,
+                 previous.y + (current.y - previous.y) * alpha };
+    }
+
+private:
+    float alpha = 1.0f;
+};
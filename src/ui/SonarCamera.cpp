@@ -0,0 +1,133 @@
+#include "SonarCamera.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SONAR_CAMERA_SSE2 1
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define SONAR_CAMERA_WASM_SIMD 1
+#endif
+
+// the batch kernels read Vector2 arrays as interleaved x,y floats
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be two packed floats");
+
+// two interleaved points per 128-bit vector
+#if defined(SONAR_CAMERA_SSE2)
+using Lanes = __m128;
+static inline Lanes lanesSet(float x, float y) { return _mm_setr_ps(x, y, x, y); }
+static inline Lanes lanesLoad(const float* p) { return _mm_loadu_ps(p); }
+static inline void lanesStore(float* p, Lanes v) { _mm_storeu_ps(p, v); }
+static inline Lanes lanesMulAdd(Lanes v, Lanes m, Lanes a) { return _mm_add_ps(_mm_mul_ps(v, m), a); }
+// bit per lane, set when lo <= v <= hi
+static inline int lanesInside(Lanes v, Lanes lo, Lanes hi) {
+    return _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(v, lo), _mm_cmple_ps(v, hi)));
+}
+#elif defined(SONAR_CAMERA_WASM_SIMD)
+using Lanes = v128_t;
+static inline Lanes lanesSet(float x, float y) { return wasm_f32x4_make(x, y, x, y); }
+static inline Lanes lanesLoad(const float* p) { return wasm_v128_load(p); }
+static inline void lanesStore(float* p, Lanes v) { wasm_v128_store(p, v); }
+static inline Lanes lanesMulAdd(Lanes v, Lanes m, Lanes a) { return wasm_f32x4_add(wasm_f32x4_mul(v, m), a); }
+static inline int lanesInside(Lanes v, Lanes lo, Lanes hi) {
+    return (int)wasm_i32x4_bitmask(wasm_v128_and(wasm_f32x4_ge(v, lo), wasm_f32x4_le(v, hi)));
+}
+#endif
+
+void SonarCamera::zoomAt(Vector2 screenPos, float factor) {
+    const Vector2 anchor = screenToWorld(screenPos);
+    zoom = std::clamp(zoom * factor, 1.0f, MAX_ZOOM);
+    updateTransform();
+
+    // shift so the anchor lands back under the cursor
+    const Vector2 moved = worldToScreen(anchor);
+    target.x += (moved.x - screenPos.x) / scale.x;
+    target.y += (moved.y - screenPos.y) / scale.y;
+    updateTransform();
+}
+
+void SonarCamera::panBy(Vector2 screenDelta) {
+    target.x -= screenDelta.x / scale.x;
+    target.y -= screenDelta.y / scale.y;
+    updateTransform();
+}
+
+void SonarCamera::reset() {
+    zoom = 1.0f;
+    target = {0, 0};
+    updateTransform();
+}
+
+// keeps the visible area inside the world
+void SonarCamera::clampTarget() {
+    const float limitX = WorldBounds::HALF_WIDTH - WorldBounds::HALF_WIDTH / zoom;
+    const float limitY = WorldBounds::HALF_HEIGHT - WorldBounds::HALF_HEIGHT / zoom;
+    target.x = std::clamp(target.x, -limitX, limitX);
+    target.y = std::clamp(target.y, -limitY, limitY);
+}
+
+void SonarCamera::updateTransform() {
+    clampTarget();
+    scale = { viewport.width / WorldBounds::WIDTH * zoom, viewport.height / WorldBounds::HEIGHT * zoom };
+    offset = { viewport.x + viewport.width * 0.5f - target.x * scale.x,
+               viewport.y + viewport.height * 0.5f - target.y * scale.y };
+    ++revision;
+}
+
+void SonarCamera::transform(const Vector2* world, size_t count, Vector2* outScreen) const {
+    size_t i = 0;
+#if defined(SONAR_CAMERA_SSE2) || defined(SONAR_CAMERA_WASM_SIMD)
+    const float* in = reinterpret_cast<const float*>(world);
+    float* out = reinterpret_cast<float*>(outScreen);
+    const Lanes m = lanesSet(scale.x, scale.y);
+    const Lanes a = lanesSet(offset.x, offset.y);
+    for (; i + 2 <= count; i += 2) {
+        lanesStore(out + 2 * i, lanesMulAdd(lanesLoad(in + 2 * i), m, a));
+    }
+#endif
+    for (; i < count; ++i) {
+        outScreen[i] = worldToScreen(world[i]);
+    }
+}
+
+size_t SonarCamera::transformVisible(const Vector2* world, size_t count, float margin,
+                                     Vector2* outScreen, uint32_t* outIndex) const {
+    const float minX = viewport.x - margin;
+    const float minY = viewport.y - margin;
+    const float maxX = viewport.x + viewport.width + margin;
+    const float maxY = viewport.y + viewport.height + margin;
+
+    size_t kept = 0;
+    auto keep = [&](float x, float y, size_t index) {
+        outScreen[kept] = { x, y };
+        if (outIndex) outIndex[kept] = static_cast<uint32_t>(index);
+        ++kept;
+    };
+
+    size_t i = 0;
+#if defined(SONAR_CAMERA_SSE2) || defined(SONAR_CAMERA_WASM_SIMD)
+    const float* in = reinterpret_cast<const float*>(world);
+    const Lanes m = lanesSet(scale.x, scale.y);
+    const Lanes a = lanesSet(offset.x, offset.y);
+    const Lanes lo = lanesSet(minX, minY);
+    const Lanes hi = lanesSet(maxX, maxY);
+    alignas(16) float screen[4];
+    for (; i + 2 <= count; i += 2) {
+        const Lanes s = lanesMulAdd(lanesLoad(in + 2 * i), m, a);
+        const int inside = lanesInside(s, lo, hi);
+        if (inside == 0) continue;
+
+        // a point is visible when both its x and y lanes pass
+        lanesStore(screen, s);
+        if ((inside & 0x3) == 0x3) keep(screen[0], screen[1], i);
+        if ((inside & 0xC) == 0xC) keep(screen[2], screen[3], i + 1);
+    }
+#endif
+    for (; i < count; ++i) {
+        const Vector2 s = worldToScreen(world[i]);
+        if (s.x >= minX && s.x <= maxX && s.y >= minY && s.y <= maxY) {
+            keep(s.x, s.y, i);
+        }
+    }
+    return kept;
+}
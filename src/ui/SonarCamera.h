@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <raylib.h>
+#include "../sim/world/WorldBounds.h"
+
+// maps sonar world coordinates onto the sonar viewport, with zoom and pan.
+// shared by every view drawing on the sonar so they agree on one transform.
+class SonarCamera {
+public:
+    static constexpr float MAX_ZOOM = 8.0f;
+
+    void setViewport(const Rectangle& r) {
+        viewport = r;
+        updateTransform();
+    }
+    const Rectangle& getViewport() const { return viewport; }
+
+    // zoom by factor, keeping the world point under screenPos fixed
+    void zoomAt(Vector2 screenPos, float factor);
+    void panBy(Vector2 screenDelta);
+    void reset();
+
+    float getZoom() const { return zoom; }
+    Vector2 getTarget() const { return target; }
+
+    // pixels per world unit on each axis
+    Vector2 getScale() const { return scale; }
+
+    Vector2 worldToScreen(Vector2 world) const {
+        return { world.x * scale.x + offset.x, world.y * scale.y + offset.y };
+    }
+    Vector2 screenToWorld(Vector2 screen) const {
+        return { (screen.x - offset.x) / scale.x, (screen.y - offset.y) / scale.y };
+    }
+
+    // bumped on every change, so cached layers know when to re-render
+    uint32_t getRevision() const { return revision; }
+
+    // batch transform of count points
+    void transform(const Vector2* world, size_t count, Vector2* outScreen) const;
+
+    // batch transform that keeps only points within margin pixels of the
+    // viewport. visible points are packed to the front of outScreen (and
+    // their source indices to outIndex, if given); returns how many.
+    size_t transformVisible(const Vector2* world, size_t count, float margin,
+                            Vector2* outScreen, uint32_t* outIndex) const;
+
+private:
+    void clampTarget();
+    void updateTransform();
+
+    Rectangle viewport{0, 0, WorldBounds::WIDTH, WorldBounds::HEIGHT};
+    Vector2 target{0, 0};   // world point at the viewport centre
+    float zoom = 1.0f;
+
+    // cached affine transform: screen = world * scale + offset
+    Vector2 scale{1, 1};
+    Vector2 offset{0, 0};
+    uint32_t revision = 0;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+
+#ifdef PLATFORM_WEB
+    #include <emscripten/emscripten.h>
+#endif
+
+// records how long startup takes up to the first presented frame. on the web
+// times are from navigation start, so they include download and compile of
+// the bundle; on desktop they start at static initialization.
+class StartupTimer {
+public:
+    enum Mark { MAIN, WINDOW, UI_BUILT, FIRST_FRAME, MARK_COUNT };
+
+    StartupTimer() : origin(std::chrono::steady_clock::now()) {}
+
+    // only the first time each mark is reached counts
+    void mark(Mark m) {
+        if (times[m] < 0.0) times[m] = now();
+    }
+
+    double getMs(Mark m) const { return times[m]; }
+    bool isComplete() const { return times[FIRST_FRAME] >= 0.0; }
+
+    void report() const {
+        static const char* names[MARK_COUNT] = { "main", "InitWindow", "ui built", "first frame" };
+        std::cout << "[StartupTimer]";
+        for (int i = 0; i < MARK_COUNT; ++i) {
+            std::cout << " " << names[i] << " " << times[i] << " ms" << (i + 1 < MARK_COUNT ? "," : "");
+        }
+        std::cout << std::endl;
+    }
+
+private:
+    double now() const {
+#ifdef PLATFORM_WEB
+        return emscripten_get_now();
+#else
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - origin).count();
+#endif
+    }
+
+    std::chrono::steady_clock::time_point origin;
+    double times[MARK_COUNT] = { -1.0, -1.0, -1.0, -1.0 };
+};
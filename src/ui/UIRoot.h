@@ -1,19 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <raylib.h>
-#include "../sim/SimulationEngine.h"
-#include "../sim/systems/SonarSystem.h"
-#include "../sim/systems/PowerSystem.h"
-#include "../sim/systems/DepthSystem.h"
-#include "../sim/systems/TargetingSystem.h"
-#include "../sim/systems/LaunchSequenceHandler/LaunchSequenceHandler.h"
-#include "../sim/systems/EnvironmentSystem.h"
-#include "../sim/world/ContactManager.h"
-#include "../sim/world/CrosshairManager.h"
-#include "../sim/world/MissileManager.h"
-#include "../sim/world/MissionInstructionManager.h"
+#include "../sim/SimulationSnapshot.h"
+#include "../sim/SimulationCommands.h"
+#include "../sim/SimulationWorld.h"
 #include "ui/views/SonarView.h"
 #include "ui/views/MissileView.h"
 #include "ui/views/StatusPanel.h"
@@ -23,71 +16,115 @@
 #include "ui/views/PowerView.h"
 #include "ui/views/DepthView.h"
 #include "ui/views/GuidanceView.h"
+#include "ui/views/ProfilerOverlay.h"
+#include "ui/views/WaterfallView.h"
 #include "ui/widgets/PulsatingBorder.h"
+#include "ui/FrameProfiler.h"
+#include "ui/MemoryTracker.h"
+#include "ui/SonarCamera.h"
+#include "ui/RenderInterpolation.h"
+#include "ui/PointerDispatcher.h"
+#include <cmath>
 
+// draws from a snapshot of the sim and sends input back as commands; it
+// never touches the live world, which may be stepping on another thread
 class UIRoot {
 public:
-    UIRoot(SimulationEngine& engine,
-           SonarSystem* sonar,
-           PowerSystem* power,
-           DepthSystem* depth,
-           TargetingSystem* targeting,
-           LaunchSequenceHandler* launchSequence,
-           EnvironmentSystem* /*environment*/,
-           ContactManager* contacts,
-           CrosshairManager* crosshair,
-           MissileManager* missiles)
-        : engine(engine), sonar(sonar), power(power), depth(depth), targeting(targeting), launchSequence(launchSequence), contacts(contacts), crosshairManager(crosshair), missileManager(missiles) {
+    UIRoot(const SimulationSnapshot& snapshot, SimulationCommandQueue& commands)
+        : snapshot(snapshot), commands(commands) {
         
-        // mission instructions drive the ui flow
-        missionManager = std::make_unique<MissionInstructionManager>(engine, launchSequence);
-
-        sonarView = std::make_unique<SonarView>(*contacts);
-        statusPanel = std::make_unique<StatusPanel>(engine);
-        powerView = std::make_unique<PowerView>(engine, *power);
-        depthView = std::make_unique<DepthView>(engine, *depth);
-        controlPanel = std::make_unique<ControlPanel>(engine, launchSequence);
-        contactView = std::make_unique<ContactView>(*contacts);
-        crosshairView = std::make_unique<CrosshairView>(*crosshairManager);
-        missileView = std::make_unique<MissileView>(*missiles);
-        guidanceView = std::make_unique<GuidanceView>(*missionManager);
+        sonarView = std::make_unique<SonarView>(sonarCamera);
+        statusPanel = std::make_unique<StatusPanel>(snapshot);
+        powerView = std::make_unique<PowerView>(snapshot, commands);
+        depthView = std::make_unique<DepthView>(snapshot, commands);
+        controlPanel = std::make_unique<ControlPanel>(snapshot, commands);
+        contactView = std::make_unique<ContactView>(snapshot, sonarCamera, interpolation);
+        crosshairView = std::make_unique<CrosshairView>(snapshot, sonarCamera, interpolation);
+        guidanceView = std::make_unique<GuidanceView>(snapshot);
+        waterfallView = std::make_unique<WaterfallView>(snapshot);
         
         uiPulsatingBorder = PulsatingBorder(YELLOW, 4.0f, 0.2f, 1.0f, 3);
 
         guidanceView->setBounds({20, 60, 600, 70});
-        sonarView->setBounds({20, 140, 600, 560});
+        sonarView->setBounds({20, 140, 600, 420});
+        sonarCamera.setViewport(sonarView->getBounds());
+        waterfallView->setBounds({20, 570, 600, 130});
         statusPanel->setBounds({640, 20, 620, 110});
         powerView->setBounds({640, 140, 620, 100});
         depthView->setBounds({640, 250, 620, 100});
         controlPanel->setBounds({640, 360, 620, 340});
+        
+        // layout is fixed from here on, so the hit-test index is built once
+        pointer.rebuild({ powerView.get(), depthView.get(), sonarView.get(), controlPanel.get() });
     }
 
     void update(float dt) {
         guidanceView->update(dt);
+        statusPanel->update(dt);
         powerView->update(dt);
         depthView->update(dt);
         controlPanel->update(dt);
-        crosshairManager->update(dt);
+        waterfallView->update(dt);
         
         uiPulsatingBorder.update(dt);
 
+        // nothing to draw before the first launch, so the missile layer is
+        // built on demand to keep it off the startup path
+        if (!missileView && (!snapshot.missiles.empty() || !snapshot.explosions.empty())) {
+            missileView = std::make_unique<MissileView>(snapshot, sonarCamera, interpolation);
+        }
+
+        // pause/resume the simulation
+        if (IsKeyPressed(KEY_P)) {
+            const bool paused = !snapshot.paused;
+            commands.post([paused](SimulationWorld& world) { world.getEngine().setPaused(paused); });
+        }
+
+        // sonar mode: passive pings or the rotating sweep
+        if (IsKeyPressed(KEY_M)) {
+            const SonarMode mode = snapshot.sonarMode == SonarMode::Sweep ? SonarMode::Passive : SonarMode::Sweep;
+            commands.post([mode](SimulationWorld& world) { world.getSonarSystem().setMode(mode); });
+        }
+
+        // time acceleration: [ and ] step through the speed presets
+        if (IsKeyPressed(KEY_RIGHT_BRACKET) && timeScaleIndex + 1 < timeScaleCount) {
+            ++timeScaleIndex;
+        }
+        if (IsKeyPressed(KEY_LEFT_BRACKET) && timeScaleIndex > 0) {
+            --timeScaleIndex;
+        }
+
+        // profiler overlay, built on first use
+        if (IsKeyPressed(KEY_F3)) {
+            setProfilerVisible(!profilerVisible);
+        }
+
         // track mouse
         Vector2 mouse = GetMousePosition();
-        crosshairManager->updateMousePosition(mouse, sonarView->getBounds());
+        const Rectangle& sonarBounds = sonarView->getBounds();
+        mouseOverSonar = mouse.x >= sonarBounds.x && mouse.x <= sonarBounds.x + sonarBounds.width &&
+                         mouse.y >= sonarBounds.y && mouse.y <= sonarBounds.y + sonarBounds.height;
+        crosshairView->setMouse(mouse, mouseOverSonar);
+        updateSonarCamera(mouse);
 
-        // basic click handling
+        // widget input goes through the hit-test index
         if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            if (powerView->onMouseDown(mouse)) {} else if (depthView->onMouseDown(mouse)) {} else if (sonarView->onMouseDown(mouse)) {} else if (controlPanel->onMouseDown(mouse)) {}
+            pointer.mouseDown(mouse);
             
-            crosshairManager->handleMouseClick(mouse, sonarView->getBounds());
+            // click on target = start tracking
+            if (mouseOverSonar) {
+                const Vector2 target = sonarCamera.screenToWorld(mouse);
+                commands.post([target](SimulationWorld& world) { world.getCrosshairManager().selectContactAt(target); });
+            }
         }
         if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
-            if (powerView->onMouseUp(mouse)) {} else if (depthView->onMouseUp(mouse)) {} else if (sonarView->onMouseUp(mouse)) {} else if (controlPanel->onMouseUp(mouse)) {}
+            pointer.mouseUp(mouse);
         }
         
-        // mouse dragging support
-        if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
-            if (powerView->onMouseMove(mouse)) {} else if (depthView->onMouseMove(mouse)) {} else if (sonarView->onMouseMove(mouse)) {} else if (controlPanel->onMouseMove(mouse)) {}
+        // hover and dragging, only when the mouse actually moved
+        Vector2 mouseDelta = GetMouseDelta();
+        if (mouseDelta.x != 0.0f || mouseDelta.y != 0.0f) {
+            pointer.mouseMove(mouse);
         }
     }
 
@@ -97,13 +134,13 @@ public:
         statusPanel->draw();
         
         // power controls
-        if (missionManager->shouldPulsate(PulsateTarget::POWER_SWITCH)) {
+        if (shouldPulsate(PulsateTarget::POWER_SWITCH)) {
             drawPulsatingBorder(powerView->getBounds());
         }
         powerView->draw();
         
         // depth controls
-        if (missionManager->shouldPulsate(PulsateTarget::DEPTH_THROTTLE)) {
+        if (shouldPulsate(PulsateTarget::DEPTH_THROTTLE)) {
             drawPulsatingBorder(depthView->getBounds());
         }
         depthView->draw();
@@ -112,31 +149,72 @@ public:
         drawControlPanelWithPulsation();
         
         // sonar display
-        if (missionManager->shouldPulsate(PulsateTarget::SONAR_BOX)) {
+        if (shouldPulsate(PulsateTarget::SONAR_BOX)) {
             drawPulsatingBorder(sonarView->getBounds());
         }
         sonarView->draw();
         
-        contactView->drawContactsOnSonar(sonarView->getBounds());
+        // moving layers are clipped to the display when zoomed or panned
+        const Rectangle& sonarBounds = sonarView->getBounds();
+        BeginScissorMode((int)sonarBounds.x, (int)sonarBounds.y, (int)sonarBounds.width, (int)sonarBounds.height);
+        contactView->drawContactsOnSonar();
         
         // missile display
-        missileView->drawMissilesOnSonar(sonarView->getBounds());
+        if (missileView) {
+            missileView->drawMissilesOnSonar();
+        }
         
         // crosshair
-        crosshairView->drawOnSonar(sonarView->getBounds());
+        crosshairView->drawOnSonar();
+        EndScissorMode();
         
+        waterfallView->draw();
+
+        if (snapshot.paused) {
+            DrawText("PAUSED - press P to resume", (int)sonarBounds.x + 10, (int)sonarBounds.y + 10, 18, YELLOW);
+        } else if (getTimeScale() > 1.0f) {
+            DrawText(TextFormat("x%.0f  achieved x%.1f  dropped %llu", getTimeScale(), achievedTimeScale,
+                                (unsigned long long)droppedSteps),
+                     (int)sonarBounds.x + 10, (int)sonarBounds.y + 10, 18, ORANGE);
+        }
+
+        if (profilerVisible) {
+            profilerOverlay->draw();
+        }
+
+    }
+
+    // blend factor between the last two sim steps for moving sonar objects
+    void setInterpolationAlpha(float alpha) { interpolation.setAlpha(alpha); }
+
+    // requested sim speed, and what the sim clock actually managed
+    float getTimeScale() const { return timeScales[timeScaleIndex]; }
+    void setTimeScaleStats(float achieved, uint64_t dropped) {
+        achievedTimeScale = achieved;
+        droppedSteps = dropped;
+    }
+
+    FrameProfiler& getFrameProfiler() { return frameProfiler; }
+    MemoryTracker& getMemoryTracker() { return memoryTracker; }
+
+    // texture memory held by the offscreen ui layers
+    size_t getCacheBytes() const {
+        return sonarView->getCacheBytes() + statusPanel->getCacheBytes() + waterfallView->getCacheBytes();
+    }
+    bool isProfilerVisible() const { return profilerVisible; }
 
+    void setProfilerVisible(bool visible) {
+        if (visible && !profilerOverlay) {
+            profilerOverlay = std::make_unique<ProfilerOverlay>(frameProfiler, memoryTracker, snapshot);
+            profilerOverlay->setBounds({20, 440, 620, 220});
+        }
+        profilerVisible = visible;
+        commands.post([visible](SimulationWorld& world) { world.getEngine().setProfiling(visible); });
     }
 
 private:
-    SimulationEngine& engine;
-    MissileManager* missileManager;
-    SonarSystem* sonar;
-    PowerSystem* power;
-    DepthSystem* depth;
-    TargetingSystem* targeting;
-    LaunchSequenceHandler* launchSequence;
-    ContactManager* contacts;
+    const SimulationSnapshot& snapshot;
+    SimulationCommandQueue& commands;
 
     std::unique_ptr<SonarView> sonarView;
     std::unique_ptr<StatusPanel> statusPanel;
@@ -144,14 +222,58 @@ private:
     std::unique_ptr<DepthView> depthView;
     std::unique_ptr<ControlPanel> controlPanel;
     std::unique_ptr<ContactView> contactView;
-    CrosshairManager* crosshairManager;
     std::unique_ptr<CrosshairView> crosshairView;
     std::unique_ptr<MissileView> missileView;
     std::unique_ptr<GuidanceView> guidanceView;
-    std::unique_ptr<MissionInstructionManager> missionManager;
+    std::unique_ptr<WaterfallView> waterfallView;
+    std::unique_ptr<ProfilerOverlay> profilerOverlay;
+    SonarCamera sonarCamera;
+    RenderInterpolation interpolation;
+    PointerDispatcher pointer;
+    bool panningSonar = false;
+    bool mouseOverSonar = false;
+    FrameProfiler frameProfiler;
+    MemoryTracker memoryTracker;
+    bool profilerVisible = false;
+
+    static constexpr float timeScales[] = { 1.0f, 2.0f, 5.0f, 10.0f, 20.0f, 50.0f, 100.0f };
+    static constexpr int timeScaleCount = sizeof(timeScales) / sizeof(timeScales[0]);
+    int timeScaleIndex = 0;
+    float achievedTimeScale = 1.0f;
+    uint64_t droppedSteps = 0;
     
     PulsatingBorder uiPulsatingBorder;
     
+    // wheel zooms about the cursor, right-drag pans, Home resets
+    void updateSonarCamera(Vector2 mouse) {
+        float wheel = GetMouseWheelMove();
+        if (wheel != 0.0f && mouseOverSonar) {
+            sonarCamera.zoomAt(mouse, powf(1.25f, wheel));
+        }
+        
+        if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT) && mouseOverSonar) {
+            panningSonar = true;
+        }
+        if (!IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) {
+            panningSonar = false;
+        }
+        if (panningSonar) {
+            Vector2 delta = GetMouseDelta();
+            if (delta.x != 0.0f || delta.y != 0.0f) {
+                sonarCamera.panBy(delta);
+            }
+        }
+        
+        if (IsKeyPressed(KEY_HOME)) {
+            sonarCamera.reset();
+        }
+    }
+
+    // the mission step highlights one control at a time
+    bool shouldPulsate(PulsateTarget target) const {
+        return snapshot.instruction.pulsateTarget == target && !snapshot.instruction.isComplete;
+    }
+
     // draw pulsating border effect
     void drawPulsatingBorder(const Rectangle& bounds) const {
         uiPulsatingBorder.drawBorder(bounds);
@@ -161,105 +283,21 @@ private:
         // base control panel
         controlPanel->draw();
         
-        // pulsate stages of mission flow
-        if (missionManager->shouldPulsate(PulsateTarget::AUTHORIZE_BUTTON)) {
-            Rectangle controlBounds = controlPanel->getBounds();
-            float margin = 15;
-            float leftWidth = controlBounds.width * 0.35f;
-            float buttonHeight = 35;
-            float buttonWidth = leftWidth - 2 * margin;
-            
-            Rectangle leftPanelArea;
-            leftPanelArea.x = controlBounds.x + margin;
-            leftPanelArea.y = controlBounds.y + margin;
-            leftPanelArea.width = leftWidth;
-            leftPanelArea.height = controlBounds.height - 2 * margin;
-            
-            Rectangle buttonArea;
-            buttonArea.x = leftPanelArea.x + margin;
-            buttonArea.y = leftPanelArea.y + margin;
-            
-            // auth button location
-            float buttonY = buttonArea.y + 80;
-            Rectangle authBounds = {buttonArea.x, buttonY, buttonWidth, buttonHeight};
-            drawPulsatingBorder(authBounds);
+        // pulsate stages of mission flow, using the panel's cached layout
+        if (shouldPulsate(PulsateTarget::AUTHORIZE_BUTTON)) {
+            drawPulsatingBorder(controlPanel->getAuthorizeButtonBounds());
         }
         
-        if (missionManager->shouldPulsate(PulsateTarget::ARM_BUTTON)) {
-            // arm button location
-            Rectangle controlBounds = controlPanel->getBounds();
-            float margin = 15;
-            float leftWidth = controlBounds.width * 0.35f;
-            float buttonHeight = 35;
-            float buttonWidth = leftWidth - 2 * margin;
-            
-            Rectangle leftPanelArea;
-            leftPanelArea.x = controlBounds.x + margin;
-            leftPanelArea.y = controlBounds.y + margin;
-            leftPanelArea.width = leftWidth;
-            leftPanelArea.height = controlBounds.height - 2 * margin;
-            
-            Rectangle buttonArea;
-            buttonArea.x = leftPanelArea.x + margin;
-            buttonArea.y = leftPanelArea.y + margin;
-            
-            float buttonY = buttonArea.y + 80; 
-            buttonY += buttonHeight + margin;
-            Rectangle armBounds = {buttonArea.x, buttonY, buttonWidth, buttonHeight};
-            drawPulsatingBorder(armBounds);
+        if (shouldPulsate(PulsateTarget::ARM_BUTTON)) {
+            drawPulsatingBorder(controlPanel->getArmButtonBounds());
         }
         
-        if (missionManager->shouldPulsate(PulsateTarget::LAUNCH_BUTTON)) {
-            // launch button location
-            Rectangle controlBounds = controlPanel->getBounds();
-            float margin = 15;
-            float leftWidth = controlBounds.width * 0.35f;
-            float buttonHeight = 35;
-            float buttonWidth = leftWidth - 2 * margin;
-            
-            Rectangle leftPanelArea;
-            leftPanelArea.x = controlBounds.x + margin;
-            leftPanelArea.y = controlBounds.y + margin;
-            leftPanelArea.width = leftWidth;
-            leftPanelArea.height = controlBounds.height - 2 * margin;
-            
-            Rectangle buttonArea;
-            buttonArea.x = leftPanelArea.x + margin;
-            buttonArea.y = leftPanelArea.y + margin;
-            
-            // final button location
-            float buttonY = buttonArea.y + 80;
-            buttonY += buttonHeight + margin;
-            buttonY += buttonHeight + margin;
-            Rectangle launchBounds = {buttonArea.x, buttonY, buttonWidth, buttonHeight};
-            drawPulsatingBorder(launchBounds);
+        if (shouldPulsate(PulsateTarget::LAUNCH_BUTTON)) {
+            drawPulsatingBorder(controlPanel->getLaunchButtonBounds());
         }
         
-        if (missionManager->shouldPulsate(PulsateTarget::KEYPAD_AREA)) {
-            Rectangle controlBounds = controlPanel->getBounds();
-            float margin = 15;
-            float leftWidth = controlBounds.width * 0.35f;
-            float rightWidth = controlBounds.width * 0.35f;
-            float centerGap = controlBounds.width * 0.20f;
-            
-            float rightPanelX = controlBounds.x + leftWidth + centerGap + margin;
-            float rightPanelY = controlBounds.y + margin;
-        
-            float authAreaHeight = 100;
-            
-            // keypad positioning
-            float keypadY = rightPanelY + authAreaHeight + margin - 20;
-            float keypadWidth = 120;
-            float keypadHeight = 160;
-            float keypadX = rightPanelX + (rightWidth - keypadWidth) / 2;
-            
-            Rectangle keypadBounds = {
-                keypadX - 15,
-                keypadY - 25,
-                keypadWidth + 50,
-                keypadHeight + 60
-            };
-            drawPulsatingBorder(keypadBounds);
+        if (shouldPulsate(PulsateTarget::KEYPAD_AREA)) {
+            drawPulsatingBorder(controlPanel->getKeypadHighlightBounds());
         }
     }
 
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <raylib.h>
+
+// bearing-time history for the waterfall display, kept as a ring of RGBA
+// rows the size of the texture it feeds. each ping composes one row and
+// moves the head up by one, so reading rows from the head downwards (with
+// wrap) runs newest to oldest and a single wrapped texture read shows the
+// whole history. nothing here touches the gpu.
+class WaterfallHistory {
+public:
+    WaterfallHistory(int bearingBins, int rows)
+        : width(bearingBins), rows(rows), intensity(bearingBins), row(bearingBins) {}
+
+    int getWidth() const { return width; }
+    int getRows() const { return rows; }
+
+    // texture row holding the newest ping
+    int getHead() const { return head; }
+    // rows written so far, up to getRows()
+    int getFilledRows() const { return filled; }
+
+    // clears the pending row to dim background noise; seed varies it per ping
+    void beginRow(uint32_t seed) {
+        for (int i = 0; i < width; ++i) {
+            uint32_t h = (static_cast<uint32_t>(i) * 0x9E3779B1u) ^ (seed * 0x85EBCA77u);
+            h ^= h >> 15;
+            h *= 0x2C1B3C6Du;
+            h ^= h >> 12;
+            intensity[i] = static_cast<uint8_t>(h & 0x1F);
+        }
+    }
+
+    // marks a detection at bearingRad (clockwise from screen up) with
+    // strength 0..1, spread over neighbouring bins
+    void addDetection(float bearingRad, float strength) {
+        const float turns = bearingRad * (1.0f / TWO_PI);
+        const int centre = static_cast<int>((turns - std::floor(turns)) * static_cast<float>(width));
+        const float peak = 255.0f * std::min(std::max(strength, 0.0f), 1.0f);
+        for (int d = -SPREAD; d <= SPREAD; ++d) {
+            const int bin = ((centre + d) % width + width) % width;
+            const float falloff = 1.0f - static_cast<float>(std::abs(d)) / static_cast<float>(SPREAD + 1);
+            const uint8_t value = static_cast<uint8_t>(peak * falloff);
+            intensity[bin] = std::max(intensity[bin], value);
+        }
+    }
+
+    // colours the pending row and makes it the newest; returns its row index
+    int commitRow() {
+        for (int i = 0; i < width; ++i) {
+            const int v = intensity[i];
+            row[i] = Color{ static_cast<unsigned char>(v * v / 255 / 2),
+                            static_cast<unsigned char>(std::min(255, 24 + v)),
+                            static_cast<unsigned char>(48 + v / 3), 255 };
+        }
+        head = (head + rows - 1) % rows;
+        filled = std::min(filled + 1, rows);
+        return head;
+    }
+
+    // the row last committed, ready for upload
+    const Color* getRow() const { return row.data(); }
+
+    // bearing of a world offset from own ship, clockwise from screen up, 0..2pi
+    static float bearingOf(Vector2 offset) {
+        float b = std::atan2(offset.x, -offset.y);
+        return b < 0.0f ? b + TWO_PI : b;
+    }
+
+private:
+    static constexpr int SPREAD = 2;
+    static constexpr float TWO_PI = 6.28318531f;
+
+    int width;
+    int rows;
+    int head = 0;
+    int filled = 0;
+    std::vector<uint8_t> intensity;
+    std::vector<Color> row;
+};
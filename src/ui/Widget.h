@@ -1,6 +1,7 @@
 #pragma once
 
 #include <raylib.h>
+#include <functional>
 #include <vector>
 
 class Widget {
@@ -12,12 +13,30 @@ public:
     virtual bool onMouseUp(Vector2 /*pos*/) { return false; }
     virtual bool onMouseMove(Vector2 /*pos*/) { return false; }
 
-    void setBounds(const Rectangle& r) { bounds = r; }
+    // visits direct children in draw order; containers override this so
+    // input dispatch can index the whole tree
+    virtual void forEachChild(const std::function<void(Widget&)>& /*visit*/) {}
+
+    void setBounds(const Rectangle& r) {
+        if (r.x != bounds.x || r.y != bounds.y || r.width != bounds.width || r.height != bounds.height) {
+            bounds = r;
+            markDirty();
+        }
+    }
     const Rectangle& getBounds() const { return bounds; }
+    // area that receives pointer input; widgets drawing past their bounds widen it
+    virtual Rectangle getHitBounds() const { return bounds; }
     bool contains(Vector2 p) const { return CheckCollisionPointRec(p, bounds); }
 
+    // retained-mode bookkeeping: set when the widget's visible state changes,
+    // cleared by whoever redraws it
+    void markDirty() { dirty = true; }
+    void clearDirty() { dirty = false; }
+    bool isDirty() const { return dirty; }
+
 protected:
     Rectangle bounds{0,0,0,0};
+    bool dirty = true;
 };
 
 
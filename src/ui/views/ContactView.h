@@ -1,22 +1,61 @@
 #pragma once
 
 #include "../Widget.h"
-#include "../../sim/world/ContactManager.h"
+#include "../SonarCamera.h"
+#include "../RenderInterpolation.h"
+#include "../../sim/SimulationSnapshot.h"
+#include <cmath>
+#include <vector>
+#include <rlgl.h>
 
 class ContactView : public Widget {
 public:
-    explicit ContactView(ContactManager& contacts) : contacts(contacts) {}
+    ContactView(const SimulationSnapshot& snapshot, const SonarCamera& camera, const RenderInterpolation& interpolation)
+        : snapshot(snapshot), camera(camera), interpolation(interpolation) {}
 
 //    void draw() const override {
  //   }
 
-    // draws contact dots on sonar
-    void drawContactsOnSonar(const Rectangle& sonarBounds) const {
-        for (const auto& contact : contacts.getActiveContacts()) {
-            Vector2 screen = worldToScreen(contact.position, sonarBounds);
-            Color contactColor = getContactTypeColor(contact.type);
-            DrawCircle((int)screen.x, (int)screen.y, 4, contactColor);
+    // draws the sonar tracks as a single triangle batch. with a sweep the
+    // beam is drawn and tracks fade with the time since it passed them
+    void drawContactsOnSonar() const {
+        const bool sweep = snapshot.sonarMode == SonarMode::Sweep;
+        if (sweep) drawBeam();
+
+        const size_t total = snapshot.trackPositions.size();
+        if (total == 0) return;
+
+        // gather track estimates, interpolated between sim steps, then
+        // transform and cull in one pass
+        worldPositions.resize(total);
+        screenPositions.resize(total);
+        visibleIndices.resize(total);
+        for (size_t i = 0; i < total; ++i) {
+            worldPositions[i] = interpolation.at(snapshot.trackPreviousPositions[i], snapshot.trackPositions[i]);
+        }
+        const size_t visible = camera.transformVisible(worldPositions.data(), total, CONTACT_RADIUS,
+                                                       screenPositions.data(), visibleIndices.data());
+        if (visible == 0) return;
+
+        static const UnitCircle circle;
+
+        // rlgl flushes on its own if a huge population overflows the batch
+        rlCheckRenderBatchLimit(static_cast<int>(visible) * CONTACT_SEGMENTS * 3);
+        rlBegin(RL_TRIANGLES);
+        for (size_t k = 0; k < visible; ++k) {
+            const float x = screenPositions[k].x;
+            const float y = screenPositions[k].y;
+            const Color color = getContactTypeColor(snapshot.trackTypes[visibleIndices[k]]);
+            rlColor4ub(color.r, color.g, color.b, sweep ? persistence(worldPositions[visibleIndices[k]]) : color.a);
+
+            // same winding as raylib's DrawCircleSector so culling keeps the fan
+            for (int i = 0; i < CONTACT_SEGMENTS; ++i) {
+                rlVertex2f(x, y);
+                rlVertex2f(x + circle.x[i + 1], y + circle.y[i + 1]);
+                rlVertex2f(x + circle.x[i], y + circle.y[i]);
+            }
         }
+        rlEnd();
     }
 
     bool onMouseDown(Vector2 pos) override {
@@ -32,22 +71,55 @@ public:
     }
 
 private:
-    // convert world coords to screen pixels
-    static Vector2 worldToScreen(Vector2 world, const Rectangle& r) {
-        float nx = (world.x + 600.0f) / 1200.0f;
-        float ny = (world.y + 360.0f) / 720.0f;
-        return { r.x + nx * r.width, r.y + ny * r.height };
+    // phosphor-style afterglow: full just behind the beam, dimmest just ahead of it
+    unsigned char persistence(Vector2 world) const {
+        float turns = atan2f(world.x, -world.y) * (1.0f / TWO_PI);
+        if (turns < 0.0f) turns += 1.0f;
+        float age = snapshot.beamTurns - turns;
+        if (age < 0.0f) age += 1.0f;
+        return static_cast<unsigned char>(255.0f * (1.0f - 0.8f * age));
+    }
+
+    void drawBeam() const {
+        const Vector2 centre = camera.worldToScreen({0, 0});
+        const float bearing = snapshot.beamTurns * TWO_PI;
+        // long enough to leave the display at any zoom; the caller clips it
+        const float reach = 4096.0f;
+        const Vector2 tip = { centre.x + sinf(bearing) * reach, centre.y - cosf(bearing) * reach };
+        DrawLineEx(centre, tip, 2.0f, Fade(GREEN, 0.6f));
     }
 
     Color getContactTypeColor(ContactType type) const {
-        switch (type) {
-            case ContactType::EnemySub: return RED;
-            case ContactType::FriendlySub: return GREEN;
-            case ContactType::Fish: return SKYBLUE;
-            case ContactType::Debris: return GRAY;
-            default: return WHITE;
-        }
+        return CONTACT_COLORS[static_cast<int>(type)];
     }
 
-    ContactManager& contacts;
+    // indexed by ContactType
+    static constexpr Color CONTACT_COLORS[] = { RED, GREEN, SKYBLUE, GRAY };
+
+    static constexpr float TWO_PI = 6.28318531f;
+    static constexpr int CONTACT_SEGMENTS = 12;
+    static constexpr float CONTACT_RADIUS = 4.0f;
+
+    // contact marker outline, precomputed once
+    struct UnitCircle {
+        float x[CONTACT_SEGMENTS + 1];
+        float y[CONTACT_SEGMENTS + 1];
+
+        UnitCircle() {
+            for (int i = 0; i <= CONTACT_SEGMENTS; ++i) {
+                float angle = (float)i / CONTACT_SEGMENTS * 2.0f * 3.14159265359f;
+                x[i] = cosf(angle) * CONTACT_RADIUS;
+                y[i] = sinf(angle) * CONTACT_RADIUS;
+            }
+        }
+    };
+
+    const SimulationSnapshot& snapshot;
+    const SonarCamera& camera;
+    const RenderInterpolation& interpolation;
+
+    // per-frame scratch, reused to avoid reallocating
+    mutable std::vector<Vector2> worldPositions;
+    mutable std::vector<Vector2> screenPositions;
+    mutable std::vector<uint32_t> visibleIndices;
 };
@@ -100,25 +100,9 @@ void AuthCodePanel::draw() const {
     displayBox->draw();
 }
 
-bool AuthCodePanel::onMouseDown(Vector2 mousePos) {
-    // pass to textboxes
-    if (inputBox->onMouseDown(mousePos)) return true;
-    if (displayBox->onMouseDown(mousePos)) return true;
-    return false;
-}
-
-bool AuthCodePanel::onMouseUp(Vector2 mousePos) {
-    // pass to textboxes
-    if (inputBox->onMouseUp(mousePos)) return true;
-    if (displayBox->onMouseUp(mousePos)) return true;
-    return false;
-}
-
-bool AuthCodePanel::onMouseMove(Vector2 mousePos) {
-    // pass to textboxes
-    if (inputBox->onMouseMove(mousePos)) return true;
-    if (displayBox->onMouseMove(mousePos)) return true;
-    return false;
+void AuthCodePanel::forEachChild(const std::function<void(Widget&)>& visit) {
+    visit(*inputBox);
+    visit(*displayBox);
 }
 
 void AuthCodePanel::handleKeypadInput(char key) {
@@ -15,9 +15,7 @@ public:
 
     // widget interface
     void draw() const override;
-    bool onMouseDown(Vector2 mousePos) override;
-    bool onMouseUp(Vector2 mousePos) override;
-    bool onMouseMove(Vector2 mousePos) override;
+    void forEachChild(const std::function<void(Widget&)>& visit) override;
 
     // state management
     void update(float dt) override;
@@ -1,11 +1,11 @@
 #include "ControlPanel.h"
-#include "../../../sim/systems/LaunchSequenceHandler/LaunchSequenceHandler.h"
+#include "../../../sim/SimulationWorld.h"
 
-ControlPanel::ControlPanel(SimulationEngine& engine, LaunchSequenceHandler* launchSequence) 
-    : sequenceHandler(launchSequence) {
+ControlPanel::ControlPanel(const SimulationSnapshot& snapshot, SimulationCommandQueue& commands)
+    : snapshot(snapshot), commands(commands) {
     
     // sub panels
-    launchSequencePanel = std::make_unique<LaunchSequencePanel>(sequenceHandler);
+    launchSequencePanel = std::make_unique<LaunchSequencePanel>(commands);
     keypadPanel = std::make_unique<KeypadPanel>(
         [this](char key) { authCodePanel->handleKeypadInput(key); },
         [this]() { authCodePanel->handleBackspace(); }
@@ -63,31 +63,39 @@ void ControlPanel::setupLayout() {
     
     authCodePanel->setBounds(authArea);
     keypadPanel->setBounds(keypadArea);
+    
+    // keypad plus its label and margin
+    keypadHighlightArea = {
+        keypadArea.x - 15,
+        keypadArea.y - 25,
+        keypadArea.width + 50,
+        keypadArea.height + 60
+    };
 }
 
 void ControlPanel::handleAuthCodeSubmit(const std::string& code) {
-    if (sequenceHandler) {
-        sequenceHandler->submitAuthorization(code);
-    }
+    commands.post([code](SimulationWorld& world) { world.getLaunchSequence().submitAuthorization(code); });
 }
 
 void ControlPanel::update(float dt) {
     // display current launch phase
-    if (sequenceHandler) {
-        phaseDisplay->setCurrentPhase(sequenceHandler->getCurrentPhaseString());
-        
-        // show current auth code
-        const std::string& currentAuthCode = sequenceHandler->getAuthCode();
-        if (!currentAuthCode.empty()) {
-            authCodePanel->setAuthCode(currentAuthCode);
-        } else {
-            authCodePanel->clearAuthCodeDisplay();
-            authCodePanel->clearInput();
-        }
-    }
+    phaseDisplay->setCurrentPhase(snapshot.launchPhase);
     
     launchSequencePanel->update(dt);
     keypadPanel->update(dt);
+
+    // until the sim has seen the last request the snapshot predates it, so
+    // the code display and the typed input are left alone and a full input
+    // isn't submitted twice
+    if (commands.isAheadOf(snapshot)) return;
+
+    // show current auth code
+    if (!snapshot.authCode.empty()) {
+        authCodePanel->setAuthCode(snapshot.authCode);
+    } else {
+        authCodePanel->clearAuthCodeDisplay();
+        authCodePanel->clearInput();
+    }
     authCodePanel->update(dt);
 }
 
@@ -102,28 +110,13 @@ void ControlPanel::draw() const {
     phaseDisplay->draw();
 }
 
-bool ControlPanel::onMouseDown(Vector2 mousePos) {
-    // pass to sub panels
-    if (launchSequencePanel->onMouseDown(mousePos)) return true;
-    if (keypadPanel->onMouseDown(mousePos)) return true;
-    if (authCodePanel->onMouseDown(mousePos)) return true;
-    return false;
-}
-
-bool ControlPanel::onMouseUp(Vector2 mousePos) {
-    // pass to sub panels
-    if (launchSequencePanel->onMouseUp(mousePos)) return true;
-    if (keypadPanel->onMouseUp(mousePos)) return true;
-    if (authCodePanel->onMouseUp(mousePos)) return true;
-    return false;
-}
-
-bool ControlPanel::onMouseMove(Vector2 mousePos) {
-    // pass to sub panels
-    if (launchSequencePanel->onMouseMove(mousePos)) return true;
-    if (keypadPanel->onMouseMove(mousePos)) return true;
-    if (authCodePanel->onMouseMove(mousePos)) return true;
-    return false;
+// sub panels, in draw order; input reaches them through the hit-test index.
+// the phase display is display-only and overlaps the authorize button, so it
+// is left out rather than shadowing it
+void ControlPanel::forEachChild(const std::function<void(Widget&)>& visit) {
+    visit(*launchSequencePanel);
+    visit(*keypadPanel);
+    visit(*authCodePanel);
 }
 
 void ControlPanel::handleKeypadInput(char key) {
@@ -5,28 +5,33 @@
 #include "KeypadPanel.h"
 #include "AuthCodePanel.h"
 #include "LaunchPhaseDisplay.h"
-#include "../../../sim/systems/LaunchSequenceHandler/LaunchSequenceHandler.h"
-#include "../../../sim/SimulationEngine.h"
+#include "../../../sim/SimulationSnapshot.h"
+#include "../../../sim/SimulationCommands.h"
 #include <memory>
 #include <raylib.h>
 
 class ControlPanel : public Widget {
 public:
-    explicit ControlPanel(SimulationEngine& engine, LaunchSequenceHandler* launchSequence);
+    ControlPanel(const SimulationSnapshot& snapshot, SimulationCommandQueue& commands);
 
     // Widget interface
     void draw() const override;
-    bool onMouseDown(Vector2 mousePos) override;
-    bool onMouseUp(Vector2 mousePos) override;
-    bool onMouseMove(Vector2 mousePos) override;
+    void forEachChild(const std::function<void(Widget&)>& visit) override;
 
     // State management
     void update(float dt) override;
     void setBounds(Rectangle newBounds);
 
+    // cached layout, for guidance highlights
+    const Rectangle& getAuthorizeButtonBounds() const { return launchSequencePanel->getAuthorizeButtonBounds(); }
+    const Rectangle& getArmButtonBounds() const { return launchSequencePanel->getArmButtonBounds(); }
+    const Rectangle& getLaunchButtonBounds() const { return launchSequencePanel->getLaunchButtonBounds(); }
+    const Rectangle& getKeypadHighlightBounds() const { return keypadHighlightArea; }
+
 private:
-    // launch sequence logic
-    LaunchSequenceHandler* sequenceHandler;
+    // launch sequence state comes in the snapshot, requests go out as commands
+    const SimulationSnapshot& snapshot;
+    SimulationCommandQueue& commands;
     
     // child panels
     std::unique_ptr<LaunchSequencePanel> launchSequencePanel;
@@ -37,6 +42,7 @@ private:
     // panel areas
     Rectangle leftPanelArea;
     Rectangle rightPanelArea;
+    Rectangle keypadHighlightArea;
     
     // internal helpers
     void setupLayout();
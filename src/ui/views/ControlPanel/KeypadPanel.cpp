@@ -93,23 +93,8 @@ void KeypadPanel::draw() const {
     }
 }
 
-bool KeypadPanel::onMouseDown(Vector2 mousePos) {
+void KeypadPanel::forEachChild(const std::function<void(Widget&)>& visit) {
     for (auto& button : keypadButtons) {
-        if (button->onMouseDown(mousePos)) return true;
+        visit(*button);
     }
-    return false;
-}
-
-bool KeypadPanel::onMouseUp(Vector2 mousePos) {
-    for (auto& button : keypadButtons) {
-        if (button->onMouseUp(mousePos)) return true;
-    }
-    return false;
-}
-
-bool KeypadPanel::onMouseMove(Vector2 mousePos) {
-    for (auto& button : keypadButtons) {
-        if (button->onMouseMove(mousePos)) return true;
-    }
-    return false;
 }
@@ -16,9 +16,7 @@ public:
 
     // Widget interface
     void draw() const override;
-    bool onMouseDown(Vector2 mousePos) override;
-    bool onMouseUp(Vector2 mousePos) override;
-    bool onMouseMove(Vector2 mousePos) override;
+    void forEachChild(const std::function<void(Widget&)>& visit) override;
 
     // State management
     void update(float dt) override;
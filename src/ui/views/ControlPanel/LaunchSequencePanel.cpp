@@ -1,7 +1,8 @@
 #include "LaunchSequencePanel.h"
+#include "../../../sim/SimulationWorld.h"
 
-LaunchSequencePanel::LaunchSequencePanel(LaunchSequenceHandler* handler) 
-    : sequenceHandler(handler) {
+LaunchSequencePanel::LaunchSequencePanel(SimulationCommandQueue& commands)
+    : commands(commands) {
     
     // launch sequence buttons
     authorizeButton = std::make_unique<Button>("AUTHORIZE LAUNCH", [this]() { onAuthorize(); });
@@ -62,50 +63,25 @@ void LaunchSequencePanel::draw() const {
     resetButton->draw();
 }
 
-bool LaunchSequencePanel::onMouseDown(Vector2 mousePos) {
-    if (authorizeButton->onMouseDown(mousePos)) return true;
-    if (armButton->onMouseDown(mousePos)) return true;
-    if (launchButton->onMouseDown(mousePos)) return true;
-    if (resetButton->onMouseDown(mousePos)) return true;
-    return false;
-}
-
-bool LaunchSequencePanel::onMouseUp(Vector2 mousePos) {
-    if (authorizeButton->onMouseUp(mousePos)) return true;
-    if (armButton->onMouseUp(mousePos)) return true;
-    if (launchButton->onMouseUp(mousePos)) return true;
-    if (resetButton->onMouseUp(mousePos)) return true;
-    return false;
-}
-
-bool LaunchSequencePanel::onMouseMove(Vector2 mousePos) {
-    if (authorizeButton->onMouseMove(mousePos)) return true;
-    if (armButton->onMouseMove(mousePos)) return true;
-    if (launchButton->onMouseMove(mousePos)) return true;
-    if (resetButton->onMouseMove(mousePos)) return true;
-    return false;
+void LaunchSequencePanel::forEachChild(const std::function<void(Widget&)>& visit) {
+    visit(*authorizeButton);
+    visit(*armButton);
+    visit(*launchButton);
+    visit(*resetButton);
 }
 
 void LaunchSequencePanel::onAuthorize() {
-    if (sequenceHandler) {
-        sequenceHandler->requestAuthorization();
-    }
+    commands.post([](SimulationWorld& world) { world.getLaunchSequence().requestAuthorization(); });
 }
 
 void LaunchSequencePanel::onArm() {
-    if (sequenceHandler) {
-        sequenceHandler->requestArm();
-    }
+    commands.post([](SimulationWorld& world) { world.getLaunchSequence().requestArm(); });
 }
 
 void LaunchSequencePanel::onLaunch() {
-    if (sequenceHandler) {
-        sequenceHandler->requestLaunch();
-    }
+    commands.post([](SimulationWorld& world) { world.getLaunchSequence().requestLaunch(); });
 }
 
 void LaunchSequencePanel::onReset() {
-    if (sequenceHandler) {
-        sequenceHandler->requestReset();
-    }
+    commands.post([](SimulationWorld& world) { world.getLaunchSequence().requestReset(); });
 }
\ No newline at end of file
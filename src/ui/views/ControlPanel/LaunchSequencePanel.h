@@ -2,26 +2,29 @@
 
 #include "../../Widget.h"
 #include "../../widgets/Button.h"
-#include "../../../sim/systems/LaunchSequenceHandler/LaunchSequenceHandler.h"
+#include "../../../sim/SimulationCommands.h"
 #include <memory>
 #include <raylib.h>
 
 class LaunchSequencePanel : public Widget {
 public:
-    explicit LaunchSequencePanel(LaunchSequenceHandler* handler);
+    explicit LaunchSequencePanel(SimulationCommandQueue& commands);
 
     // Widget interface
     void draw() const override;
-    bool onMouseDown(Vector2 mousePos) override;
-    bool onMouseUp(Vector2 mousePos) override;
-    bool onMouseMove(Vector2 mousePos) override;
+    void forEachChild(const std::function<void(Widget&)>& visit) override;
 
     // State management
     void update(float dt) override;
     void setBounds(Rectangle newBounds);
 
+    // cached button layout, for guidance highlights
+    const Rectangle& getAuthorizeButtonBounds() const { return authorizeButton->getBounds(); }
+    const Rectangle& getArmButtonBounds() const { return armButton->getBounds(); }
+    const Rectangle& getLaunchButtonBounds() const { return launchButton->getBounds(); }
+
 private:
-    LaunchSequenceHandler* sequenceHandler;
+    SimulationCommandQueue& commands;
     
     std::unique_ptr<Button> authorizeButton;
     std::unique_ptr<Button> armButton;
@@ -1,29 +1,20 @@
 #include "CrosshairView.h"
 
-void CrosshairView::drawOnSonar(const Rectangle& sonarBounds) const {
+void CrosshairView::drawOnSonar() const {
     // mouse targeting circle when over sonar
-    if (crosshairManager.isMouseOverSonar()) {
-        Vector2 mousePos = crosshairManager.getMousePosition();
-        drawSelectionCircle(mousePos, sonarBounds);
+    if (mouseOverSonar) {
+        drawSelectionCircle(mousePosition);
     }
     
     // crosshair when locked onto target
-    if (crosshairManager.isTracking()) {
-        Vector2 crosshairWorldPos = crosshairManager.getCrosshairPosition();
-        drawCrosshair(crosshairWorldPos, sonarBounds);
+    if (snapshot.tracking) {
+        Vector2 crosshairWorldPos = interpolation.at(snapshot.previousCrosshairPosition, snapshot.crosshairPosition);
+        drawCrosshair(crosshairWorldPos);
     }
 }
 
-Vector2 CrosshairView::worldToScreen(Vector2 world, const Rectangle& sonarBounds) const {
-    // world to screen conversion
-    float nx = (world.x + 600.0f) / 1200.0f;
-    float ny = (world.y + 360.0f) / 720.0f;
-    
-    return { sonarBounds.x + nx * sonarBounds.width, sonarBounds.y + ny * sonarBounds.height };
-}
-
-void CrosshairView::drawCrosshair(Vector2 position, const Rectangle& sonarBounds) const {
-    Vector2 screenPos = worldToScreen(position, sonarBounds);
+void CrosshairView::drawCrosshair(Vector2 position) const {
+    Vector2 screenPos = camera.worldToScreen(position);
     
     int x = (int)(screenPos.x + 0.5f);
     int y = (int)(screenPos.y + 0.5f);
@@ -42,7 +33,7 @@ void CrosshairView::drawCrosshair(Vector2 position, const Rectangle& sonarBounds
                Vector2{(float)x, (float)(y + plusSize)}, thickness, crosshairColor);
 }
 
-void CrosshairView::drawSelectionCircle(Vector2 position, const Rectangle& sonarBounds) const {
+void CrosshairView::drawSelectionCircle(Vector2 position) const {
     Color circleColor = Fade(YELLOW, 0.3f);
     DrawCircleLines((int)position.x, (int)position.y, 12, circleColor);
 }
@@ -1,21 +1,33 @@
 #pragma once
 
 #include "../Widget.h"
-#include "../../sim/world/CrosshairManager.h"
+#include "../SonarCamera.h"
+#include "../RenderInterpolation.h"
+#include "../../sim/SimulationSnapshot.h"
 
 class CrosshairView : public Widget {
 public:
-    explicit CrosshairView(CrosshairManager& crosshair) : crosshairManager(crosshair) {}
+    CrosshairView(const SimulationSnapshot& snapshot, const SonarCamera& camera, const RenderInterpolation& interpolation)
+        : snapshot(snapshot), camera(camera), interpolation(interpolation) {}
 
 //    void draw() const override {
 //   }
 
-    void drawOnSonar(const Rectangle& sonarBounds) const;
+    // the mouse is ui state, so the root hands it over each frame
+    void setMouse(Vector2 position, bool overSonar) {
+        mousePosition = position;
+        mouseOverSonar = overSonar;
+    }
+
+    void drawOnSonar() const;
 
 private:
-    CrosshairManager& crosshairManager;
+    const SimulationSnapshot& snapshot;
+    const SonarCamera& camera;
+    const RenderInterpolation& interpolation;
+    Vector2 mousePosition = {0, 0};
+    bool mouseOverSonar = false;
     
-    Vector2 worldToScreen(Vector2 world, const Rectangle& sonarBounds) const;
-    void drawCrosshair(Vector2 position, const Rectangle& sonarBounds) const;
-    void drawSelectionCircle(Vector2 position, const Rectangle& sonarBounds) const;
+    void drawCrosshair(Vector2 position) const;
+    void drawSelectionCircle(Vector2 position) const;
 };
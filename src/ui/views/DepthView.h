@@ -2,8 +2,9 @@
 
 #include "../Widget.h"
 #include "../widgets/Throttle.h"
-#include "../../sim/SimulationEngine.h"
-#include "../../sim/systems/DepthSystem.h"
+#include "../../sim/SimulationSnapshot.h"
+#include "../../sim/SimulationCommands.h"
+#include "../../sim/SimulationWorld.h"
 #include <memory>
 #include <string>
 #include <iomanip>
@@ -11,17 +12,26 @@
 
 class DepthView : public Widget {
 public:
-    DepthView(SimulationEngine& engine, DepthSystem& depth) 
-        : engine(engine), depth(depth) {
+    DepthView(const SimulationSnapshot& snapshot, SimulationCommandQueue& commands)
+        : snapshot(snapshot), commands(commands) {
         
         // depth control slider
         depthThrottle = std::make_unique<Throttle>([this](float value) {
-            this->depth.setThrottleValue(value);
+            this->commands.post([value](SimulationWorld& world) { world.getDepthSystem().setThrottleValue(value); });
         });
     }
 
+    void setBounds(Rectangle newBounds) {
+        Widget::setBounds(newBounds);
+        
+        // throttle positioning
+        float throttleWidth = 50;
+        float throttleX = bounds.x + (bounds.width - throttleWidth) / 2 - 70;
+        depthThrottle->setBounds({ throttleX, bounds.y + 12, throttleWidth, bounds.height - 25 });
+    }
+
     void draw() const override {
-        const auto& s = engine.getState();
+        const auto& s = snapshot.state;
         
         // depth panel
         DrawRectangleRec(bounds, Fade(DARKGREEN, 0.3f));
@@ -36,34 +46,25 @@ public:
 
         // target depth label
         DrawText("Optimal:", (int)bounds.x + 10, (int)bounds.y + 64, 18, RAYWHITE);
-        std::string optimalDepthStr = formatFloat(depth.getOptimalDepth(), 1) + "m";
+        std::string optimalDepthStr = formatFloat(snapshot.optimalDepth, 1) + "m";
         DrawText(optimalDepthStr.c_str(),
                  (int)bounds.x + 100, (int)bounds.y + 64, 18, SKYBLUE);
         
-        // throttle positioning
-        float throttleWidth = 50;
-        float throttleX = bounds.x + (bounds.width - throttleWidth) / 2 - 70;
-        Rectangle throttleRect = { throttleX, bounds.y + 12, throttleWidth, bounds.height - 25 };
-        depthThrottle->setBounds(throttleRect);
-        
         depthThrottle->draw();
         
         // movement status display
-        const char* direction = depth.getMovementStatus();
+        const char* direction = snapshot.movementStatus;
         
-        float statusX = throttleX + throttleWidth + 200;
+        const Rectangle& throttleRect = depthThrottle->getBounds();
+        float statusX = throttleRect.x + throttleRect.width + 200;
         DrawText(direction, (int)statusX, (int)bounds.y + 40, 18, RAYWHITE);
-        std::string throttleStr = "Throttle: " + std::to_string((int)depth.getThrottlePercentage()) + "%";
+        std::string throttleStr = "Throttle: " + std::to_string((int)snapshot.throttlePercentage) + "%";
         DrawText(throttleStr.c_str(), 
                 (int)statusX, (int)bounds.y + 65, 16, LIGHTGRAY);
     }
 
-    bool onMouseDown(Vector2 pos) override {
-        return depthThrottle->onMouseDown(pos);
-    }
-
-    bool onMouseUp(Vector2 pos) override {
-        return depthThrottle->onMouseUp(pos);
+    void forEachChild(const std::function<void(Widget&)>& visit) override {
+        visit(*depthThrottle);
     }
 
     void update(float dt) override {
@@ -77,7 +78,7 @@ private:
         return oss.str();
     }
 
-    SimulationEngine& engine;
-    DepthSystem& depth;
+    const SimulationSnapshot& snapshot;
+    SimulationCommandQueue& commands;
     std::unique_ptr<Throttle> depthThrottle;
 };
@@ -2,13 +2,13 @@
 
 #include "../Widget.h"
 #include "../widgets/PulsatingBorder.h"
-#include "../../sim/world/MissionInstructionManager.h"
+#include "../../sim/SimulationSnapshot.h"
 #include <string>
 
 class GuidanceView : public Widget {
 public:
-    GuidanceView(const MissionInstructionManager& manager) 
-        : missionManager(manager) {
+    explicit GuidanceView(const SimulationSnapshot& snapshot)
+        : snapshot(snapshot) {
         // pulsate areas of interest for mission guidance
         pulsatingBorder = PulsatingBorder(ORANGE, 3.0f, 0.3f, 1.0f, 2);
     }
@@ -27,7 +27,7 @@ public:
         DrawText(headerText, (int)headerX, (int)headerY, headerFontSize, YELLOW);
         
         // show current mission step
-        MissionInstruction instruction = missionManager.getCurrentInstruction();
+        const MissionInstruction& instruction = snapshot.instruction;
         if (!instruction.instructionText.empty()) {
             int fontSize = 16;
             Vector2 textSize = MeasureTextEx(GetFontDefault(), instruction.instructionText.c_str(), fontSize, 1);
@@ -46,6 +46,6 @@ public:
     }
     
 private:
-    const MissionInstructionManager& missionManager;
+    const SimulationSnapshot& snapshot;
     PulsatingBorder pulsatingBorder;
 };
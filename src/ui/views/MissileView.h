@@ -1,93 +1,228 @@
 #pragma once
 
 #include "../Widget.h"
-#include "../../sim/world/MissileManager.h"
-#include <iostream>
+#include "../SonarCamera.h"
+#include "../RenderInterpolation.h"
+#include "../../sim/SimulationSnapshot.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <rlgl.h>
 
 class MissileView : public Widget {
 public:
-    explicit MissileView(MissileManager& missiles) : missileManager(missiles) {}
+    MissileView(const SimulationSnapshot& snapshot, const SonarCamera& camera, const RenderInterpolation& interpolation)
+        : snapshot(snapshot), camera(camera), interpolation(interpolation) {}
 
 //    void draw() const override {
 //    }
 
-    // draw missiles and explosions on sonar
-    void drawMissilesOnSonar(const Rectangle& sonarBounds) const {
-        int missileCount = static_cast<int>(missileManager.getActiveMissiles().size());
-        
+    // draw missiles and explosions on sonar. trails, heads and explosion
+    // rings all go out as one rlgl triangle batch.
+    void drawMissilesOnSonar() const {
+        const auto& missiles = snapshot.missiles;
+        const auto& explosions = snapshot.explosions;
+        if (missiles.empty() && explosions.empty()) return;
+
+        rlBegin(RL_TRIANGLES);
+
         // draw active missiles
-        for (const auto& missile : missileManager.getActiveMissiles()) {
-            Vector2 screen = worldToScreen(missile.position, sonarBounds);
-            DrawCircle((int)screen.x, (int)screen.y, 3, YELLOW);
-            
-            // draw trail showing path
-            if (missile.trailPoints.size() > 1) {
-                for (size_t i = 1; i < missile.trailPoints.size(); ++i) {
-                    Vector2 start = worldToScreen(missile.trailPoints[i-1], sonarBounds);
-                    Vector2 end = worldToScreen(missile.trailPoints[i], sonarBounds);
-                    
-                    float fadeRatio = (float)i / (float)missile.trailPoints.size();
-                    float alpha = 0.3f + (fadeRatio * 0.4f);
-
-                    DrawLineEx(start, end, 2, Fade(GRAY, alpha));
-                }
+        const Rectangle& view = camera.getViewport();
+        for (const auto& missile : missiles) {
+            Vector2 screen = camera.worldToScreen(interpolation.at(missile.previousPosition, missile.position));
+            rlCheckRenderBatchLimit(DISC_VERTICES);
+            emitDisc((float)(int)screen.x, (float)(int)screen.y, 3.0f, YELLOW);
+
+            // trail showing path, transformed in one batch
+            const size_t trailCount = missile.trailPoints.size();
+            if (trailCount > 1) {
+                screenPoints.resize(trailCount);
+                camera.transform(missile.trailPoints.data(), trailCount, screenPoints.data());
+                // the newest trail point follows the interpolated head
+                screenPoints[trailCount - 1] = screen;
+                emitTrail(screenPoints.data(), trailCount, view);
             }
         }
-        
-        // draw explosion
-        for (const auto& explosion : missileManager.getActiveExplosions()) {
-            Vector2 screen = worldToScreen(explosion.position, sonarBounds);
-            float scale = sonarBounds.width / 1200.0f;
-            
-            int x = (int)screen.x;
-            int y = (int)screen.y;
-
-            int innerRadius = (int)(explosion.innerRing * scale);
-            int middleRadius = (int)(explosion.middleRing * scale);
-            int outerRadius = (int)(explosion.outerRing * scale);
-            
-
-            float progress = explosion.timer / explosion.duration;
-            float pulseIntensity = 0.5f + 0.5f * sinf(progress * 10.0f);
-            
-            if (explosion.flashIntensity > 0.8f) {
-                DrawCircle(x, y, (int)(20 * scale), Fade(WHITE, explosion.flashIntensity));
+
+        // draw explosions, culled against the view by their outer ring
+        if (!explosions.empty()) {
+            const float scale = camera.getScale().x;
+            float margin = 0.0f;
+            worldPoints.resize(explosions.size());
+            screenPoints.resize(explosions.size());
+            visibleIndices.resize(explosions.size());
+            for (size_t i = 0; i < explosions.size(); ++i) {
+                worldPoints[i] = explosions[i].position;
+                margin = std::max(margin, std::max(explosions[i].outerRing, 20.0f) * scale);
             }
-            
-            if (outerRadius > 5) {
-                Color outerColor = {255, 100, 50, (unsigned char)(255 * (1.0f - progress) * pulseIntensity)};
-                DrawCircleLines(x, y, outerRadius, outerColor);
-                DrawCircleLines(x, y, outerRadius - 1, Fade(outerColor, 0.5f));
+            const size_t visible = camera.transformVisible(worldPoints.data(), explosions.size(), margin,
+                                                           screenPoints.data(), visibleIndices.data());
+
+            for (size_t k = 0; k < visible; ++k) {
+                emitExplosion(explosions[visibleIndices[k]], screenPoints[k], scale);
             }
-            
-            if (middleRadius > 3) {
-                Color middleColor = {255, 150, 50, (unsigned char)(255 * (1.2f - progress) * pulseIntensity)};
-                DrawCircleLines(x, y, middleRadius, middleColor);
-                DrawCircleLines(x, y, middleRadius - 1, Fade(middleColor, 0.7f));
-                DrawCircleLines(x, y, middleRadius + 1, Fade(middleColor, 0.3f));
+        }
+
+        rlEnd();
+    }
+
+private:
+    static constexpr int RING_SEGMENTS = 36;          // same tessellation as DrawCircle/DrawCircleLines
+    static constexpr int DISC_VERTICES = RING_SEGMENTS * 3;
+    static constexpr int RING_VERTICES = RING_SEGMENTS * 6;
+    static constexpr float TRAIL_THICKNESS = 2.0f;
+
+    // unit circle shared by every ring and disc
+    struct UnitRing {
+        float x[RING_SEGMENTS + 1];
+        float y[RING_SEGMENTS + 1];
+
+        UnitRing() {
+            for (int i = 0; i <= RING_SEGMENTS; ++i) {
+                float angle = (float)i / RING_SEGMENTS * 2.0f * 3.14159265359f;
+                x[i] = cosf(angle);
+                y[i] = sinf(angle);
+            }
+        }
+    };
+
+    static const UnitRing& unitRing() {
+        static const UnitRing ring;
+        return ring;
+    }
+
+    static void vertex(Vector2 p, Color c) {
+        rlColor4ub(c.r, c.g, c.b, c.a);
+        rlVertex2f(p.x, p.y);
+    }
+
+    // filled circle, wound like raylib's DrawCircleSector
+    static void emitDisc(float cx, float cy, float radius, Color color) {
+        const UnitRing& ring = unitRing();
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = 0; i < RING_SEGMENTS; ++i) {
+            rlVertex2f(cx, cy);
+            rlVertex2f(cx + ring.x[i + 1] * radius, cy + ring.y[i + 1] * radius);
+            rlVertex2f(cx + ring.x[i] * radius, cy + ring.y[i] * radius);
+        }
+    }
+
+    // one pixel wide annulus standing in for a DrawCircleLines outline,
+    // wound like raylib's DrawRing
+    static void emitRing(float cx, float cy, float radius, Color color) {
+        const UnitRing& ring = unitRing();
+        const float inner = radius - 0.5f;
+        const float outer = radius + 0.5f;
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = 0; i < RING_SEGMENTS; ++i) {
+            rlVertex2f(cx + ring.x[i] * outer, cy + ring.y[i] * outer);
+            rlVertex2f(cx + ring.x[i] * inner, cy + ring.y[i] * inner);
+            rlVertex2f(cx + ring.x[i + 1] * inner, cy + ring.y[i + 1] * inner);
+
+            rlVertex2f(cx + ring.x[i] * outer, cy + ring.y[i] * outer);
+            rlVertex2f(cx + ring.x[i + 1] * inner, cy + ring.y[i + 1] * inner);
+            rlVertex2f(cx + ring.x[i + 1] * outer, cy + ring.y[i + 1] * outer);
+        }
+    }
+
+    // trail as one continuous strip: each point gets a shared left/right
+    // vertex pair along the averaged direction, and alpha rises toward the
+    // missile instead of stepping per segment
+    void emitTrail(const Vector2* points, size_t count, const Rectangle& view) const {
+        const float halfThick = TRAIL_THICKNESS * 0.5f;
+        rlCheckRenderBatchLimit(static_cast<int>(count - 1) * 6);
+
+        Vector2 prevLeft{}, prevRight{};
+        Color prevColor{};
+        Vector2 radius = { 0.0f, 0.0f };
+        for (size_t j = 0; j < count; ++j) {
+            const Vector2 a = points[j > 0 ? j - 1 : 0];
+            const Vector2 b = points[j + 1 < count ? j + 1 : count - 1];
+            const float dx = b.x - a.x;
+            const float dy = b.y - a.y;
+            const float length = sqrtf(dx * dx + dy * dy);
+            // stationary points keep the previous direction
+            if (length > 0.0f) {
+                radius = { -halfThick * dy / length, halfThick * dx / length };
             }
-            
-            if (innerRadius > 1) {
-                Color innerColor = {255, 255, 150, (unsigned char)(255 * (1.5f - progress) * pulseIntensity)};
-                DrawCircleLines(x, y, innerRadius, innerColor);
-                DrawCircleLines(x, y, innerRadius - 1, Fade(innerColor, 0.8f));
-                DrawCircleLines(x, y, innerRadius + 1, Fade(innerColor, 0.5f));
-                DrawCircleLines(x, y, innerRadius + 2, Fade(innerColor, 0.2f));
+
+            const Vector2 p = points[j];
+            const Vector2 left = { p.x - radius.x, p.y - radius.y };
+            const Vector2 right = { p.x + radius.x, p.y + radius.y };
+            const Color color = Fade(GRAY, 0.3f + 0.4f * (float)j / (float)count);
+
+            // quad between consecutive points, wound like raylib's DrawLineEx
+            if (j > 0 && segmentMayBeVisible(points[j - 1], p, view)) {
+                vertex(left, color);
+                vertex(prevLeft, prevColor);
+                vertex(prevRight, prevColor);
+
+                vertex(right, color);
+                vertex(left, color);
+                vertex(prevRight, prevColor);
             }
-            
-            Color coreColor = {255, 255, 200, (unsigned char)(255 * (1.0f - progress * 0.7f) * pulseIntensity)};
-            DrawCircle(x, y, (int)(8 * scale), Fade(coreColor, 0.6f));
-            DrawCircle(x, y, (int)(4 * scale), coreColor);
+            prevLeft = left;
+            prevRight = right;
+            prevColor = color;
         }
     }
 
-private:
-    // world to screen conversion
-    static Vector2 worldToScreen(Vector2 world, const Rectangle& r) {
-        float nx = (world.x + 600.0f) / 1200.0f;
-        float ny = (world.y + 360.0f) / 720.0f;
-        return { r.x + nx * r.width, r.y + ny * r.height };
+    void emitExplosion(const Explosion& explosion, Vector2 screen, float scale) const {
+        float x = (float)(int)screen.x;
+        float y = (float)(int)screen.y;
+
+        int innerRadius = (int)(explosion.innerRing * scale);
+        int middleRadius = (int)(explosion.middleRing * scale);
+        int outerRadius = (int)(explosion.outerRing * scale);
+
+        float progress = explosion.timer / explosion.duration;
+        float pulseIntensity = 0.5f + 0.5f * sinf(progress * 10.0f);
+
+        // worst case: flash, nine outlines and the two core discs
+        rlCheckRenderBatchLimit(9 * RING_VERTICES + 3 * DISC_VERTICES);
+
+        if (explosion.flashIntensity > 0.8f) {
+            emitDisc(x, y, (float)(int)(20 * scale), Fade(WHITE, explosion.flashIntensity));
+        }
+
+        if (outerRadius > 5) {
+            Color outerColor = {255, 100, 50, (unsigned char)(255 * (1.0f - progress) * pulseIntensity)};
+            emitRing(x, y, (float)outerRadius, outerColor);
+            emitRing(x, y, (float)(outerRadius - 1), Fade(outerColor, 0.5f));
+        }
+
+        if (middleRadius > 3) {
+            Color middleColor = {255, 150, 50, (unsigned char)(255 * (1.2f - progress) * pulseIntensity)};
+            emitRing(x, y, (float)middleRadius, middleColor);
+            emitRing(x, y, (float)(middleRadius - 1), Fade(middleColor, 0.7f));
+            emitRing(x, y, (float)(middleRadius + 1), Fade(middleColor, 0.3f));
+        }
+
+        if (innerRadius > 1) {
+            Color innerColor = {255, 255, 150, (unsigned char)(255 * (1.5f - progress) * pulseIntensity)};
+            emitRing(x, y, (float)innerRadius, innerColor);
+            emitRing(x, y, (float)(innerRadius - 1), Fade(innerColor, 0.8f));
+            emitRing(x, y, (float)(innerRadius + 1), Fade(innerColor, 0.5f));
+            emitRing(x, y, (float)(innerRadius + 2), Fade(innerColor, 0.2f));
+        }
+
+        Color coreColor = {255, 255, 200, (unsigned char)(255 * (1.0f - progress * 0.7f) * pulseIntensity)};
+        emitDisc(x, y, (float)(int)(8 * scale), Fade(coreColor, 0.6f));
+        emitDisc(x, y, (float)(int)(4 * scale), coreColor);
     }
 
-    MissileManager& missileManager;
+    // cheap reject for segments entirely off one side of the view
+    static bool segmentMayBeVisible(Vector2 a, Vector2 b, const Rectangle& view) {
+        return std::max(a.x, b.x) >= view.x && std::min(a.x, b.x) <= view.x + view.width &&
+               std::max(a.y, b.y) >= view.y && std::min(a.y, b.y) <= view.y + view.height;
+    }
+
+    const SimulationSnapshot& snapshot;
+    const SonarCamera& camera;
+    const RenderInterpolation& interpolation;
+
+    // per-frame scratch, reused to avoid reallocating
+    mutable std::vector<Vector2> worldPoints;
+    mutable std::vector<Vector2> screenPoints;
+    mutable std::vector<uint32_t> visibleIndices;
 };
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <raylib.h>
+#include "../Widget.h"
+#include "../FrameProfiler.h"
+#include "../MemoryTracker.h"
+#include "../../sim/SimulationSnapshot.h"
+
+// debug overlay: rolling frame-time graph plus per-system and world stats.
+// text goes through TextFormat's static buffers so drawing it doesn't allocate.
+class ProfilerOverlay : public Widget {
+public:
+    ProfilerOverlay(const FrameProfiler& profiler, const MemoryTracker& memory, const SimulationSnapshot& snapshot)
+        : profiler(profiler), memory(memory), snapshot(snapshot) {}
+
+    void draw() const override {
+        DrawRectangleRec(bounds, Fade(BLACK, 0.8f));
+        DrawRectangleLinesEx(bounds, 1, DARKGRAY);
+
+        const int x = (int)bounds.x + 10;
+        int y = (int)bounds.y + 8;
+
+        const size_t n = profiler.getSampleCount();
+        const float frameMs = n ? profiler.getSample(0).totalMs() : 0.0f;
+        DrawText(TextFormat("PROFILER (F3)   fps %d   frame %.2f ms   peak %.2f ms",
+                            GetFPS(), frameMs, profiler.getPeakTotalMs()),
+                 x, y, 16, RAYWHITE);
+        y += 22;
+
+        // legend with rolling averages
+        for (int s = 0; s < FrameProfiler::SECTION_COUNT; ++s) {
+            const auto section = static_cast<FrameProfiler::Section>(s);
+            DrawRectangle(x + s * 130, y + 3, 10, 10, sectionColors[s]);
+            DrawText(TextFormat("%s %.2f", sectionNames[s], profiler.getAverageMs(section)),
+                     x + s * 130 + 14, y, 14, LIGHTGRAY);
+        }
+        y += 20;
+
+        const Rectangle graph = { (float)x, (float)y, graphWidth, graphHeight };
+        drawGraph(graph);
+
+        // world and allocation counters under the graph
+        int statsY = (int)(graph.y + graph.height) + 8;
+        // allocations are only counted in the app build (PAYLOAD_SIM_COUNT_ALLOCATIONS)
+        const uint32_t allocs = n ? profiler.getSample(0).allocations : 0;
+        DrawText(TextFormat("contacts %d   missiles %d   explosions %d   allocs/frame %s",
+                            (int)snapshot.contactCount,
+                            (int)snapshot.missiles.size(),
+                            (int)snapshot.explosions.size(),
+                            isAllocationCountingEnabled() ? TextFormat("%u", allocs) : "off"),
+                 x, statsY, 14, LIGHTGRAY);
+
+        // pool and cache footprint in KiB, with the high-water total
+        const MemoryTracker::Snapshot& mem = memory.getCurrent();
+        DrawText(TextFormat("KiB contacts %.1f  missiles %.1f  trails %.1f  expl %.1f  ui %.0f  peak %.0f",
+                            mem.world.contacts / 1024.0f, mem.world.missiles / 1024.0f,
+                            mem.world.trails / 1024.0f, mem.world.explosions / 1024.0f,
+                            mem.uiCaches / 1024.0f, memory.getPeakTotal() / 1024.0f),
+                 x, statsY + 18, 14, LIGHTGRAY);
+        DrawText(TextFormat("KiB sonar %.1f  tracks %.1f  sweep %.1f  subs %.1f  school %.1f  currents %.1f",
+                            mem.world.detection / 1024.0f, mem.world.tracks / 1024.0f,
+                            mem.world.sweep / 1024.0f, mem.world.behaviors / 1024.0f,
+                            mem.world.schooling / 1024.0f, mem.world.currents / 1024.0f),
+                 x, statsY + 36, 14, LIGHTGRAY);
+
+        // per-system breakdown to the right of the graph
+        const int sysX = x + (int)graphWidth + 16;
+        int sysY = (int)bounds.y + 30;
+        DrawText("systems (ms)", sysX, sysY, 14, GRAY);
+        sysY += 18;
+        for (const auto& system : snapshot.systemTimes) {
+            DrawText(TextFormat("%-24s %.3f", system.name, system.ms),
+                     sysX, sysY, 12, LIGHTGRAY);
+            sysY += 15;
+        }
+    }
+
+private:
+    // stacked bars, newest on the right, scaled to two 60 fps frames
+    void drawGraph(const Rectangle& graph) const {
+        DrawRectangleRec(graph, Fade(DARKGRAY, 0.3f));
+
+        const float msToPixels = graph.height / (2.0f * frameBudgetMs);
+        const float barWidth = graph.width / FrameProfiler::historySize;
+        const float bottom = graph.y + graph.height;
+
+        for (size_t age = 0; age < profiler.getSampleCount(); ++age) {
+            const FrameProfiler::Sample& sample = profiler.getSample(age);
+            const float barX = graph.x + graph.width - (age + 1) * barWidth;
+            float top = bottom;
+            for (int s = 0; s < FrameProfiler::SECTION_COUNT; ++s) {
+                float h = sample.sectionMs[s] * msToPixels;
+                if (top - h < graph.y) h = top - graph.y;
+                if (h <= 0.0f) break;
+                top -= h;
+                DrawRectangleRec({ barX, top, barWidth, h }, sectionColors[s]);
+            }
+        }
+
+        // 60 fps budget line
+        const float budgetY = bottom - frameBudgetMs * msToPixels;
+        DrawLineV({ graph.x, budgetY }, { graph.x + graph.width, budgetY }, Fade(RED, 0.8f));
+    }
+
+    static constexpr float frameBudgetMs = 1000.0f / 60.0f;
+    static constexpr float graphWidth = 360.0f;
+    static constexpr float graphHeight = 104.0f;
+    static constexpr const char* sectionNames[FrameProfiler::SECTION_COUNT] = { "sim", "ui", "draw" };
+    static constexpr Color sectionColors[FrameProfiler::SECTION_COUNT] = { SKYBLUE, ORANGE, LIME };
+
+    const FrameProfiler& profiler;
+    const MemoryTracker& memory;
+    const SimulationSnapshot& snapshot;
+};
@@ -1,25 +1,39 @@
 #pragma once
 
 #include "../Widget.h"
-#include "../../sim/world/ContactManager.h"
+#include "../RenderCache.h"
+#include "../SonarCamera.h"
+#include <algorithm>
+#include <cmath>
 
 class SonarView : public Widget {
 public:
-    explicit SonarView(ContactManager& contacts) : contacts(contacts) {}
+    explicit SonarView(const SonarCamera& camera) : camera(camera) {}
 
     void draw() const override {
-        // draw sonar display with sub icon
-        drawSonar(bounds);
+        // static sonar layers are cached offscreen and only re-rendered on resize or camera moves
+        if (camera.getRevision() != cachedCameraRevision) {
+            backgroundCache.invalidate();
+            cachedCameraRevision = camera.getRevision();
+        }
+        if (!backgroundCache.draw(bounds, [this](Rectangle r) { drawSonar(r); })) {
+            drawSonar(bounds);
+        }
+        
+        if (camera.getZoom() > 1.0f) {
+            DrawText(TextFormat("x%.1f  (Home to reset)", camera.getZoom()),
+                     (int)(bounds.x + bounds.width) - 190, (int)bounds.y + 10, 16, SKYBLUE);
+        }
     }
     
     const Rectangle& getBounds() const { return bounds; }
+    size_t getCacheBytes() const { return backgroundCache.getByteSize(); }
 
 private:
-    // world to screen conversion
-    static Vector2 worldToScreen(Vector2 world, const Rectangle& r) {
-        float nx = (world.x + 600.0f) / 1200.0f;
-        float ny = (world.y + 360.0f) / 720.0f;
-        return { r.x + nx * r.width, r.y + ny * r.height };
+    // own ship position inside the layer rect r
+    Vector2 subCenterIn(Rectangle r) const {
+        Vector2 screen = camera.worldToScreen({0,0});
+        return { screen.x - bounds.x + r.x, screen.y - bounds.y + r.y };
     }
 
     void drawSonar(Rectangle r) const {
@@ -27,13 +41,16 @@ private:
         DrawRectangleLinesEx(r, 1, SKYBLUE);
         DrawText("Sonar", (int)r.x + 10, (int)r.y + 8, 20, SKYBLUE);
 
+        // grid, bearings and own ship follow the camera, clipped to the display
+        BeginScissorMode(static_cast<int>(r.x), static_cast<int>(r.y), static_cast<int>(r.width), static_cast<int>(r.height));
         drawSonarGrid(r);
         drawDiagonalLines(r);
         drawSubmarineIcon(r);
+        EndScissorMode();
     }
 
     void drawSubmarineIcon(Rectangle r) const {
-        Vector2 subCenter = worldToScreen({0,0}, r);
+        Vector2 subCenter = subCenterIn(r);
 
         int bodyWidth = 24;
         int bodyHeight = 14;
@@ -56,25 +73,40 @@ private:
 
     void drawSonarGrid(Rectangle r) const {
         Color gridColor = Fade(SKYBLUE, 0.15f);
-        Vector2 center = { r.x + r.width/2.0f, r.y + r.height/2.0f };
-        int maxRadius = static_cast<int>(static_cast<float>(std::min(r.width, r.height)) / 2.0f);
-
-        BeginScissorMode(static_cast<int>(r.x), static_cast<int>(r.y), static_cast<int>(r.width), static_cast<int>(r.height));
-        for (int radius = 50; radius <= maxRadius + 100; radius += 50) {
+        Vector2 center = subCenterIn(r);
+        float zoom = camera.getZoom();
+        float step = 50.0f * zoom;
+
+        // rings cover the same world range at any zoom, but only those
+        // that can reach the display are drawn
+        float farX = std::max(center.x - r.x, r.x + r.width - center.x);
+        float farY = std::max(center.y - r.y, r.y + r.height - center.y);
+        float maxRadius = std::min(sqrtf(farX * farX + farY * farY),
+                                   (std::min(r.width, r.height) / 2.0f + 100.0f) * zoom);
+        float nearX = std::max({r.x - center.x, 0.0f, center.x - (r.x + r.width)});
+        float nearY = std::max({r.y - center.y, 0.0f, center.y - (r.y + r.height)});
+        float minRadius = sqrtf(nearX * nearX + nearY * nearY);
+
+        for (float radius = std::max(step, floorf(minRadius / step) * step); radius <= maxRadius; radius += step) {
             DrawCircleLines(static_cast<int>(center.x), static_cast<int>(center.y), radius, gridColor);
         }
-        EndScissorMode();
     }
 
     void drawDiagonalLines(Rectangle r) const {
         Color lineColor = Fade(SKYBLUE, 0.15f);
+        Vector2 center = subCenterIn(r);
+        float zoom = camera.getZoom();
+        float halfW = r.width * 0.5f * zoom;
+        float halfH = r.height * 0.5f * zoom;
         
-        // corner to corner lines
-        DrawLineEx(Vector2{r.x, r.y}, Vector2{r.x + r.width, r.y + r.height}, 1, lineColor);
-        DrawLineEx(Vector2{r.x + r.width, r.y}, Vector2{r.x, r.y + r.height}, 1, lineColor);
+        // corner to corner lines of the whole world
+        DrawLineEx(Vector2{center.x - halfW, center.y - halfH}, Vector2{center.x + halfW, center.y + halfH}, 1, lineColor);
+        DrawLineEx(Vector2{center.x + halfW, center.y - halfH}, Vector2{center.x - halfW, center.y + halfH}, 1, lineColor);
     }
 
-    ContactManager& contacts;
+    const SonarCamera& camera;
+    mutable RenderCache backgroundCache;
+    mutable uint32_t cachedCameraRevision = 0;
 };
 
 
@@ -1,14 +1,15 @@
 #pragma once
 
 #include "../Widget.h"
-#include "../../sim/SimulationEngine.h"
+#include "../../sim/SimulationSnapshot.h"
+#include "../RenderCache.h"
 #include "../widgets/Indicator.h"
 #include <memory>
 #include <vector>
 
 class StatusPanel : public Widget {
 public:
-    explicit StatusPanel(SimulationEngine& engine) : engine(engine) {
+    explicit StatusPanel(const SimulationSnapshot& snapshot) : snapshot(snapshot) {
         // 3x3 grid of status lights
         const std::vector<std::string> labels = {
             "Authorization", "Target Validated", "Target Acquired",
@@ -21,14 +22,39 @@ public:
         }
     }
 
-    void draw() const override {
-        const auto& s = engine.getState();
-        
-        DrawRectangleRec(bounds, Fade(DARKGRAY, 0.4f));
-        
-        //lights represent simulation state
-        updateIndicatorStates(s);
+    void setBounds(Rectangle newBounds) {
+        Widget::setBounds(newBounds);
+        setupLayout();
+    }
+
+    size_t getCacheBytes() const { return panelCache.getByteSize(); }
+
+    // lights represent simulation state; only changed lights mark the panel dirty
+    void update(float /*dt*/) override {
+        updateIndicatorStates(snapshot.state);
+        for (const auto& indicator : indicators) {
+            if (indicator->isDirty()) {
+                markDirty();
+                indicator->clearDirty();
+            }
+        }
         
+        // panel is re-rendered offscreen only when a light or the layout changed
+        if (isDirty()) {
+            panelCache.invalidate();
+            clearDirty();
+        }
+    }
+
+    void draw() const override {
+        if (!panelCache.drawInPlace(bounds, [this]() { drawPanel(); })) {
+            drawPanel();
+        }
+    }
+
+private:
+    // 3x3 grid, computed once per bounds change
+    void setupLayout() {
         const int pad = 15;
         const int boxW = 180;
         const int boxH = 28;
@@ -47,7 +73,6 @@ public:
             }
             
             indicator->setBounds({(float)x, adjustedY, (float)boxW, (float)boxH});
-            indicator->draw();
             
             x += boxW + pad;
             if (x + boxW > bounds.x + bounds.width) {
@@ -58,8 +83,14 @@ public:
         }
     }
 
-private:
-    void updateIndicatorStates(const SimulationState& s) const {
+    void drawPanel() const {
+        DrawRectangleRec(bounds, Fade(DARKGRAY, 0.4f));
+        for (const auto& indicator : indicators) {
+            indicator->draw();
+        }
+    }
+
+    void updateIndicatorStates(const SimulationState& s) {
         // wire sim values to lights
         indicators[0]->setState(s.canLaunchAuthorized);
         indicators[1]->setState(s.targetValidated);
@@ -72,8 +103,9 @@ private:
         indicators[8]->setState(s.launchConditionsFavorable);
     }
 
-    SimulationEngine& engine;
-    mutable std::vector<std::unique_ptr<Indicator>> indicators;
+    const SimulationSnapshot& snapshot;
+    std::vector<std::unique_ptr<Indicator>> indicators;
+    mutable RenderCache panelCache;
 };
 
 
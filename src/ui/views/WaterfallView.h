@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../Widget.h"
+#include "../WaterfallHistory.h"
+#include "../../sim/systems/SonarSystem.h"
+#include "../../sim/SimulationSnapshot.h"
+#include "../../sim/world/WorldBounds.h"
+#include <algorithm>
+#include <cmath>
+
+// bearing-time waterfall under the sonar display, newest ping at the top.
+// history lives in a texture used as a ring of rows: each ping uploads
+// one row and the whole history is drawn as one quad whose source rect
+// starts at the newest row and wraps, so the cost per frame doesn't grow
+// with the history shown.
+class WaterfallView : public Widget {
+public:
+    // power of two both ways: WebGL1 only repeats power-of-two textures
+    static constexpr int BEARING_BINS = 512;
+    static constexpr int HISTORY_ROWS = 512;   // about four minutes at two pings a second
+
+    explicit WaterfallView(const SimulationSnapshot& snapshot)
+        : snapshot(snapshot), history(BEARING_BINS, HISTORY_ROWS) {}
+
+    ~WaterfallView() override {
+        if (texture.id != 0) UnloadTexture(texture);
+    }
+
+    WaterfallView(const WaterfallView&) = delete;
+    WaterfallView& operator=(const WaterfallView&) = delete;
+
+    void update(float /*dt*/) override {
+        // one row per observed ping; if the sim ran several pings since the
+        // last frame only the latest picture is recorded
+        const uint32_t pings = snapshot.pingCount;
+        if (pings == lastPing) return;
+        lastPing = pings;
+
+        history.beginRow(pings);
+        const float maxRange = std::sqrt(WorldBounds::HALF_WIDTH * WorldBounds::HALF_WIDTH +
+                                         WorldBounds::HALF_HEIGHT * WorldBounds::HALF_HEIGHT);
+        for (const Vector2& p : snapshot.pingDetections) {
+            const float range = std::sqrt(p.x * p.x + p.y * p.y);
+            history.addDetection(WaterfallHistory::bearingOf(p), 1.0f - 0.7f * std::min(range / maxRange, 1.0f));
+        }
+        const int row = history.commitRow();
+
+        if (ensureTexture()) {
+            UpdateTextureRec(texture, Rectangle{ 0.0f, (float)row, (float)BEARING_BINS, 1.0f }, history.getRow());
+        }
+    }
+
+    void draw() const override {
+        DrawRectangleRec(bounds, Fade(BLUE, 0.2f));
+        DrawRectangleLinesEx(bounds, 1, SKYBLUE);
+        DrawText("Waterfall", (int)(bounds.x + bounds.width) - 90, (int)bounds.y + 4, 16, SKYBLUE);
+
+        const Rectangle image = imageRect();
+        for (int degrees = 0; degrees < 360; degrees += 90) {
+            const int x = (int)(image.x + image.width * degrees / 360.0f);
+            DrawLine(x, (int)image.y - 4, x, (int)image.y, SKYBLUE);
+            DrawText(TextFormat("%03d", degrees), x + 3, (int)bounds.y + 6, 10, SKYBLUE);
+        }
+
+        if (texture.id != 0) {
+            // source rows past the bottom of the texture wrap to the top
+            const Rectangle source{ 0.0f, (float)history.getHead(), (float)BEARING_BINS, (float)HISTORY_ROWS };
+            DrawTexturePro(texture, source, image, Vector2{ 0.0f, 0.0f }, 0.0f, WHITE);
+        }
+
+        DrawText("now", (int)(image.x + image.width) - 26, (int)image.y + 2, 10, SKYBLUE);
+        DrawText(TextFormat("-%ds", (int)(HISTORY_ROWS * SonarSystem::PING_INTERVAL)),
+                 (int)(image.x + image.width) - 34, (int)(image.y + image.height) - 12, 10, SKYBLUE);
+    }
+
+    const WaterfallHistory& getHistory() const { return history; }
+
+    // texture memory held by the history (RGBA8)
+    size_t getCacheBytes() const {
+        return texture.id != 0 ? static_cast<size_t>(BEARING_BINS) * HISTORY_ROWS * 4 : 0;
+    }
+
+private:
+    const SimulationSnapshot& snapshot;
+    WaterfallHistory history;
+    Texture2D texture{};
+    uint32_t lastPing = 0;
+
+    Rectangle imageRect() const {
+        return { bounds.x + 1.0f, bounds.y + 22.0f, bounds.width - 2.0f, bounds.height - 23.0f };
+    }
+
+    // the texture needs a gpu context, so it is created on the first ping after one exists
+    bool ensureTexture() {
+        if (texture.id != 0) return true;
+        if (!IsWindowReady()) return false;
+
+        Image blank = GenImageColor(BEARING_BINS, HISTORY_ROWS, Color{ 0, 24, 48, 255 });
+        texture = LoadTextureFromImage(blank);
+        UnloadImage(blank);
+        if (texture.id == 0) return false;
+        SetTextureWrap(texture, TEXTURE_WRAP_REPEAT);
+        SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
+        return true;
+    }
+};
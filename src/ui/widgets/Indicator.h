@@ -8,9 +8,19 @@ public:
     explicit Indicator(const std::string& label, bool initialState = false)
         : label(std::move(label)), isActive(initialState) {}
 
-    void setState(bool active) { isActive = active; }
+    void setState(bool active) {
+        if (isActive != active) {
+            isActive = active;
+            markDirty();
+        }
+    }
     bool getState() const { return isActive; }
-    void setLabel(const std::string& newLabel) { label = newLabel; }
+    void setLabel(const std::string& newLabel) {
+        if (label != newLabel) {
+            label = newLabel;
+            markDirty();
+        }
+    }
 
     void draw() const override {
         DrawRectangleLinesEx(bounds, 1, LIGHTGRAY);
@@ -65,6 +65,11 @@ public:
         return false;
     }
 
+    // the handle overhangs the track ends
+    Rectangle getHitBounds() const override {
+        return { bounds.x, bounds.y - HANDLE_SIZE, bounds.width, bounds.height + 2 * HANDLE_SIZE };
+    }
+
     void update(float dt) override {
         // continuous drag updates
         if (dragging) {
@@ -92,6 +97,8 @@ private:
         if (onChange) onChange(value);
     }
 
+    static constexpr float HANDLE_SIZE = 12;
+
     float value;
     std::function<void(float)> onChange;
     bool dragging;
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "sim/batch/BatchSimulation.h"
+#include "sim/batch/BatchEnvironmentAPI.h"
+
+class BatchSimulationTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t worldCount = 8;
+
+    std::vector<float> observations = std::vector<float>(worldCount * PAYLOAD_SIM_OBSERVATION_SIZE);
+    std::vector<float> rewards = std::vector<float>(worldCount);
+
+    static PayloadSimAction idleAction() {
+        PayloadSimAction action{};
+        action.depthThrottle = 0.5f;
+        return action;
+    }
+};
+
+TEST_F(BatchSimulationTest, CreatesRequestedNumberOfWorlds) {
+    BatchSimulation batch(worldCount, 1, 2);
+
+    EXPECT_EQ(batch.getWorldCount(), worldCount);
+    EXPECT_EQ(batch.getThreadCount(), 2u);
+}
+
+TEST_F(BatchSimulationTest, StepWritesObservationsForEveryWorld) {
+    BatchSimulation batch(worldCount, 1, 4);
+    std::vector<PayloadSimAction> actions(worldCount, idleAction());
+
+    batch.step(actions.data(), 0.016f, observations.data(), rewards.data());
+
+    for (uint32_t i = 0; i < worldCount; ++i) {
+        const float* obs = observations.data() + i * PAYLOAD_SIM_OBSERVATION_SIZE;
+        EXPECT_GT(obs[PAYLOAD_SIM_OBS_OPTIMAL_DEPTH], 0.0f);
+        EXPECT_FLOAT_EQ(obs[PAYLOAD_SIM_OBS_BATTERY_LEVEL], 1.0f);
+        // contacts spawn on the first tick
+        EXPECT_GE(obs[PAYLOAD_SIM_OBS_CONTACTS + 2], 0.0f);
+        EXPECT_FLOAT_EQ(rewards[i], 0.0f);
+    }
+}
+
+TEST_F(BatchSimulationTest, SameSeedProducesSameObservations) {
+    BatchSimulation first(worldCount, 42, 1);
+    BatchSimulation second(worldCount, 42, 4);
+    std::vector<float> otherObservations(observations.size());
+
+    for (int tick = 0; tick < 30; ++tick) {
+        first.step(nullptr, 0.016f, observations.data(), nullptr);
+        second.step(nullptr, 0.016f, otherObservations.data(), nullptr);
+    }
+
+    EXPECT_EQ(observations, otherObservations);
+}
+
+TEST_F(BatchSimulationTest, ActionsDriveEachWorldIndependently) {
+    BatchSimulation batch(2, 7, 2);
+    std::vector<PayloadSimAction> actions(2, idleAction());
+    actions[0].weaponsPower = 1;
+    actions[1].depthThrottle = 1.0f;
+
+    std::vector<float> obs(2 * PAYLOAD_SIM_OBSERVATION_SIZE);
+    batch.step(nullptr, 0.016f, obs.data(), nullptr);
+    const float depthBefore = obs[PAYLOAD_SIM_OBSERVATION_SIZE + PAYLOAD_SIM_OBS_CURRENT_DEPTH];
+
+    batch.step(actions.data(), 1.0f, obs.data(), nullptr);
+
+    EXPECT_FLOAT_EQ(obs[PAYLOAD_SIM_OBS_POWER_SUPPLY_STABLE], 1.0f);
+    EXPECT_FLOAT_EQ(obs[PAYLOAD_SIM_OBSERVATION_SIZE + PAYLOAD_SIM_OBS_POWER_SUPPLY_STABLE], 0.0f);
+    EXPECT_GT(obs[PAYLOAD_SIM_OBSERVATION_SIZE + PAYLOAD_SIM_OBS_CURRENT_DEPTH], depthBefore);
+}
+
+TEST_F(BatchSimulationTest, SelectContactActionTracksContact) {
+    BatchSimulation batch(1, 3, 1);
+    std::vector<float> obs(PAYLOAD_SIM_OBSERVATION_SIZE);
+    batch.step(nullptr, 0.016f, obs.data(), nullptr);
+
+    PayloadSimAction action = idleAction();
+    action.selectContact = 1;
+    action.targetX = obs[PAYLOAD_SIM_OBS_CONTACTS + 0];
+    action.targetY = obs[PAYLOAD_SIM_OBS_CONTACTS + 1];
+    batch.step(&action, 0.0f, obs.data(), nullptr);
+
+    EXPECT_FLOAT_EQ(obs[PAYLOAD_SIM_OBS_TARGET_ACQUIRED], 1.0f);
+    EXPECT_FLOAT_EQ(obs[PAYLOAD_SIM_OBS_CONTACTS + 3], 1.0f);
+}
+
+TEST_F(BatchSimulationTest, CApiRoundTrip) {
+    PayloadSimBatch* batch = payload_sim_batch_create(worldCount, 5, 2);
+    ASSERT_NE(batch, nullptr);
+    EXPECT_EQ(payload_sim_batch_world_count(batch), worldCount);
+    EXPECT_EQ(payload_sim_observation_size(), static_cast<uint32_t>(PAYLOAD_SIM_OBSERVATION_SIZE));
+
+    payload_sim_batch_step(batch, nullptr, 0.016f, observations.data(), rewards.data());
+    payload_sim_batch_reset(batch, 5);
+    payload_sim_batch_observe(batch, observations.data());
+
+    payload_sim_batch_destroy(batch);
+}
+
+TEST_F(BatchSimulationTest, RunForDrainsBatteryInOneCall) {
+    BatchSimulation batch(2, 9, 2);
+    std::vector<PayloadSimAction> actions(2, idleAction());
+    actions[0].weaponsPower = 1;
+    batch.step(actions.data(), 0.016f, nullptr, nullptr);
+
+    // the battery lasts 25 s on power
+    std::vector<float> obs(2 * PAYLOAD_SIM_OBSERVATION_SIZE);
+    batch.runFor(30.0f, 1.0f / 60.0f, obs.data());
+
+    EXPECT_FLOAT_EQ(obs[PAYLOAD_SIM_OBS_BATTERY_LEVEL], 0.0f);
+    EXPECT_FLOAT_EQ(obs[PAYLOAD_SIM_OBS_POWER_SUPPLY_STABLE], 0.0f);
+    EXPECT_FLOAT_EQ(obs[PAYLOAD_SIM_OBSERVATION_SIZE + PAYLOAD_SIM_OBS_BATTERY_LEVEL], 1.0f);
+}
+
+TEST_F(BatchSimulationTest, RunForPaysOutItsOwnKills) {
+    BatchSimulation batch(1, 3, 1);
+    std::vector<float> obs(PAYLOAD_SIM_OBSERVATION_SIZE);
+    batch.step(nullptr, 0.016f, obs.data(), nullptr);
+
+    // lock the nearest track and fire at it, then let run_for play it out
+    PayloadSimAction action = idleAction();
+    action.selectContact = 1;
+    action.targetX = obs[PAYLOAD_SIM_OBS_CONTACTS + 0];
+    action.targetY = obs[PAYLOAD_SIM_OBS_CONTACTS + 1];
+    batch.step(&action, 0.0f, nullptr, nullptr);
+    SimulationWorld& world = batch.getWorld(0);
+    const uint32_t trackedId = world.getCrosshairManager().getTrackedContactId();
+    const auto& contacts = world.getContactManager().getActiveContacts();
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        if (contacts[i].id == trackedId) world.getMissileManager().launchMissile({0.0f, 0.0f}, static_cast<uint32_t>(i));
+    }
+
+    float reward = 0.0f;
+    batch.runFor(20.0f, 1.0f / 60.0f, nullptr, &reward);
+    const MissileSystem& missiles = world.getMissileSystem();
+    ASSERT_GT(missiles.getEnemyKills() + missiles.getFriendlyKills(), 0u);
+    EXPECT_FLOAT_EQ(reward, static_cast<float>(missiles.getEnemyKills()) -
+                                static_cast<float>(missiles.getFriendlyKills()));
+
+    // the next step is not credited with them again
+    batch.step(nullptr, 0.016f, nullptr, &reward);
+    EXPECT_FLOAT_EQ(reward, 0.0f);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+#include "sim/batch/WorkerPool.h"
+
+TEST(WorkerPoolTest, RunsEveryIndexOncePerCall) {
+    WorkerPool pool(4);
+    std::vector<std::atomic<int>> hits(pool.getThreadCount());
+    auto task = [&](size_t index) { hits[index].fetch_add(1); };
+
+    for (int call = 0; call < 100; ++call) {
+        pool.run(task);
+    }
+
+    for (const auto& count : hits) {
+        EXPECT_EQ(count.load(), 100);
+    }
+}
+
+TEST(WorkerPoolTest, ReusesTheSameThreadsAcrossCalls) {
+    WorkerPool pool(3);
+    std::vector<std::thread::id> first(pool.getThreadCount());
+    std::vector<std::thread::id> later(pool.getThreadCount());
+    auto recordFirst = [&](size_t index) { first[index] = std::this_thread::get_id(); };
+    auto recordLater = [&](size_t index) { later[index] = std::this_thread::get_id(); };
+
+    pool.run(recordFirst);
+    for (int call = 0; call < 20; ++call) {
+        pool.run(recordLater);
+    }
+
+    EXPECT_EQ(first, later);
+    EXPECT_EQ(first[0], std::this_thread::get_id());
+    EXPECT_EQ(std::set<std::thread::id>(first.begin(), first.end()).size(), 3u);
+}
+
+TEST(WorkerPoolTest, SingleThreadRunsOnTheCaller) {
+    WorkerPool pool(1);
+    std::thread::id ran;
+    auto task = [&](size_t) { ran = std::this_thread::get_id(); };
+
+    pool.run(task);
+
+    EXPECT_EQ(pool.getThreadCount(), 1u);
+    EXPECT_EQ(ran, std::this_thread::get_id());
+}
@@ -116,3 +116,16 @@ TEST_F(DepthSystemTest, ClearanceToleranceWorksCorrectly) {
     depthSystem.update(state, 0.016f);
     EXPECT_FALSE(state.depthClearanceMet);
 }
+
+TEST_F(DepthSystemTest, ReportsTheNextClearanceEdge) {
+    EXPECT_EQ(depthSystem.getNextDeadline(state), ISystem::NO_DEADLINE);
+
+    const float optimalDepth = depthSystem.getOptimalDepth();
+    depthSystem.setDepth(optimalDepth - 20.0f);
+    depthSystem.setDepthChange(1.0f);
+    const float deadline = depthSystem.getNextDeadline(state);
+    EXPECT_NEAR(deadline, 15.0f / 16.67f, 1e-3f);
+
+    depthSystem.update(state, deadline);
+    EXPECT_TRUE(state.depthClearanceMet);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "sim/systems/EnvironmentSystem.h"
+#include "sim/SimulationState.h"
+
+TEST(EnvironmentSystemTest, FavorableWithinLaunchLimits) {
+    EnvironmentSystem environment(4);
+    environment.setLaunchLimits({ 100.0f, 100.0f });
+    SimulationState state;
+    state.launchConditionsFavorable = false;
+
+    environment.update(state, 0.1f);
+    EXPECT_TRUE(state.launchConditionsFavorable);
+    EXPECT_TRUE(state.launchTubeIntegrity);
+}
+
+TEST(EnvironmentSystemTest, RoughSeaBlocksLaunch) {
+    EnvironmentSystem environment(4);
+    SimulationState state;
+    environment.setLaunchLimits({ environment.getSeaState() - 0.01f, 100.0f });
+
+    environment.update(state, 0.0f);
+    EXPECT_FALSE(state.launchConditionsFavorable);
+}
+
+TEST(EnvironmentSystemTest, StrongCurrentBlocksLaunch) {
+    EnvironmentSystem environment(4);
+    SimulationState state;
+    environment.update(state, 0.0f);
+    ASSERT_GT(environment.getOwnShipCurrent(), 0.0f);
+
+    environment.setLaunchLimits({ 100.0f, environment.getOwnShipCurrent() * 0.5f });
+    environment.update(state, 0.0f);
+    EXPECT_FALSE(state.launchConditionsFavorable);
+}
+
+TEST(EnvironmentSystemTest, CurrentFieldRefreshesOnItsOwnSchedule) {
+    EnvironmentSystem environment(4);
+    SimulationState state;
+    const Vector2 probe = { 0, 0 };
+    const Vector2 before = environment.getCurrentField().sample(probe);
+
+    // a tick shorter than the refresh interval leaves the field alone
+    environment.update(state, EnvironmentSystem::REFRESH_INTERVAL * 0.5f);
+    EXPECT_EQ(environment.getCurrentField().sample(probe).x, before.x);
+
+    // a full turnover later every tile has been recomputed at the new time
+    const size_t refreshes = environment.getCurrentField().getTileCount() / EnvironmentSystem::TILES_PER_REFRESH + 1;
+    for (size_t i = 0; i < refreshes; ++i) {
+        environment.update(state, EnvironmentSystem::REFRESH_INTERVAL * 40.0f);
+    }
+    EXPECT_NE(environment.getCurrentField().sample(probe).x, before.x);
+}
+
+TEST(EnvironmentSystemTest, DeadlineLandsOnTheSeaStateCrossing) {
+    EnvironmentSystem environment(4);
+    // a limit inside the swell, and a current limit far out of reach
+    environment.setLaunchLimits({ 3.25f, 1.0e6f });
+    SimulationState state;
+    environment.update(state, 0.0f);
+    const bool before = state.launchConditionsFavorable;
+
+    const float deadline = environment.getNextDeadline(state);
+    ASSERT_GT(deadline, 1.0f);
+    ASSERT_LT(deadline, 1200.0f);
+
+    environment.update(state, deadline - 0.5f);
+    EXPECT_EQ(state.launchConditionsFavorable, before);
+    environment.update(state, 1.0f);
+    EXPECT_NE(state.launchConditionsFavorable, before);
+}
+
+TEST(EnvironmentSystemTest, FarLimitsAllowJumpsPastTileRefreshes) {
+    EnvironmentSystem environment(4);
+    environment.setLaunchLimits({ 100.0f, 100.0f });
+    SimulationState state;
+    environment.update(state, 0.0f);
+    EXPECT_GT(environment.getNextDeadline(state), 40.0f * EnvironmentSystem::REFRESH_INTERVAL);
+
+    // right at the current limit only the next refresh can change it
+    environment.setLaunchLimits({ 100.0f, environment.getOwnShipCurrent() });
+    const float deadline = environment.getNextDeadline(state);
+    EXPECT_GT(deadline, 0.0f);
+    EXPECT_LE(deadline, EnvironmentSystem::REFRESH_INTERVAL);
+}
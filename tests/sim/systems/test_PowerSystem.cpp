@@ -93,3 +93,15 @@ TEST_F(PowerSystemTest, PowerLevelReflectsBatteryPercentage) {
     float expectedPowerLevel = powerSystem.getBatteryLevel() / 100.0f;
     EXPECT_FLOAT_EQ(state.powerLevel, expectedPowerLevel);
 }
+
+TEST_F(PowerSystemTest, ReportsWhenTheBatteryRunsFlat) {
+    EXPECT_EQ(powerSystem.getNextDeadline(state), ISystem::NO_DEADLINE);
+
+    powerSystem.setPowerState(true);
+    EXPECT_FLOAT_EQ(powerSystem.getNextDeadline(state), 25.0f);
+
+    // one update straight to the deadline drains it
+    powerSystem.update(state, powerSystem.getNextDeadline(state));
+    EXPECT_EQ(powerSystem.getBatteryLevel(), 0.0f);
+    EXPECT_FALSE(state.powerSupplyStable);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "sim/FixedStepClock.h"
+
+TEST(FixedStepClockTest, RunsNoStepsUntilAFullStepElapses) {
+    FixedStepClock clock(60.0f);
+    EXPECT_EQ(clock.advance(0.01f), 0);
+    EXPECT_NEAR(clock.getAlpha(), 0.6f, 1e-4f);
+}
+
+TEST(FixedStepClockTest, HighRefreshFramesShareSimSteps) {
+    // 144 Hz frames against a 60 Hz sim: one second runs 60 steps
+    FixedStepClock clock(60.0f);
+    int steps = 0;
+    for (int i = 0; i < 144; ++i) {
+        steps += clock.advance(1.0f / 144.0f);
+        EXPECT_GE(clock.getAlpha(), 0.0f);
+        EXPECT_LT(clock.getAlpha(), 1.0f);
+    }
+    EXPECT_NEAR(steps, 60, 1);
+}
+
+TEST(FixedStepClockTest, LongFramesCatchUpWithMultipleSteps) {
+    FixedStepClock clock(60.0f);
+    EXPECT_EQ(clock.advance(0.05f), 3);
+}
+
+TEST(FixedStepClockTest, DropsBacklogBeyondMaxSteps) {
+    FixedStepClock clock(60.0f, 4);
+    EXPECT_EQ(clock.advance(1.0f), 4);
+    EXPECT_FLOAT_EQ(clock.getAlpha(), 0.0f);
+}
+
+TEST(FixedStepClockTest, TimeScaleRunsMoreStepsPerFrame) {
+    FixedStepClock clock(60.0f);
+    clock.setTimeScale(10.0f);
+    int steps = 0;
+    for (int i = 0; i < 60; ++i) steps += clock.advance(1.0f / 60.0f);
+    EXPECT_NEAR(steps, 600, 1);
+    EXPECT_EQ(clock.getDroppedSteps(), 0u);
+    EXPECT_NEAR(clock.getAchievedScale(), 10.0f, 0.1f);
+}
+
+TEST(FixedStepClockTest, TimeScaleIsClamped) {
+    FixedStepClock clock(60.0f);
+    clock.setTimeScale(1000.0f);
+    EXPECT_FLOAT_EQ(clock.getTimeScale(), FixedStepClock::MAX_TIME_SCALE);
+    clock.setTimeScale(0.0f);
+    EXPECT_FLOAT_EQ(clock.getTimeScale(), FixedStepClock::MIN_TIME_SCALE);
+}
+
+TEST(FixedStepClockTest, CostlyStepsAreDroppedAndCounted) {
+    FixedStepClock clock(60.0f, 4);
+    clock.setTimeScale(100.0f);
+    clock.setFrameBudgetMs(8.0f);
+    clock.reportStepCost(0.5f);
+    EXPECT_EQ(clock.getStepCap(), 16);
+
+    // 100 steps owed, 16 fit the budget
+    int steps = 0;
+    for (int i = 0; i < 30; ++i) steps += clock.advance(1.0f / 60.0f);
+    EXPECT_EQ(steps, 30 * 16);
+    EXPECT_EQ(clock.getDroppedSteps(), 30u * (100 - 16));
+    EXPECT_NEAR(clock.getAchievedScale(), 16.0f, 0.5f);
+}
+
+TEST(FixedStepClockTest, BudgetNeverCapsBelowRealTimeCatchUp) {
+    FixedStepClock clock(60.0f, 4);
+    clock.reportStepCost(100.0f);
+    EXPECT_EQ(clock.getStepCap(), 4);
+    EXPECT_EQ(clock.advance(0.05f), 3);
+}
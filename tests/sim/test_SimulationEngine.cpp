@@ -2,6 +2,9 @@
 #include "sim/SimulationEngine.h"
 #include "sim/ISystem.h"
 #include "sim/SimulationState.h"
+#include "sim/systems/DepthSystem.h"
+#include "sim/systems/PowerSystem.h"
+#include <vector>
 
 class MockSystem : public ISystem {
 public:
@@ -111,3 +114,98 @@ TEST_F(SimulationEngineTest, HandlesEmptySystemsList) {
     const auto& state = engine.getState();
     EXPECT_FALSE(state.targetAcquired);
 }
+
+TEST_F(SimulationEngineTest, PausedEngineSkipsSystemUpdates) {
+    auto mockSystem = std::make_shared<MockSystem>("TestSystem");
+    engine.registerSystem(mockSystem);
+    
+    engine.setPaused(true);
+    engine.update(0.016f);
+    EXPECT_TRUE(engine.isPaused());
+    EXPECT_EQ(mockSystem->getUpdateCount(), 0);
+    
+    engine.setPaused(false);
+    engine.update(0.016f);
+    EXPECT_EQ(mockSystem->getUpdateCount(), 1);
+}
+
+TEST_F(SimulationEngineTest, ReportsPerSystemTimingsWhenProfiling) {
+    auto first = std::make_shared<MockSystem>("First");
+    auto second = std::make_shared<MockSystem>("Second");
+    engine.registerSystem(first);
+    engine.registerSystem(second);
+    
+    engine.setProfiling(true);
+    engine.update(0.016f);
+    
+    ASSERT_EQ(engine.getSystemCount(), 2u);
+    EXPECT_STREQ(engine.getSystem(1).getName(), "Second");
+    EXPECT_GE(engine.getSystemTimeMs(0), 0.0f);
+    EXPECT_EQ(second->getUpdateCount(), 1);
+}
+
+class AnalyticSystem : public MockSystem {
+public:
+    AnalyticSystem() : MockSystem("Analytic") {}
+    bool integratesAnalytically() const override { return true; }
+    float getNextDeadline(const SimulationState& /*state*/) const override { return NO_DEADLINE; }
+};
+
+TEST_F(SimulationEngineTest, AnalyticSystemsFoldSubstepsIntoOneStep) {
+    auto analytic = std::make_shared<AnalyticSystem>();
+    auto stepped = std::make_shared<MockSystem>("Stepped");
+    engine.registerSystem(analytic);
+    engine.registerSystem(stepped);
+
+    for (int i = 0; i < 8; ++i) engine.substep(0.01f, i, 8);
+
+    EXPECT_EQ(analytic->getUpdateCount(), 1);
+    EXPECT_FLOAT_EQ(analytic->getLastDt(), 0.08f);
+    EXPECT_EQ(stepped->getUpdateCount(), 8);
+    EXPECT_FLOAT_EQ(stepped->getLastDt(), 0.01f);
+}
+
+// records the shared flags every later system sees on each substep
+class StateRecorder : public ISystem {
+public:
+    const char* getName() const override { return "Recorder"; }
+    void update(SimulationState& state, float /*dt*/) override {
+        clearance.push_back(state.depthClearanceMet);
+        powered.push_back(state.powerSupplyStable);
+    }
+    std::vector<bool> clearance, powered;
+};
+
+TEST_F(SimulationEngineTest, FoldedSystemsFlipFlagsOnTheRightSubstep) {
+    // one engine folds an accelerated frame, the other steps it
+    SimulationEngine stepped;
+    std::shared_ptr<DepthSystem> depths[2] = { std::make_shared<DepthSystem>(5u), std::make_shared<DepthSystem>(5u) };
+    std::shared_ptr<PowerSystem> powers[2] = { std::make_shared<PowerSystem>(), std::make_shared<PowerSystem>() };
+    std::shared_ptr<StateRecorder> recorders[2] = { std::make_shared<StateRecorder>(), std::make_shared<StateRecorder>() };
+    SimulationEngine* engines[2] = { &engine, &stepped };
+    for (int e = 0; e < 2; ++e) {
+        engines[e]->registerSystem(depths[e]);
+        engines[e]->registerSystem(powers[e]);
+        engines[e]->registerSystem(recorders[e]);
+        // the battery runs flat 1.1 s in, the band edge is 0.6 s ahead
+        powers[e]->setPowerState(true);
+        engines[e]->update(23.9f);
+        depths[e]->setDepth(depths[e]->getOptimalDepth() - 10.0f);
+        depths[e]->setDepthChange(0.5f);
+        recorders[e]->clearance.clear();
+        recorders[e]->powered.clear();
+    }
+
+    const float dt = 1.0f / 60.0f;
+    for (int i = 0; i < 100; ++i) engine.substep(dt, i, 100);
+    for (int i = 0; i < 100; ++i) stepped.update(dt);
+
+    EXPECT_EQ(recorders[0]->clearance, recorders[1]->clearance);
+    EXPECT_EQ(recorders[0]->powered, recorders[1]->powered);
+    // both flags changed partway through the frame
+    EXPECT_FALSE(recorders[0]->clearance.front());
+    EXPECT_TRUE(recorders[0]->clearance.back());
+    EXPECT_TRUE(recorders[0]->powered.front());
+    EXPECT_FALSE(recorders[0]->powered.back());
+    EXPECT_NEAR(depths[0]->getDepth(), depths[1]->getDepth(), 1e-2f);
+}
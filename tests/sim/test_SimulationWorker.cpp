@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include "sim/SimulationWorker.h"
+
+TEST(SimulationWorkerTest, StepsWorldWhileRunning) {
+    SimulationWorld world(1);
+    SimulationWorker worker(world, 200.0f);
+    worker.start();
+    EXPECT_TRUE(worker.isRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    worker.stop();
+
+    EXPECT_FALSE(worker.isRunning());
+    EXPECT_GT(worker.getStepCount(), 0u);
+    EXPECT_FALSE(world.getContactManager().getActiveContacts().empty());
+}
+
+TEST(SimulationWorkerTest, HoldingLockBlocksSteps) {
+    SimulationWorld world(1);
+    SimulationWorker worker(world, 200.0f);
+    worker.start();
+    {
+        auto lock = worker.lock();
+        const uint64_t before = worker.getStepCount();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_EQ(worker.getStepCount(), before);
+    }
+    worker.stop();
+}
+
+TEST(SimulationWorkerTest, AlphaStaysInRange) {
+    SimulationWorld world(1);
+    SimulationWorker worker(world, 60.0f);
+    SimulationSnapshot snapshot;
+    worker.start();
+    for (int i = 0; i < 20; ++i) {
+        worker.takeSnapshot(snapshot);
+        const float alpha = worker.getAlpha(snapshot);
+        EXPECT_GE(alpha, 0.0f);
+        EXPECT_LE(alpha, 1.0f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    }
+    worker.stop();
+}
+
+TEST(SimulationWorkerTest, SnapshotNeverWaitsOnAStep) {
+    SimulationWorld world(1);
+    SimulationWorker worker(world, 200.0f);
+    worker.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // holding the world stands in for a step in progress; taking the
+    // snapshot on this same thread would deadlock if it needed the world
+    auto lock = worker.lock();
+    SimulationSnapshot snapshot;
+    EXPECT_TRUE(worker.takeSnapshot(snapshot));
+    EXPECT_GT(snapshot.contactCount, 0u);
+    EXPECT_EQ(snapshot.trackPositions.size(), snapshot.trackTypes.size());
+    EXPECT_EQ(snapshot.systemTimes.size(), world.getEngine().getSystemCount());
+    // nothing newer can be published while the step is held
+    EXPECT_FALSE(worker.takeSnapshot(snapshot));
+    lock.unlock();
+    worker.stop();
+}
+
+TEST(SimulationWorkerTest, CommandsReachTheWorldBetweenSteps) {
+    SimulationWorld world(1);
+    SimulationCommandQueue commands;
+    SimulationWorker worker(world, 200.0f, &commands);
+    SimulationSnapshot snapshot;
+    worker.start();
+
+    commands.post([](SimulationWorld& w) { w.getPowerSystem().setPowerState(true); });
+    EXPECT_TRUE(commands.isAheadOf(snapshot));
+    for (int i = 0; i < 200 && commands.isAheadOf(snapshot); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        worker.takeSnapshot(snapshot);
+    }
+    worker.stop();
+
+    EXPECT_FALSE(commands.isAheadOf(snapshot));
+    EXPECT_EQ(snapshot.appliedCommands, 1u);
+    EXPECT_GT(snapshot.powerLevel, 0.5f);
+}
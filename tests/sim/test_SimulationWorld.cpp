@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "sim/SimulationWorld.h"
+#include "sim/systems/LaunchSequenceHandler/ArmingPhase.h"
+#include "sim/systems/LaunchSequenceHandler/ResettingPhase.h"
+
+TEST(SimulationWorldTest, ReportsPoolMemory) {
+    SimulationWorld world(1);
+    world.update(1.0f / 60.0f);
+
+    const WorldMemory memory = world.getMemory();
+    EXPECT_GT(memory.contacts, 0u);
+    EXPECT_GT(memory.detection, 0u);
+    EXPECT_GT(memory.currents, 0u);
+    EXPECT_EQ(memory.total(), memory.contacts + memory.missiles + memory.trails + memory.explosions +
+                                  memory.schooling + memory.detection + memory.tracks + memory.sweep +
+                                  memory.behaviors + memory.currents);
+}
+
+TEST(SimulationWorldTest, CaptureCopiesWhatTheUiShows) {
+    SimulationWorld world(3);
+    world.getPowerSystem().setPowerState(true);
+    for (int i = 0; i < 120; ++i) world.update(1.0f / 60.0f);
+    const SonarContact& contact = world.getContactManager().getActiveContacts().front();
+    world.getMissileManager().launchMissile({0.0f, 0.0f}, contact.id);
+    world.update(1.0f / 60.0f);
+
+    SimulationSnapshot snapshot;
+    world.capture(snapshot);
+    const ContactTracker& tracker = world.getSonarSystem().getTracker();
+    ASSERT_EQ(snapshot.trackPositions.size(), tracker.getTrackCount());
+    for (size_t i = 0; i < tracker.getTrackCount(); ++i) {
+        EXPECT_EQ(snapshot.trackPositions[i].x, tracker.getPosition(i).x);
+        EXPECT_EQ(snapshot.trackPreviousPositions[i].y, tracker.getPreviousPosition(i).y);
+    }
+    EXPECT_EQ(snapshot.contactCount, world.getContactManager().getActiveContacts().size());
+    EXPECT_EQ(snapshot.missiles.size(), 1u);
+    EXPECT_EQ(snapshot.powerLevel, world.getPowerSystem().getPowerLevel());
+    EXPECT_EQ(snapshot.batteryLevel, world.getPowerSystem().getBatteryLevel());
+    EXPECT_EQ(std::string(snapshot.launchPhase), world.getLaunchSequence().getCurrentPhaseString());
+    EXPECT_EQ(snapshot.memory.total(), world.getMemory().total());
+
+    // the snapshot keeps its picture while the world moves on
+    world.getPowerSystem().setPowerState(false);
+    world.getMissileManager().clearAllMissiles();
+    world.update(1.0f / 60.0f);
+    EXPECT_GT(snapshot.powerLevel, 0.5f);
+    EXPECT_EQ(snapshot.missiles.size(), 1u);
+}
+
+TEST(SimulationWorldTest, FixedFootprintStaysConstant) {
+    SimulationWorld world(7);
+    world.setFixedFootprint(ScenarioLimits{});
+    const WorldMemory reserved = world.getMemory();
+
+    // every pool a step touches is sized up front and reported
+    EXPECT_GT(reserved.schooling, 0u);
+    EXPECT_GT(reserved.detection, 0u);
+    EXPECT_GT(reserved.tracks, 0u);
+    EXPECT_GT(reserved.sweep, 0u);
+    EXPECT_GT(reserved.behaviors, 0u);
+    EXPECT_GT(reserved.currents, 0u);
+
+    // passive pings with a school of fish, then the sweep with a missile out
+    world.getContactManager().spawnSchool({ 100.0f, 50.0f }, 12);
+    for (int i = 0; i < 60 * 15; ++i) {
+        world.update(1.0f / 60.0f);
+    }
+    world.getSonarSystem().setMode(SonarMode::Sweep);
+    const SonarContact& target = world.getContactManager().getActiveContacts().front();
+    world.getMissileManager().launchMissile({ 0.0f, 0.0f }, target.id);
+    for (int i = 0; i < 60 * 15; ++i) {
+        world.update(1.0f / 60.0f);
+    }
+
+    const WorldMemory after = world.getMemory();
+    EXPECT_EQ(after.contacts, reserved.contacts);
+    EXPECT_EQ(after.missiles, reserved.missiles);
+    EXPECT_EQ(after.trails, reserved.trails);
+    EXPECT_EQ(after.explosions, reserved.explosions);
+    EXPECT_EQ(after.schooling, reserved.schooling);
+    EXPECT_EQ(after.detection, reserved.detection);
+    EXPECT_EQ(after.tracks, reserved.tracks);
+    EXPECT_EQ(after.sweep, reserved.sweep);
+    EXPECT_EQ(after.behaviors, reserved.behaviors);
+    EXPECT_EQ(after.currents, reserved.currents);
+    EXPECT_EQ(after.total(), reserved.total());
+}
+
+TEST(SimulationWorldTest, FixedFootprintRefusesContactsPastLimit) {
+    SimulationWorld world(3);
+    ScenarioLimits limits;
+    limits.maxContacts = 4;
+    world.setFixedFootprint(limits);
+
+    // the sonar wants at least ten contacts; the pool stops it at four
+    world.update(1.0f / 60.0f);
+    EXPECT_EQ(world.getContactManager().getActiveContacts().size(), 4u);
+    EXPECT_EQ(world.getContactManager().spawnContact(), 0u);
+}
+
+TEST(SimulationWorldTest, FixedFootprintMakesRoomForSchoolClutter) {
+    SimulationWorld world(5);
+    const SchoolClutter clutter{ 3, 200, 80.0f };
+    world.getContactManager().setSchoolClutter(clutter);
+    ScenarioLimits limits;
+    limits.maxSchooledFish = clutter.fish();
+    world.setFixedFootprint(limits);
+    const size_t footprint = world.getMemory().total();
+
+    // every school forms beside the usual population, in the reserved pools
+    world.update(1.0f / 60.0f);
+    EXPECT_EQ(world.getContactManager().getSchooledCount(), clutter.fish());
+    EXPECT_GE(world.getContactManager().getActiveContacts().size(), clutter.fish() + 10);
+    for (int i = 0; i < 60 * 10; ++i) {
+        world.update(1.0f / 60.0f);
+    }
+    EXPECT_EQ(world.getMemory().total(), footprint);
+}
+
+TEST(SimulationWorldTest, AcceleratedRunMatchesFixedSteps) {
+    SimulationWorld stepped(11);
+    SimulationWorld accelerated(11);
+    stepped.getPowerSystem().setPowerState(true);
+    accelerated.getPowerSystem().setPowerState(true);
+    stepped.getDepthSystem().setDepthChange(-0.5f);
+    accelerated.getDepthSystem().setDepthChange(-0.5f);
+
+    // 10 s at x50: one frame of 50 substeps per second of wall time
+    for (int i = 0; i < 600; ++i) stepped.update(1.0f / 60.0f);
+    for (int frame = 0; frame < 12; ++frame) accelerated.advance(1.0f / 60.0f, 50);
+
+    EXPECT_NEAR(accelerated.getPowerSystem().getBatteryLevel(), stepped.getPowerSystem().getBatteryLevel(), 1e-2f);
+    EXPECT_NEAR(accelerated.getDepthSystem().getDepth(), stepped.getDepthSystem().getDepth(), 1e-2f);
+    // contacts take every fixed step either way
+    const auto& a = accelerated.getContactManager().getActiveContacts();
+    const auto& b = stepped.getContactManager().getActiveContacts();
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].position.x, b[i].position.x);
+        EXPECT_EQ(a[i].position.y, b[i].position.y);
+    }
+}
+
+TEST(SimulationWorldTest, QuietWorldJumpsBetweenDeadlines) {
+    SimulationWorld world(21);
+    // subs hold their course, so only pings, spawns and the currents are scheduled
+    BehaviorParams params;
+    params.decisionInterval = 0.0f;
+    world.getSubmarineBehaviorSystem().getBehaviors().setParams(params);
+    const size_t updates = world.runFor(10.0f, 1.0f / 60.0f);
+    EXPECT_GT(updates, 0u);
+    EXPECT_LT(updates, 100u);
+    EXPECT_FALSE(world.getContactManager().getActiveContacts().empty());
+}
+
+TEST(SimulationWorldTest, LaunchTimersEndOnTheirDeadlines) {
+    SimulationWorld world(22);
+    SimulationState& state = world.getEngine().getState();
+    state.targetValidated = true;
+    state.targetAcquired = true;
+    state.depthClearanceMet = true;
+    state.launchTubeIntegrity = true;
+    state.powerSupplyStable = true;
+    state.noFriendlyUnitsInBlastRadius = true;
+    state.launchConditionsFavorable = true;
+
+    LaunchSequenceHandler& launch = world.getLaunchSequence();
+    launch.requestAuthorization();
+    const std::string code = launch.getAuthCode();
+    launch.submitAuthorization(code);
+    launch.requestArm();
+    ASSERT_EQ(launch.getCurrentPhase(), CurrentLaunchPhase::Arming);
+
+    world.runFor(ArmingPhase::ARMING_DURATION - 0.05f, 1.0f / 60.0f);
+    EXPECT_EQ(launch.getCurrentPhase(), CurrentLaunchPhase::Arming);
+    world.runFor(0.1f, 1.0f / 60.0f);
+    EXPECT_NE(launch.getCurrentPhase(), CurrentLaunchPhase::Arming);
+
+    // with no target the armed checks fail, and the reset runs out in one jump
+    world.runFor(ResettingPhase::RESET_DURATION + 0.1f, 1.0f / 60.0f);
+    EXPECT_EQ(launch.getCurrentPhase(), CurrentLaunchPhase::Idle);
+}
+
+TEST(SimulationWorldTest, SweepKeepsFixedSteps) {
+    SimulationWorld world(23);
+    world.getSonarSystem().setMode(SonarMode::Sweep);
+    const size_t updates = world.runFor(1.0f, 1.0f / 60.0f);
+    EXPECT_GE(updates, 60u);
+    EXPECT_LE(updates, 61u);
+}
+
+TEST(SimulationWorldTest, RunForMatchesFixedStepsWhileFishSchool) {
+    SimulationWorld stepped(24);
+    SimulationWorld skipping(24);
+    stepped.update(1.0f / 60.0f);
+    skipping.update(1.0f / 60.0f);
+    stepped.getContactManager().spawnSchool({0, 0}, 200, 60.0f);
+    skipping.getContactManager().spawnSchool({0, 0}, 200, 60.0f);
+
+    for (int i = 0; i < 120; ++i) stepped.update(1.0f / 60.0f);
+    const size_t updates = skipping.runFor(2.0f, 1.0f / 60.0f);
+    EXPECT_GE(updates, 120u);
+
+    const auto& a = skipping.getContactManager().getActiveContacts();
+    const auto& b = stepped.getContactManager().getActiveContacts();
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_NEAR(a[i].position.x, b[i].position.x, 1e-2f);
+        EXPECT_NEAR(a[i].position.y, b[i].position.y, 1e-2f);
+        EXPECT_NEAR(a[i].velocity.x, b[i].velocity.x, 1e-2f);
+        EXPECT_NEAR(a[i].velocity.y, b[i].velocity.y, 1e-2f);
+    }
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <vector>
 #include "sim/world/ContactManager.h"
 
 class ContactManagerTest : public ::testing::Test {
@@ -7,6 +8,20 @@ protected:
     
     void SetUp() override {
     }
+
+    // a single contact at exactly this position; a school of one with no spread
+    uint32_t placeContact(Vector2 position) {
+        contactManager.spawnSchool(position, 1, 0.0f);
+        return contactManager.getActiveContacts().back().id;
+    }
+
+    // a ping that hears every contact exactly where it is, so all are pickable
+    void detectAll() {
+        const size_t count = contactManager.getActiveContacts().size();
+        const std::vector<uint8_t> detected(count, 1);
+        const std::vector<Vector2> errors(count, Vector2{0.0f, 0.0f});
+        contactManager.applyDetections(detected.data(), errors.data(), 1);
+    }
 };
 
 TEST_F(ContactManagerTest, InitializesEmpty) {
@@ -53,8 +68,9 @@ TEST_F(ContactManagerTest, ClearsAllContacts) {
 }
 
 TEST_F(ContactManagerTest, FindsNearestContact) {
-    uint32_t closeContact = contactManager.addContact({10.0f, 10.0f}, ContactType::EnemySub, "Close");
-    uint32_t farContact = contactManager.addContact({100.0f, 100.0f}, ContactType::EnemySub, "Far");
+    uint32_t closeContact = placeContact({10.0f, 10.0f});
+    uint32_t farContact = placeContact({100.0f, 100.0f});
+    detectAll();
     
     uint32_t nearestId = contactManager.getNearestContactId({5.0f, 5.0f});
     
@@ -62,7 +78,8 @@ TEST_F(ContactManagerTest, FindsNearestContact) {
 }
 
 TEST_F(ContactManagerTest, ReturnsZeroWhenNoContactsInRange) {
-    contactManager.addContact({200.0f, 200.0f}, ContactType::EnemySub, "Far");
+    placeContact({200.0f, 200.0f});
+    detectAll();
     
     uint32_t nearestId = contactManager.getNearestContactId({0.0f, 0.0f}, 10.0f);
     
@@ -102,8 +119,8 @@ TEST_F(ContactManagerTest, SpawnsContactsToMaintainMinimum) {
 }
 
 TEST_F(ContactManagerTest, RemovesOutOfBoundsContacts) {
-    contactManager.addContact({-700.0f, 0.0f}, ContactType::EnemySub, "OutOfBounds");
-    contactManager.addContact({0.0f, 0.0f}, ContactType::EnemySub, "InBounds");
+    placeContact({-700.0f, 0.0f});
+    placeContact({0.0f, 0.0f});
     
     contactManager.removeOutOfBoundsContacts();
     
@@ -122,3 +139,15 @@ TEST_F(ContactManagerTest, UpdatesSpawnTimer) {
     size_t contactCount = contactManager.getActiveContacts().size();
     EXPECT_GT(contactCount, 10);
 }
+
+TEST_F(ContactManagerTest, KeepsPreviousPositionForInterpolation) {
+    contactManager.spawnContact();
+    const SonarContact spawned = contactManager.getActiveContacts()[0];
+    EXPECT_EQ(spawned.previousPosition.x, spawned.position.x);
+    EXPECT_EQ(spawned.previousPosition.y, spawned.position.y);
+
+    contactManager.updateContactPositions(0.1f);
+    const SonarContact& moved = contactManager.getActiveContacts()[0];
+    EXPECT_EQ(moved.previousPosition.x, spawned.position.x);
+    EXPECT_EQ(moved.previousPosition.y, spawned.position.y);
+}
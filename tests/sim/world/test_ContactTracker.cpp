@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "sim/world/ContactTracker.h"
+
+namespace {
+
+constexpr float PING = 0.5f;
+
+// marks every contact detected with no error, or none of them
+void detectAll(ContactManager& contacts, bool detected) {
+    const size_t count = contacts.getActiveContacts().size();
+    std::vector<uint8_t> flags(count, detected ? 1 : 0);
+    std::vector<Vector2> errors(count, Vector2{0, 0});
+    contacts.applyDetections(flags.data(), errors.data(), 2);
+}
+
+void ping(ContactManager& contacts, ContactTracker& tracker, bool detected = true) {
+    contacts.updateContactPositions(PING);
+    tracker.advance(PING);
+    detectAll(contacts, detected);
+    tracker.update(contacts);
+}
+
+}  // namespace
+
+TEST(ContactTrackerTest, EachDetectionStartsATrack) {
+    ContactManager contacts;
+    contacts.seed(1);
+    for (int i = 0; i < 6; ++i) contacts.spawnContact();
+    ContactTracker tracker;
+    detectAll(contacts, true);
+    tracker.update(contacts);
+
+    ASSERT_EQ(tracker.getTrackCount(), contacts.getActiveContacts().size());
+    for (const SonarContact& c : contacts.getActiveContacts()) {
+        const size_t track = tracker.findTrack(c.id);
+        ASSERT_NE(track, ContactTracker::NO_TRACK);
+        EXPECT_FLOAT_EQ(tracker.getPosition(track).x, c.position.x);
+        EXPECT_EQ(tracker.getType(track), c.type);
+    }
+}
+
+TEST(ContactTrackerTest, LearnsVelocityAndKeepsIdentity) {
+    ContactManager contacts;
+    contacts.seed(2);
+    for (int i = 0; i < 8; ++i) contacts.spawnContact();
+    ContactTracker tracker;
+    detectAll(contacts, true);
+    tracker.update(contacts);
+
+    std::vector<uint32_t> firstIds;
+    for (const SonarContact& c : contacts.getActiveContacts()) {
+        firstIds.push_back(tracker.getTrackId(tracker.findTrack(c.id)));
+    }
+    for (int i = 0; i < 12; ++i) ping(contacts, tracker);
+
+    const auto& active = contacts.getActiveContacts();
+    ASSERT_EQ(tracker.getTrackCount(), active.size());
+    for (size_t i = 0; i < active.size(); ++i) {
+        const size_t track = tracker.findTrack(active[i].id);
+        ASSERT_NE(track, ContactTracker::NO_TRACK);
+        EXPECT_EQ(tracker.getTrackId(track), firstIds[i]);
+        EXPECT_NEAR(tracker.getVelocity(track).x, active[i].velocity.x, 1.0f);
+        EXPECT_NEAR(tracker.getVelocity(track).y, active[i].velocity.y, 1.0f);
+    }
+}
+
+TEST(ContactTrackerTest, CoastsOnItsEstimateThenDrops) {
+    ContactManager contacts;
+    contacts.seed(3);
+    contacts.spawnContact();
+    ContactTracker tracker;
+    detectAll(contacts, true);
+    tracker.update(contacts);
+    for (int i = 0; i < 12; ++i) ping(contacts, tracker);
+
+    // between pings and through missed pings the estimate moves on
+    const SonarContact& c = contacts.getActiveContacts().front();
+    for (uint8_t missed = 1; missed <= tracker.getParams().maxMisses; ++missed) {
+        ping(contacts, tracker, false);
+        ASSERT_EQ(tracker.getTrackCount(), 1u);
+        EXPECT_EQ(tracker.getMisses(0), missed);
+        EXPECT_NEAR(tracker.getPosition(0).x, c.position.x, 1.0f);
+        EXPECT_NEAR(tracker.getPosition(0).y, c.position.y, 1.0f);
+    }
+    ping(contacts, tracker, false);
+    EXPECT_EQ(tracker.getTrackCount(), 0u);
+}
+
+TEST(ContactTrackerTest, UncertaintyShrinksWithUpdates) {
+    ContactManager contacts;
+    contacts.seed(4);
+    contacts.spawnContact();
+    ContactTracker tracker;
+    detectAll(contacts, true);
+    tracker.update(contacts);
+    const float initial = tracker.getPositionSigma(0);
+    for (int i = 0; i < 6; ++i) ping(contacts, tracker);
+    EXPECT_LT(tracker.getPositionSigma(0), initial);
+}
+
+TEST(ContactTrackerTest, ThousandsOfTracksAllAssociate) {
+    ContactManager contacts;
+    contacts.seed(5);
+    for (int i = 0; i < 5000; ++i) contacts.spawnContact();
+    ContactTracker tracker;
+    detectAll(contacts, true);
+    tracker.update(contacts);
+    ping(contacts, tracker);
+
+    // every detection of the crowded second ping lands on exactly one track;
+    // the few lost in a swap coast on. its cost is reported by
+    // tools/sim_benchmark (tracker_ms_per_ping_20k)
+    const size_t detections = contacts.getActiveContacts().size();
+    for (const SonarContact& c : contacts.getActiveContacts()) {
+        const size_t track = tracker.findTrack(c.id);
+        ASSERT_NE(track, ContactTracker::NO_TRACK);
+        EXPECT_EQ(tracker.getMisses(track), 0u);
+    }
+    size_t updated = 0;
+    for (size_t i = 0; i < tracker.getTrackCount(); ++i) {
+        if (tracker.getMisses(i) == 0) ++updated;
+    }
+    EXPECT_EQ(updated, detections);
+    EXPECT_LT(tracker.getTrackCount(), detections + detections / 100);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <unordered_set>
+#include <vector>
+#include "sim/world/ContactManager.h"
+
+namespace {
+
+// |mean velocity| / mean speed: 1 when every fish swims the same way
+float alignment(const ContactManager& contacts) {
+    float sumX = 0.0f, sumY = 0.0f, speed = 0.0f;
+    for (const SonarContact& c : contacts.getActiveContacts()) {
+        sumX += c.velocity.x;
+        sumY += c.velocity.y;
+        speed += std::sqrt(c.velocity.x * c.velocity.x + c.velocity.y * c.velocity.y);
+    }
+    return std::sqrt(sumX * sumX + sumY * sumY) / speed;
+}
+
+}  // namespace
+
+TEST(FishSchoolingTest, LoneFishKeepTheirCourse) {
+    ContactManager contacts;
+    contacts.seed(1);
+    contacts.spawnSchool({-300, 0}, 1);
+    contacts.spawnSchool({300, 0}, 1);
+    const Vector2 before = contacts.getActiveContacts()[0].velocity;
+
+    contacts.updateContactPositions(0.1f);
+    EXPECT_EQ(contacts.getActiveContacts()[0].velocity.x, before.x);
+    EXPECT_EQ(contacts.getActiveContacts()[0].velocity.y, before.y);
+}
+
+TEST(FishSchoolingTest, SchoolLinesUp) {
+    ContactManager contacts;
+    contacts.seed(2);
+    contacts.spawnSchool({0, 0}, 300, 60.0f);
+    const float before = alignment(contacts);
+
+    for (int i = 0; i < 120; ++i) contacts.updateContactPositions(1.0f / 30.0f);
+    const float after = alignment(contacts);
+    EXPECT_GT(after, before);
+    EXPECT_GT(after, 0.95f);
+
+    const SchoolingParams& params = contacts.getSchooling().getParams();
+    for (const SonarContact& c : contacts.getActiveContacts()) {
+        ASSERT_TRUE(std::isfinite(c.position.x) && std::isfinite(c.position.y));
+        EXPECT_LE(c.speed, params.maxSpeed + 1e-3f);
+        EXPECT_NEAR(c.speed, std::sqrt(c.velocity.x * c.velocity.x + c.velocity.y * c.velocity.y), 1e-3f);
+    }
+}
+
+TEST(FishSchoolingTest, CloseFishSpreadApart) {
+    ContactManager contacts;
+    contacts.seed(3);
+    contacts.spawnSchool({0, 0}, 2, 1.0f);
+    auto gap = [&]() {
+        const Vector2 a = contacts.getActiveContacts()[0].position;
+        const Vector2 b = contacts.getActiveContacts()[1].position;
+        return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+    };
+    const float before = gap();
+
+    for (int i = 0; i < 30; ++i) contacts.updateContactPositions(1.0f / 30.0f);
+    EXPECT_GT(gap(), before);
+}
+
+TEST(FishSchoolingTest, OnlyFishAreSteered) {
+    ContactManager contacts;
+    contacts.seed(4);
+    contacts.spawnSchool({0, 0}, 50, 30.0f);
+    for (int i = 0; i < 40; ++i) contacts.spawnContact();
+
+    std::vector<Vector2> before;
+    for (const SonarContact& c : contacts.getActiveContacts()) before.push_back(c.velocity);
+    contacts.updateContactPositions(0.1f);
+
+    for (size_t i = 0; i < before.size(); ++i) {
+        const SonarContact& c = contacts.getActiveContacts()[i];
+        if (c.type == ContactType::Fish) continue;
+        EXPECT_EQ(c.velocity.x, before[i].x);
+        EXPECT_EQ(c.velocity.y, before[i].y);
+    }
+}
+
+TEST(FishSchoolingTest, EveryContactGetsItsOwnId) {
+    ContactManager contacts;
+    contacts.seed(6);
+    contacts.spawnSchool({0, 0}, 1000, 80.0f);
+    for (int i = 0; i < 50; ++i) contacts.spawnContact();
+
+    std::unordered_set<uint32_t> ids;
+    for (const SonarContact& c : contacts.getActiveContacts()) {
+        EXPECT_NE(c.id, 0u);
+        ids.insert(c.id);
+    }
+    EXPECT_EQ(ids.size(), 1050u);
+
+    // removing one contact leaves the rest alone
+    contacts.removeContact(contacts.getActiveContacts()[500].id);
+    EXPECT_EQ(contacts.getActiveContacts().size(), 1049u);
+}
+
+TEST(FishSchoolingTest, FiveThousandFishOnlyReadNearbyCells) {
+    ContactManager contacts;
+    contacts.seed(5);
+    for (int s = 0; s < 10; ++s) {
+        contacts.spawnSchool({-450.0f + 100.0f * s, (s % 2) ? 150.0f : -150.0f}, 500, 80.0f);
+    }
+    contacts.updateContactPositions(1.0f / 60.0f);
+    contacts.updateContactPositions(1.0f / 60.0f);
+
+    // every fish binned once, padding aside, and each reads its 3x3 cells
+    // rather than the whole population. the time per tick is reported by
+    // tools/sim_benchmark (schooling_ms_per_tick_10k)
+    const FishSchooling& schooling = contacts.getSchooling();
+    const size_t fish = schooling.getFishCount();
+    EXPECT_EQ(fish, 5000u);
+    EXPECT_GE(schooling.getGridSlots(), fish);
+    EXPECT_LT(schooling.getGridSlots(), fish + fish / 4);
+    EXPECT_LT(schooling.getNeighbourSlotsRead(), fish * fish / 20);
+    EXPECT_EQ(schooling.getSteeredCount(), fish);
+}
+
+TEST(FishSchoolingTest, SpawnerKeepsSchoolClutterOnTheBoard) {
+    ContactManager contacts;
+    contacts.seed(9);
+    contacts.setSchoolClutter({ 2, 100, 60.0f });
+    contacts.spawnContactsIfNeeded();
+
+    // the usual population, plus both schools beside it
+    EXPECT_EQ(contacts.getSchooledCount(), 200u);
+    EXPECT_GE(contacts.getActiveContacts().size(), 210u);
+    EXPECT_EQ(contacts.getTimeToNextSpawn(), 1.5f);
+
+    // losing a whole school's worth forms a new one; losing less doesn't
+    std::vector<uint32_t> fish;
+    for (const SonarContact& c : contacts.getActiveContacts()) {
+        if (c.schooled) fish.push_back(c.id);
+    }
+    for (size_t i = 0; i < 99; ++i) contacts.removeContact(fish[i]);
+    contacts.spawnContactsIfNeeded();
+    EXPECT_EQ(contacts.getSchooledCount(), 101u);
+    contacts.removeContact(fish[99]);
+    EXPECT_EQ(contacts.getTimeToNextSpawn(), 0.0f);
+    contacts.spawnContactsIfNeeded();
+    EXPECT_EQ(contacts.getSchooledCount(), 200u);
+}
+
+TEST(FishSchoolingTest, SchoolClutterIsSeeded) {
+    ContactManager a, b;
+    a.seed(4);
+    b.seed(4);
+    a.setSchoolClutter({ 3, 50 });
+    b.setSchoolClutter({ 3, 50 });
+    a.spawnContactsIfNeeded();
+    b.spawnContactsIfNeeded();
+
+    ASSERT_EQ(a.getActiveContacts().size(), b.getActiveContacts().size());
+    for (size_t i = 0; i < a.getActiveContacts().size(); ++i) {
+        EXPECT_EQ(a.getActiveContacts()[i].position.x, b.getActiveContacts()[i].position.x);
+        EXPECT_EQ(a.getActiveContacts()[i].position.y, b.getActiveContacts()[i].position.y);
+    }
+}
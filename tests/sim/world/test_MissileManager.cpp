@@ -141,3 +141,54 @@ TEST_F(MissileManagerTest, HandlesOutOfBoundsMissiles) {
     
     EXPECT_EQ(missileManager.getActiveMissiles().size(), 0);
 }
+
+TEST_F(MissileManagerTest, KeepsPreviousPositionForInterpolation) {
+    missileManager.launchMissile({10.0f, 20.0f}, 0);
+    const Missile& launched = missileManager.getActiveMissiles()[0];
+    EXPECT_FLOAT_EQ(launched.previousPosition.x, 10.0f);
+    EXPECT_FLOAT_EQ(launched.previousPosition.y, 20.0f);
+
+    missileManager.updateMissilePhysics(0.1f, {});
+    const Missile& moved = missileManager.getActiveMissiles()[0];
+    EXPECT_FLOAT_EQ(moved.previousPosition.x, 10.0f);
+    EXPECT_FLOAT_EQ(moved.previousPosition.y, 20.0f);
+    EXPECT_NE(moved.position.x, moved.previousPosition.x);
+}
+
+TEST_F(MissileManagerTest, FixedFootprintRefusesLaunchesPastLimit) {
+    ScenarioLimits limits;
+    limits.maxMissiles = 2;
+    missileManager.setFixedFootprint(limits);
+
+    EXPECT_NE(missileManager.launchMissile({0.0f, 0.0f}, 0), 0u);
+    EXPECT_NE(missileManager.launchMissile({0.0f, 0.0f}, 0), 0u);
+    EXPECT_EQ(missileManager.launchMissile({0.0f, 0.0f}, 0), 0u);
+    EXPECT_EQ(missileManager.getActiveMissiles().size(), 2u);
+}
+
+TEST_F(MissileManagerTest, FixedFootprintPoolsDoNotGrow) {
+    ScenarioLimits limits;
+    limits.maxMissiles = 2;
+    limits.maxExplosions = 2;
+    missileManager.setFixedFootprint(limits);
+    const size_t missileBytes = missileManager.getMissileBytes();
+    const size_t trailBytes = missileManager.getTrailBytes();
+    const size_t explosionBytes = missileManager.getExplosionBytes();
+    EXPECT_GT(trailBytes, 0u);
+
+    // launch, fly, detonate and relaunch repeatedly
+    std::vector<Vector2> targets = {{200.0f, 0.0f}};
+    for (int round = 0; round < 5; ++round) {
+        missileManager.launchMissile({0.0f, 0.0f}, 0);
+        missileManager.launchMissile({0.0f, 0.0f}, 0);
+        for (int i = 0; i < 40; ++i) missileManager.updateMissilePhysics(0.05f, targets);
+        missileManager.explodeAllMissiles();
+        missileManager.explodeAllMissiles();
+        missileManager.updateExplosions(0.5f);
+    }
+
+    EXPECT_LE(missileManager.getActiveExplosions().size(), 2u);
+    EXPECT_EQ(missileManager.getMissileBytes(), missileBytes);
+    EXPECT_EQ(missileManager.getTrailBytes(), trailBytes);
+    EXPECT_EQ(missileManager.getExplosionBytes(), explosionBytes);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "sim/world/OceanCurrentField.h"
+#include "sim/world/WorldBounds.h"
+
+namespace {
+float length(Vector2 v) { return std::sqrt(v.x * v.x + v.y * v.y); }
+}
+
+TEST(OceanCurrentFieldTest, SameSeedGivesSameField) {
+    OceanCurrentField a, b;
+    a.seed(7);
+    b.seed(7);
+    for (Vector2 p : { Vector2{0, 0}, Vector2{-310, 122}, Vector2{580, -350} }) {
+        EXPECT_EQ(a.sample(p).x, b.sample(p).x);
+        EXPECT_EQ(a.sample(p).y, b.sample(p).y);
+    }
+}
+
+TEST(OceanCurrentFieldTest, SampleIsBilinearBetweenNodes) {
+    OceanCurrentField field;
+    field.seed(3);
+    const float cell = field.getParams().cellSize;
+
+    // node spacing lines up with the grid origin at (-HALF_WIDTH - margin, ...)
+    const float x0 = -WorldBounds::HALF_WIDTH - field.getParams().margin + 10.0f * cell;
+    const float y0 = -WorldBounds::HALF_HEIGHT - field.getParams().margin + 5.0f * cell;
+    const Vector2 a = field.sample({x0, y0});
+    const Vector2 b = field.sample({x0 + cell, y0});
+    const Vector2 c = field.sample({x0, y0 + cell});
+    const Vector2 d = field.sample({x0 + cell, y0 + cell});
+    const Vector2 mid = field.sample({x0 + 0.5f * cell, y0 + 0.5f * cell});
+    EXPECT_NEAR(mid.x, 0.25f * (a.x + b.x + c.x + d.x), 1e-4f);
+    EXPECT_NEAR(mid.y, 0.25f * (a.y + b.y + c.y + d.y), 1e-4f);
+}
+
+TEST(OceanCurrentFieldTest, BatchMatchesSinglePointsInEveryLane) {
+    OceanCurrentField field;
+    field.seed(11);
+
+    struct Body { Vector2 position; float padding[3]; };
+    std::vector<Body> bodies(37);
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        bodies[i].position = { -700.0f + 41.3f * i, 420.0f - 23.9f * i };   // some fall off the grid
+    }
+    std::vector<Vector2> out(bodies.size());
+    field.sample(&bodies[0].position, bodies.size(), sizeof(Body), out.data());
+
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        const Vector2 single = field.sample(bodies[i].position);
+        EXPECT_EQ(out[i].x, single.x) << "point " << i;
+        EXPECT_EQ(out[i].y, single.y) << "point " << i;
+    }
+}
+
+TEST(OceanCurrentFieldTest, CurrentsStayWithinTheirSpeeds) {
+    OceanCurrentField field;
+    field.seed(5);
+    const CurrentFieldParams& params = field.getParams();
+    // eddies overlap, so allow a couple of them on top of the tide
+    const float limit = params.tidalSpeed + 2.0f * params.eddySpeed;
+    float fastest = 0.0f;
+    for (float x = -WorldBounds::HALF_WIDTH; x <= WorldBounds::HALF_WIDTH; x += 17.0f) {
+        for (float y = -WorldBounds::HALF_HEIGHT; y <= WorldBounds::HALF_HEIGHT; y += 17.0f) {
+            fastest = std::max(fastest, length(field.sample({x, y})));
+        }
+    }
+    EXPECT_GT(fastest, params.eddySpeed * 0.5f);
+    EXPECT_LT(fastest, limit);
+}
+
+TEST(OceanCurrentFieldTest, RefreshIsIncrementalByTile) {
+    OceanCurrentField field;
+    field.seed(9);
+    const Vector2 firstTile = { -WorldBounds::HALF_WIDTH - field.getParams().margin + 1.0f,
+                                -WorldBounds::HALF_HEIGHT - field.getParams().margin + 1.0f };
+    const Vector2 elsewhere = { WorldBounds::HALF_WIDTH, WorldBounds::HALF_HEIGHT };
+    const Vector2 before = field.sample(firstTile);
+    const Vector2 otherBefore = field.sample(elsewhere);
+
+    // tiles go round robin from the first
+    field.refresh(300.0f, 1);
+    EXPECT_NE(field.sample(firstTile).x, before.x);
+    EXPECT_EQ(field.sample(elsewhere).x, otherBefore.x);
+
+    field.refresh(300.0f, field.getTileCount());
+    EXPECT_NE(field.sample(elsewhere).x, otherBefore.x);
+}
+
+TEST(OceanCurrentFieldTest, AdvectMovesPointsWithTheWater) {
+    OceanCurrentField field;
+    field.seed(2);
+    std::vector<Vector2> points = { {0, 0}, {100, -50}, {-250, 200}, {400, 10}, {-40, -300} };
+    const std::vector<Vector2> start = points;
+    field.advect(points.data(), points.size(), sizeof(Vector2), 0.5f);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Vector2 current = field.sample(start[i]);
+        EXPECT_FLOAT_EQ(points[i].x, start[i].x + current.x * 0.5f);
+        EXPECT_FLOAT_EQ(points[i].y, start[i].y + current.y * 0.5f);
+    }
+}
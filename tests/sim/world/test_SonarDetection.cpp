@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "sim/world/SonarDetection.h"
+
+namespace {
+
+void spawn(ContactManager& contacts, int count) {
+    for (int i = 0; i < count; ++i) contacts.spawnContact();
+}
+
+SonarDetectionParams loud() {
+    SonarDetectionParams p;
+    for (float& level : p.sourceLevelDb) level = 200.0f;
+    return p;
+}
+
+SonarDetectionParams silent() {
+    SonarDetectionParams p;
+    for (float& level : p.sourceLevelDb) level = 0.0f;
+    return p;
+}
+
+float length(Vector2 v) { return std::sqrt(v.x * v.x + v.y * v.y); }
+
+}  // namespace
+
+TEST(SonarDetectionTest, ContactsStartUndetected) {
+    ContactManager contacts;
+    contacts.seed(1);
+    spawn(contacts, 5);
+    for (const SonarContact& c : contacts.getActiveContacts()) {
+        EXPECT_FALSE(c.isVisible);
+    }
+}
+
+TEST(SonarDetectionTest, StrongSignalsAreAlwaysDetected) {
+    ContactManager contacts;
+    contacts.seed(2);
+    spawn(contacts, 50);
+    SonarDetectionModel model;
+    model.setParams(loud());
+    model.ping(contacts);
+
+    for (const SonarContact& c : contacts.getActiveContacts()) {
+        EXPECT_TRUE(c.isVisible);
+    }
+}
+
+TEST(SonarDetectionTest, ProbabilityFallsWithRange) {
+    ContactManager contacts;
+    contacts.seed(3);
+    spawn(contacts, 200);
+    SonarDetectionModel model;
+    SonarDetectionParams params;
+    params.aspectLossDb = 0.0f;
+    model.setParams(params);
+    model.setPropagation(SoundSpeedProfile::isovelocity());
+    model.ping(contacts);
+
+    // same type, no aspect term and no refraction: only range separates them
+    const auto& active = contacts.getActiveContacts();
+    const auto& probability = model.getLastProbabilities();
+    ASSERT_EQ(probability.size(), active.size());
+    for (size_t i = 0; i < active.size(); ++i) {
+        for (size_t j = 0; j < active.size(); ++j) {
+            if (active[i].type != active[j].type) continue;
+            if (length(active[i].position) + 1.0f < length(active[j].position)) {
+                EXPECT_GE(probability[i], probability[j]);
+            }
+        }
+    }
+}
+
+TEST(SonarDetectionTest, PerceivedPositionErrorIsBounded) {
+    ContactManager contacts;
+    contacts.seed(4);
+    spawn(contacts, 200);
+    SonarDetectionModel model;
+    model.seed(9);
+    const SonarDetectionParams& params = model.getParams();
+    model.ping(contacts);
+
+    // the noise is a sum of four uniforms, so it never passes 2 * sqrt(3) sigma
+    const float sigma = std::sqrt(params.rangeNoiseFraction * params.rangeNoiseFraction
+                                + params.bearingNoiseRad * params.bearingNoiseRad);
+    size_t withError = 0;
+    for (const SonarContact& c : contacts.getActiveContacts()) {
+        if (!c.isVisible) continue;
+        EXPECT_LE(length(c.detectionError), 3.47f * sigma * std::max(length(c.position), 1.0f) + 1e-3f);
+        if (length(c.detectionError) > 0.0f) ++withError;
+    }
+    EXPECT_GT(withError, 0u);
+}
+
+TEST(SonarDetectionTest, HoldsContactThroughMissedPings) {
+    ContactManager contacts;
+    contacts.seed(5);
+    spawn(contacts, 10);
+    SonarDetectionModel model;
+    model.setParams(loud());
+    model.ping(contacts);
+    const Vector2 perceived = contacts.getActiveContacts()[0].perceivedPosition();
+
+    SonarDetectionParams params = silent();
+    model.setParams(params);
+    for (int i = 0; i < params.holdPings; ++i) {
+        model.ping(contacts);
+        EXPECT_TRUE(contacts.getActiveContacts()[0].isVisible);
+    }
+    // the held contact keeps its last perceived offset
+    EXPECT_FLOAT_EQ(contacts.getActiveContacts()[0].perceivedPosition().x, perceived.x);
+
+    model.ping(contacts);
+    EXPECT_FALSE(contacts.getActiveContacts()[0].isVisible);
+}
+
+TEST(SonarDetectionTest, SameSeedGivesSameDetections) {
+    ContactManager a, b;
+    a.seed(6);
+    b.seed(6);
+    spawn(a, 100);
+    spawn(b, 100);
+    SonarDetectionModel modelA, modelB;
+    modelA.seed(11);
+    modelB.seed(11);
+    modelA.ping(a);
+    modelB.ping(b);
+
+    for (size_t i = 0; i < a.getActiveContacts().size(); ++i) {
+        EXPECT_EQ(a.getActiveContacts()[i].isVisible, b.getActiveContacts()[i].isVisible);
+        EXPECT_FLOAT_EQ(a.getActiveContacts()[i].detectionError.x, b.getActiveContacts()[i].detectionError.x);
+    }
+}
+
+TEST(SonarDetectionTest, VectorAndScalarPathsAgree) {
+    // the same first five contacts: in a batch of eight the fifth goes
+    // through the vector loop, in a batch of five through the scalar tail
+    ContactManager wide, narrow;
+    wide.seed(8);
+    narrow.seed(8);
+    spawn(wide, 8);
+    spawn(narrow, 5);
+    SonarDetectionModel wideModel, narrowModel;
+    wideModel.ping(wide);
+    narrowModel.ping(narrow);
+
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(wideModel.getLastProbabilities()[i], narrowModel.getLastProbabilities()[i]);
+        EXPECT_EQ(wide.getActiveContacts()[i].isVisible, narrow.getActiveContacts()[i].isVisible);
+        EXPECT_EQ(wide.getActiveContacts()[i].detectionError.x, narrow.getActiveContacts()[i].detectionError.x);
+        EXPECT_EQ(wide.getActiveContacts()[i].detectionError.y, narrow.getActiveContacts()[i].detectionError.y);
+    }
+}
+
+TEST(SonarDetectionTest, OwnDepthChangesWhatIsHeard) {
+    ContactManager contacts;
+    contacts.seed(9);
+    spawn(contacts, 200);
+    SonarDetectionModel model;
+
+    // in the surface duct the far contacts stay audible; down in the
+    // thermocline refraction bends the sound away from them
+    auto meanFarProbability = [&](float depth) {
+        model.setOwnDepth(depth);
+        model.ping(contacts);
+        float sum = 0.0f;
+        int far = 0;
+        for (size_t i = 0; i < contacts.getActiveContacts().size(); ++i) {
+            if (length(contacts.getActiveContacts()[i].position) < 400.0f) continue;
+            sum += model.getLastProbabilities()[i];
+            ++far;
+        }
+        return far > 0 ? sum / far : 0.0f;
+    };
+    EXPECT_GT(meanFarProbability(40.0f), meanFarProbability(250.0f));
+}
+
+TEST(SonarDetectionTest, SectorPingMatchesFullPing) {
+    // the sweep evaluates contacts a few at a time; each must get the
+    // same result it would in a full ping with the same count
+    ContactManager full, sectors;
+    full.seed(10);
+    sectors.seed(10);
+    spawn(full, 37);
+    spawn(sectors, 37);
+    SonarDetectionModel fullModel, sectorModel;
+    fullModel.ping(full);
+
+    sectorModel.startScan();
+    std::vector<uint32_t> odd, even;
+    for (uint32_t i = 0; i < 37; ++i) (i % 2 ? odd : even).push_back(i);
+    sectorModel.pingContacts(sectors, odd.data(), odd.size());
+    sectorModel.pingContacts(sectors, even.data(), even.size());
+
+    EXPECT_EQ(fullModel.getPingCount(), sectorModel.getPingCount());
+    for (size_t i = 0; i < 37; ++i) {
+        EXPECT_EQ(full.getActiveContacts()[i].isVisible, sectors.getActiveContacts()[i].isVisible);
+        EXPECT_EQ(full.getActiveContacts()[i].detectionError.x, sectors.getActiveContacts()[i].detectionError.x);
+        EXPECT_EQ(full.getActiveContacts()[i].detectionError.y, sectors.getActiveContacts()[i].detectionError.y);
+    }
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "sim/world/SonarSweep.h"
+
+namespace {
+
+void spawn(ContactManager& contacts, int count) {
+    for (int i = 0; i < count; ++i) contacts.spawnContact();
+}
+
+}  // namespace
+
+TEST(SonarSweepTest, OneRevolutionSweepsEveryContactOnce) {
+    ContactManager contacts;
+    contacts.seed(1);
+    spawn(contacts, 500);
+
+    SonarSweep sweep;
+    std::vector<int> hits(contacts.getActiveContacts().size(), 0);
+    int scans = 0;
+    for (int tick = 0; tick < 256; ++tick) {
+        if (sweep.advance(contacts, 4.0f / 256.0f)) ++scans;
+        for (uint32_t index : sweep.getSwept()) ++hits[index];
+    }
+
+    EXPECT_EQ(scans, 1);
+    for (int h : hits) EXPECT_EQ(h, 1);
+}
+
+TEST(SonarSweepTest, TickWorkFollowsTheSweptWedge) {
+    ContactManager contacts;
+    contacts.seed(2);
+    spawn(contacts, 4000);
+
+    SonarSweep sweep;
+    sweep.advance(contacts, 0.0f);
+    size_t most = 0;
+    for (int tick = 0; tick < 64; ++tick) {
+        sweep.advance(contacts, 4.0f / 64.0f);
+        most = std::max(most, sweep.getVisited());
+    }
+    // a 1/64 wedge of a box-shaped population, with room for the corners
+    EXPECT_GT(most, 0u);
+    EXPECT_LT(most, 4000u / 16);
+}
+
+TEST(SonarSweepTest, BeamTurnsClockwiseFromNorth) {
+    ContactManager contacts;
+    contacts.seed(3);
+    spawn(contacts, 200);
+
+    SonarSweep sweep;
+    sweep.advance(contacts, 1.0f);   // a quarter turn: north through east
+    EXPECT_NEAR(sweep.getBeamTurns(), 0.25f, 1e-5f);
+    ASSERT_FALSE(sweep.getSwept().empty());
+    for (uint32_t index : sweep.getSwept()) {
+        const Vector2 p = contacts.getActiveContacts()[index].position;
+        EXPECT_GE(p.x, 0.0f);
+        EXPECT_LE(p.y, 0.0f);
+    }
+}
+
+TEST(SonarSweepTest, RemovalRebuildsTheIndex) {
+    ContactManager contacts;
+    contacts.seed(4);
+    spawn(contacts, 100);
+
+    SonarSweep sweep;
+    sweep.advance(contacts, 1.0f);
+    for (int i = 0; i < 60; ++i) {
+        contacts.removeContact(contacts.getActiveContacts().front().id);
+    }
+
+    size_t swept = 0;
+    for (int tick = 0; tick < 4; ++tick) {
+        sweep.advance(contacts, 1.0f);
+        for (uint32_t index : sweep.getSwept()) {
+            ASSERT_LT(index, contacts.getActiveContacts().size());
+        }
+        swept += sweep.getSwept().size();
+    }
+    EXPECT_EQ(swept, contacts.getActiveContacts().size());
+}
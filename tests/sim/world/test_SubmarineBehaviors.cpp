@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "sim/world/SubmarineBehaviors.h"
+
+namespace {
+
+bool isSub(const SonarContact& c) {
+    return c.type == ContactType::EnemySub || c.type == ContactType::FriendlySub;
+}
+
+void spawn(ContactManager& contacts, int count) {
+    for (int i = 0; i < count; ++i) contacts.spawnContact();
+}
+
+}  // namespace
+
+TEST(SubmarineBehaviorsTest, DecisionsAreSpreadOverTheInterval) {
+    ContactManager contacts;
+    contacts.seed(1);
+    spawn(contacts, 600);
+    SubmarineBehaviors behaviors;
+    behaviors.seed(1);
+
+    size_t total = 0, most = 0;
+    for (int tick = 0; tick < 60; ++tick) {
+        behaviors.update(contacts, {}, 1.0f / 60.0f);
+        total += behaviors.getDecisionCount();
+        most = std::max(most, behaviors.getDecisionCount());
+    }
+    const size_t subs = behaviors.getSubCount();
+    ASSERT_GT(subs, 100u);
+    // every sub once a second, a sixtieth of them per tick
+    EXPECT_NEAR(static_cast<double>(total), static_cast<double>(subs), 1.0);
+    EXPECT_LE(most, subs / 60 + 1);
+}
+
+TEST(SubmarineBehaviorsTest, OnlySubmarinesAreSteered) {
+    ContactManager contacts;
+    contacts.seed(2);
+    spawn(contacts, 100);
+    std::vector<Vector2> before;
+    for (const SonarContact& c : contacts.getActiveContacts()) before.push_back(c.velocity);
+
+    SubmarineBehaviors behaviors;
+    behaviors.seed(2);
+    for (int tick = 0; tick < 120; ++tick) behaviors.update(contacts, {}, 1.0f / 60.0f);
+
+    size_t steered = 0;
+    for (size_t i = 0; i < before.size(); ++i) {
+        const SonarContact& c = contacts.getActiveContacts()[i];
+        const bool changed = c.velocity.x != before[i].x || c.velocity.y != before[i].y;
+        if (!isSub(c)) EXPECT_FALSE(changed);
+        steered += changed ? 1 : 0;
+    }
+    EXPECT_GT(steered, 0u);
+}
+
+TEST(SubmarineBehaviorsTest, EnemiesCloseOnOwnShip) {
+    ContactManager contacts;
+    contacts.seed(3);
+    spawn(contacts, 200);
+    SubmarineBehaviors behaviors;
+    behaviors.seed(3);
+    for (int tick = 0; tick < 60 * 10; ++tick) behaviors.update(contacts, {}, 1.0f / 60.0f);
+
+    const BehaviorParams& params = behaviors.getParams();
+    size_t closing = 0;
+    for (size_t i = 0; i < contacts.getActiveContacts().size(); ++i) {
+        const SonarContact& c = contacts.getActiveContacts()[i];
+        if (c.type != ContactType::EnemySub) continue;
+        const float range = std::sqrt(c.position.x * c.position.x + c.position.y * c.position.y);
+        if (range >= params.closeRange || range <= params.standoffRange) continue;
+        EXPECT_EQ(behaviors.getBehavior(i), SubBehavior::Close);
+        // heading in toward the origin
+        EXPECT_LT(c.velocity.x * c.position.x + c.velocity.y * c.position.y, 0.0f);
+        ++closing;
+    }
+    EXPECT_GT(closing, 0u);
+}
+
+TEST(SubmarineBehaviorsTest, SubmarinesRunFromMissiles) {
+    ContactManager contacts;
+    contacts.seed(4);
+    spawn(contacts, 200);
+    SubmarineBehaviors behaviors;
+    behaviors.seed(4);
+    const std::vector<Vector2> missile = { {0, 0} };
+    for (int tick = 0; tick < 60 * 10; ++tick) behaviors.update(contacts, missile, 1.0f / 60.0f);
+
+    size_t running = 0;
+    for (size_t i = 0; i < contacts.getActiveContacts().size(); ++i) {
+        const SonarContact& c = contacts.getActiveContacts()[i];
+        if (!isSub(c)) continue;
+        const float range = std::sqrt(c.position.x * c.position.x + c.position.y * c.position.y);
+        if (range >= behaviors.getParams().evadeRange) continue;
+        EXPECT_EQ(behaviors.getBehavior(i), SubBehavior::Evade);
+        EXPECT_GT(c.velocity.x * c.position.x + c.velocity.y * c.position.y, 0.0f);
+        ++running;
+    }
+    EXPECT_GT(running, 0u);
+}
+
+TEST(SubmarineBehaviorsTest, StateFollowsContactsAcrossRemovals) {
+    ContactManager contacts;
+    contacts.seed(5);
+    spawn(contacts, 80);
+    SubmarineBehaviors behaviors;
+    behaviors.seed(5);
+    for (int tick = 0; tick < 60; ++tick) behaviors.update(contacts, {}, 1.0f / 60.0f);
+
+    // remember every patrolling sub's waypoint by contact, then drop the first half
+    const auto& active = contacts.getActiveContacts();
+    std::vector<uint32_t> keepIds;
+    std::vector<Vector2> keepWaypoints;
+    for (size_t i = active.size() / 2; i < active.size(); ++i) {
+        if (!isSub(active[i]) || behaviors.getBehavior(i) != SubBehavior::Patrol) continue;
+        keepIds.push_back(active[i].id);
+        keepWaypoints.push_back(behaviors.getWaypoint(i));
+    }
+    ASSERT_FALSE(keepIds.empty());
+    while (contacts.getActiveContacts().size() > 40) {
+        contacts.removeContact(contacts.getActiveContacts().front().id);
+    }
+    behaviors.update(contacts, {}, 0.0f);
+
+    size_t found = 0;
+    for (size_t i = 0; i < contacts.getActiveContacts().size(); ++i) {
+        for (size_t k = 0; k < keepIds.size(); ++k) {
+            if (contacts.getActiveContacts()[i].id != keepIds[k]) continue;
+            EXPECT_EQ(behaviors.getWaypoint(i).x, keepWaypoints[k].x);
+            EXPECT_EQ(behaviors.getWaypoint(i).y, keepWaypoints[k].y);
+            ++found;
+        }
+    }
+    EXPECT_EQ(found, keepIds.size());
+}
+
+TEST(SubmarineBehaviorsTest, HundredsOfSubmarinesStaggerTheirDecisions) {
+    ContactManager contacts;
+    contacts.seed(6);
+    spawn(contacts, 2000);
+    SubmarineBehaviors behaviors;
+    behaviors.seed(6);
+    const std::vector<Vector2> missiles = { {100, 0}, {-200, 50} };
+    behaviors.update(contacts, missiles, 1.0f / 60.0f);
+
+    // one decision interval: each tick decides for about a sixtieth of the
+    // subs, and every sub gets its turn once. the time per tick is
+    // reported by tools/sim_benchmark (behaviors_ms_per_tick_2k)
+    const size_t subs = behaviors.getSubCount();
+    ASSERT_GT(subs, 500u);
+    const size_t perTick = (subs + 59) / 60;
+    size_t total = 0;
+    for (int tick = 0; tick < 60; ++tick) {
+        behaviors.update(contacts, missiles, 1.0f / 60.0f);
+        EXPECT_LE(behaviors.getDecisionCount(), perTick + 1);
+        total += behaviors.getDecisionCount();
+    }
+    EXPECT_EQ(total, subs);
+}
+
+TEST(SubmarineBehaviorsTest, DeadlineWaitsForSubsToSettle) {
+    ContactManager contacts;
+    contacts.seed(7);
+    spawn(contacts, 100);
+    SubmarineBehaviors behaviors;
+    behaviors.seed(7);
+
+    // nothing is known about the contacts until the first update
+    EXPECT_EQ(behaviors.getNextDeadline(contacts), 0.0f);
+    for (int tick = 0; tick < 30; ++tick) behaviors.update(contacts, {}, 1.0f / 60.0f);
+    ASSERT_GT(behaviors.getConvergingCount(), 0u);
+    EXPECT_EQ(behaviors.getNextDeadline(contacts), 0.0f);
+
+    // with decisions off every sub settles, and nothing else is scheduled
+    BehaviorParams params;
+    params.decisionInterval = 0.0f;
+    behaviors.setParams(params);
+    for (int tick = 0; tick < 60 * 10; ++tick) behaviors.update(contacts, {}, 1.0f / 60.0f);
+    EXPECT_EQ(behaviors.getConvergingCount(), 0u);
+    EXPECT_EQ(behaviors.getNextDeadline(contacts), std::numeric_limits<float>::infinity());
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "sim/world/TransmissionLossTable.h"
+
+TEST(TransmissionLossTableTest, IsovelocityIsSphericalSpreadingPlusAbsorption) {
+    TransmissionLossTable table;
+    table.build(SoundSpeedProfile::isovelocity());
+    const PropagationParams& params = table.getParams();
+
+    for (float range : {10.0f, 100.0f, 400.0f}) {
+        const float expected = 20.0f * std::log10(range) + params.absorptionDbPerUnit * range;
+        EXPECT_NEAR(table.lookup(120.0f, range), expected, 1e-3f);
+    }
+}
+
+TEST(TransmissionLossTableTest, LookupIsBilinearBetweenNodes) {
+    TransmissionLossTable table;
+    table.build(SoundSpeedProfile::typical());
+    const PropagationParams& params = table.getParams();
+
+    const float d0 = 200.0f, d1 = d0 + params.depthStepMeters;
+    const float r0 = 300.0f, r1 = r0 + params.rangeStep;
+    const float a = table.lookup(d0, r0), b = table.lookup(d0, r1);
+    const float c = table.lookup(d1, r0), d = table.lookup(d1, r1);
+    EXPECT_NEAR(table.lookup(0.5f * (d0 + d1), 0.5f * (r0 + r1)), 0.25f * (a + b + c + d), 1e-3f);
+}
+
+TEST(TransmissionLossTableTest, SampledRowMatchesLookup) {
+    TransmissionLossTable table;
+    table.build(SoundSpeedProfile::typical());
+    std::vector<float> row;
+    table.sampleDepth(137.0f, row);
+
+    ASSERT_EQ(row.size(), table.getColumns());
+    for (float range : {0.0f, 42.5f, 333.0f, 719.0f, 5000.0f}) {
+        EXPECT_NEAR(table.lookupRow(row.data(), range), table.lookup(137.0f, range), 1e-3f);
+    }
+}
+
+TEST(TransmissionLossTableTest, ThermoclineShadowsLongRange) {
+    TransmissionLossTable table;
+    table.build(SoundSpeedProfile::typical());
+    TransmissionLossTable flat;
+    flat.build(SoundSpeedProfile::isovelocity());
+
+    // the surface duct carries sound out to range; below the layer the
+    // negative gradient bends it down and away
+    EXPECT_NEAR(table.lookup(40.0f, 600.0f), flat.lookup(40.0f, 600.0f), 1.0f);
+    EXPECT_GT(table.lookup(250.0f, 600.0f), flat.lookup(250.0f, 600.0f) + 5.0f);
+    // close in, every depth hears the same
+    EXPECT_NEAR(table.lookup(250.0f, 50.0f), flat.lookup(250.0f, 50.0f), 1e-3f);
+}
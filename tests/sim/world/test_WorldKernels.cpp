@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "sim/world/WorldKernels.h"
+
+namespace {
+
+struct Body {
+    int tag;
+    Vector2 position;
+    Vector2 previous;
+    Vector2 velocity;
+};
+
+}  // namespace
+
+TEST(WorldKernelsTest, IntegratesContiguousPoints) {
+    std::vector<Vector2> positions = {{0, 0}, {1, 2}, {-3, 4}};
+    std::vector<Vector2> velocities = {{10, 0}, {0, -10}, {5, 5}};
+    WorldKernels::integrate(positions.data(), nullptr, velocities.data(), positions.size(), sizeof(Vector2), 0.5f);
+
+    EXPECT_FLOAT_EQ(positions[0].x, 5.0f);
+    EXPECT_FLOAT_EQ(positions[1].y, -3.0f);
+    EXPECT_FLOAT_EQ(positions[2].x, -0.5f);
+    EXPECT_FLOAT_EQ(positions[2].y, 6.5f);
+}
+
+TEST(WorldKernelsTest, IntegratesStridedFieldsAndKeepsPrevious) {
+    std::vector<Body> bodies(5);
+    for (int i = 0; i < 5; ++i) {
+        bodies[i] = { i, {(float)i, (float)-i}, {0, 0}, {1.0f, 2.0f} };
+    }
+    WorldKernels::integrate(&bodies[0].position, &bodies[0].previous, &bodies[0].velocity,
+                            bodies.size(), sizeof(Body), 1.0f);
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(bodies[i].tag, i);
+        EXPECT_FLOAT_EQ(bodies[i].previous.x, (float)i);
+        EXPECT_FLOAT_EQ(bodies[i].previous.y, (float)-i);
+        EXPECT_FLOAT_EQ(bodies[i].position.x, (float)i + 1.0f);
+        EXPECT_FLOAT_EQ(bodies[i].position.y, (float)-i + 2.0f);
+    }
+}
+
+TEST(WorldKernelsTest, FindsFirstPointWithinRadius) {
+    std::vector<Vector2> points;
+    for (int i = 0; i < 11; ++i) points.push_back({100.0f + i * 50.0f, 0.0f});
+
+    // every position, including the scalar tail, is found in order
+    for (int i = 0; i < 11; ++i) {
+        EXPECT_EQ(WorldKernels::firstWithinRadius(points.data(), points.size(), points[i], 10.0f), (size_t)i);
+    }
+    EXPECT_EQ(WorldKernels::firstWithinRadius(points.data(), points.size(), {0, 0}, 10.0f), points.size());
+    EXPECT_EQ(WorldKernels::firstWithinRadius(points.data(), 0, {0, 0}, 10.0f), 0u);
+}
+
+TEST(WorldKernelsTest, RadiusIsInclusive) {
+    std::vector<Vector2> points = {{3, 4}};
+    EXPECT_EQ(WorldKernels::firstWithinRadius(points.data(), 1, {0, 0}, 5.0f), 0u);
+    EXPECT_EQ(WorldKernels::firstWithinRadius(points.data(), 1, {0, 0}, 4.99f), 1u);
+}
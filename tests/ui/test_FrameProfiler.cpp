@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "ui/FrameProfiler.h"
+
+namespace {
+
+// stands in for the operator new counter, which only the app links
+uint64_t fakeAllocations = 0;
+uint64_t readFakeAllocations() { return fakeAllocations; }
+
+}  // namespace
+
+class FrameProfilerTest : public ::testing::Test {
+protected:
+    FrameProfiler profiler{ readFakeAllocations };
+};
+
+TEST_F(FrameProfilerTest, StartsWithEmptyHistory) {
+    EXPECT_EQ(profiler.getSampleCount(), 0u);
+    EXPECT_FLOAT_EQ(profiler.getAverageMs(FrameProfiler::SIM), 0.0f);
+    EXPECT_FLOAT_EQ(profiler.getPeakTotalMs(), 0.0f);
+}
+
+TEST_F(FrameProfilerTest, RecordsSectionsPerFrame) {
+    profiler.beginFrame();
+    profiler.mark(FrameProfiler::SIM);
+    profiler.mark(FrameProfiler::UI_UPDATE);
+    profiler.mark(FrameProfiler::DRAW);
+    profiler.endFrame();
+
+    ASSERT_EQ(profiler.getSampleCount(), 1u);
+    const FrameProfiler::Sample& sample = profiler.getSample(0);
+    EXPECT_GE(sample.sectionMs[FrameProfiler::SIM], 0.0f);
+    EXPECT_FLOAT_EQ(sample.totalMs(), sample.sectionMs[FrameProfiler::SIM]
+                                    + sample.sectionMs[FrameProfiler::UI_UPDATE]
+                                    + sample.sectionMs[FrameProfiler::DRAW]);
+}
+
+TEST_F(FrameProfilerTest, CountsAllocationsInFrame) {
+    fakeAllocations += 5;
+    profiler.beginFrame();
+    fakeAllocations += 2;
+    profiler.endFrame();
+
+    EXPECT_EQ(profiler.getSample(0).allocations, 2u);
+}
+
+TEST_F(FrameProfilerTest, HistoryIsBoundedAndNewestFirst) {
+    for (size_t i = 0; i < FrameProfiler::historySize + 10; ++i) {
+        profiler.beginFrame();
+        if (i % 2 == 0) {
+            ++fakeAllocations;
+        }
+        profiler.endFrame();
+    }
+
+    EXPECT_EQ(profiler.getSampleCount(), FrameProfiler::historySize);
+    // last frame index is odd, so it allocated nothing
+    EXPECT_EQ(profiler.getSample(0).allocations, 0u);
+    EXPECT_EQ(profiler.getSample(1).allocations, 1u);
+}
+
+TEST(AllocationCounterTest, OnlyTheAppReplacesOperatorNew) {
+    // the test build compiles AllocationCounter.cpp without the define
+    EXPECT_FALSE(isAllocationCountingEnabled());
+    EXPECT_EQ(getAllocationCount(), 0u);
+}
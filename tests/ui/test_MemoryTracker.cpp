@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "ui/MemoryTracker.h"
+
+TEST(MemoryTrackerTest, KeepsHighWaterMarks) {
+    MemoryTracker tracker;
+    WorldMemory small;
+    small.contacts = 100;
+    WorldMemory large;
+    large.contacts = 400;
+    large.trails = 50;
+
+    tracker.sample(small, 1000);
+    tracker.sample(large, 10);
+    tracker.sample(small, 10);
+
+    EXPECT_EQ(tracker.getCurrent().total(), 110u);
+    EXPECT_EQ(tracker.getPeak().world.contacts, 400u);
+    EXPECT_EQ(tracker.getPeak().uiCaches, 1000u);
+    EXPECT_EQ(tracker.getPeakTotal(), 1100u);
+}
+
+TEST(MemoryTrackerTest, TracksSimScratchPeaks) {
+    MemoryTracker tracker;
+    WorldMemory busy;
+    busy.tracks = 300;
+    busy.sweep = 200;
+    WorldMemory quiet;
+    quiet.tracks = 100;
+
+    tracker.sample(busy, 0);
+    tracker.sample(quiet, 0);
+
+    EXPECT_EQ(tracker.getCurrent().total(), 100u);
+    EXPECT_EQ(tracker.getPeak().world.tracks, 300u);
+    EXPECT_EQ(tracker.getPeak().world.sweep, 200u);
+    EXPECT_EQ(tracker.getPeakTotal(), 500u);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "ui/PointerDispatcher.h"
+
+// records the events it receives; handles them when `handles` is set
+class ProbeWidget : public Widget {
+public:
+    explicit ProbeWidget(Rectangle r, bool handles = true) : handles(handles) { setBounds(r); }
+
+    bool onMouseDown(Vector2) override { ++downs; return handles; }
+    bool onMouseUp(Vector2) override { ++ups; return handles; }
+    bool onMouseMove(Vector2) override { ++moves; return handles; }
+
+    void forEachChild(const std::function<void(Widget&)>& visit) override {
+        for (auto& child : children) visit(*child);
+    }
+
+    ProbeWidget* addChild(Rectangle r, bool childHandles = true) {
+        children.push_back(std::make_unique<ProbeWidget>(r, childHandles));
+        return children.back().get();
+    }
+
+    bool handles;
+    int downs = 0;
+    int ups = 0;
+    int moves = 0;
+    std::vector<std::unique_ptr<ProbeWidget>> children;
+};
+
+class PointerDispatcherTest : public ::testing::Test {
+protected:
+    ProbeWidget panel{{100, 100, 300, 200}, false};
+    ProbeWidget other{{500, 100, 100, 100}};
+    ProbeWidget* button = nullptr;
+    ProbeWidget* passive = nullptr;
+    PointerDispatcher pointer;
+
+    void SetUp() override {
+        button = panel.addChild({120, 120, 80, 40});
+        passive = panel.addChild({250, 120, 80, 40}, false);
+        pointer.rebuild({ &panel, &other });
+    }
+};
+
+TEST_F(PointerDispatcherTest, IndexFindsDeepestWidget) {
+    const HitTestIndex& index = pointer.getIndex();
+    EXPECT_EQ(index.size(), 4u);
+
+    int hit = index.hitTest({130, 130});
+    ASSERT_NE(hit, HitTestIndex::NO_HIT);
+    EXPECT_EQ(index.getWidget(hit), button);
+    EXPECT_EQ(index.getWidget(index.getParent(hit)), &panel);
+
+    EXPECT_EQ(index.getWidget(index.hitTest({300, 250})), &panel);
+    EXPECT_EQ(index.hitTest({450, 150}), HitTestIndex::NO_HIT);
+    EXPECT_EQ(index.hitTest({0, 0}), HitTestIndex::NO_HIT);
+}
+
+TEST_F(PointerDispatcherTest, PressReachesOnlyWidgetUnderCursor) {
+    EXPECT_EQ(pointer.mouseDown({130, 130}), button);
+    EXPECT_EQ(button->downs, 1);
+    EXPECT_EQ(panel.downs, 0);
+    EXPECT_EQ(passive->downs, 0);
+    EXPECT_EQ(other.downs, 0);
+}
+
+TEST_F(PointerDispatcherTest, UnhandledPressBubblesToParent) {
+    EXPECT_EQ(pointer.mouseDown({260, 130}), nullptr);
+    EXPECT_EQ(passive->downs, 1);
+    EXPECT_EQ(panel.downs, 1);
+    EXPECT_EQ(pointer.getCaptured(), nullptr);
+}
+
+TEST_F(PointerDispatcherTest, CapturedWidgetGetsMovesAndReleaseAnywhere) {
+    pointer.mouseDown({130, 130});
+    ASSERT_EQ(pointer.getCaptured(), button);
+
+    pointer.mouseMove({550, 150});
+    pointer.mouseUp({550, 150});
+
+    EXPECT_EQ(button->moves, 1);
+    EXPECT_EQ(button->ups, 1);
+    EXPECT_EQ(other.moves, 0);
+    EXPECT_EQ(other.ups, 0);
+    EXPECT_EQ(pointer.getCaptured(), nullptr);
+}
+
+TEST_F(PointerDispatcherTest, HoverMovesNotifyPreviousWidget) {
+    pointer.mouseMove({130, 130});
+    pointer.mouseMove({550, 150});
+
+    EXPECT_EQ(button->moves, 2);
+    EXPECT_EQ(other.moves, 1);
+    EXPECT_EQ(passive->moves, 0);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "ui/SonarCamera.h"
+
+class SonarCameraTest : public ::testing::Test {
+protected:
+    SonarCamera camera;
+
+    void SetUp() override {
+        camera.setViewport({20, 140, 600, 560});
+    }
+};
+
+TEST_F(SonarCameraTest, FullViewMapsWorldOntoViewport) {
+    Vector2 center = camera.worldToScreen({0, 0});
+    EXPECT_FLOAT_EQ(center.x, 320.0f);
+    EXPECT_FLOAT_EQ(center.y, 420.0f);
+
+    Vector2 corner = camera.worldToScreen({600, 360});
+    EXPECT_FLOAT_EQ(corner.x, 620.0f);
+    EXPECT_FLOAT_EQ(corner.y, 700.0f);
+}
+
+TEST_F(SonarCameraTest, ScreenToWorldInvertsWorldToScreen) {
+    camera.zoomAt({400, 300}, 3.0f);
+    Vector2 world = {-123.0f, 45.0f};
+    Vector2 back = camera.screenToWorld(camera.worldToScreen(world));
+    EXPECT_NEAR(back.x, world.x, 1e-3f);
+    EXPECT_NEAR(back.y, world.y, 1e-3f);
+}
+
+TEST_F(SonarCameraTest, ZoomKeepsPointUnderCursor) {
+    Vector2 cursor = {250, 380};
+    Vector2 before = camera.screenToWorld(cursor);
+    camera.zoomAt(cursor, 2.0f);
+    Vector2 after = camera.screenToWorld(cursor);
+
+    EXPECT_FLOAT_EQ(camera.getZoom(), 2.0f);
+    EXPECT_NEAR(after.x, before.x, 1e-3f);
+    EXPECT_NEAR(after.y, before.y, 1e-3f);
+}
+
+TEST_F(SonarCameraTest, ZoomAndPanAreClampedToWorld) {
+    camera.zoomAt({320, 420}, 100.0f);
+    EXPECT_FLOAT_EQ(camera.getZoom(), SonarCamera::MAX_ZOOM);
+
+    camera.reset();
+    camera.panBy({500, 500});
+    EXPECT_FLOAT_EQ(camera.getTarget().x, 0.0f);
+    EXPECT_FLOAT_EQ(camera.getTarget().y, 0.0f);
+}
+
+TEST_F(SonarCameraTest, ChangesBumpRevision) {
+    uint32_t revision = camera.getRevision();
+    camera.zoomAt({320, 420}, 2.0f);
+    EXPECT_NE(camera.getRevision(), revision);
+}
+
+TEST_F(SonarCameraTest, BatchTransformMatchesPointTransform) {
+    camera.zoomAt({100, 200}, 1.7f);
+    std::vector<Vector2> world = {{0, 0}, {10, -20}, {-600, 360}, {250.5f, 99.25f}, {-1, 1}};
+    std::vector<Vector2> screen(world.size());
+    camera.transform(world.data(), world.size(), screen.data());
+
+    for (size_t i = 0; i < world.size(); ++i) {
+        Vector2 expected = camera.worldToScreen(world[i]);
+        EXPECT_NEAR(screen[i].x, expected.x, 1e-3f);
+        EXPECT_NEAR(screen[i].y, expected.y, 1e-3f);
+    }
+}
+
+TEST_F(SonarCameraTest, TransformVisibleCullsAndPacksInOrder) {
+    camera.zoomAt({320, 420}, 4.0f);
+    // centred 4x zoom shows world x in [-150, 150], y in [-90, 90]
+    std::vector<Vector2> world = {{0, 0}, {500, 0}, {100, 50}, {0, -300}, {-140, 80}};
+    std::vector<Vector2> screen(world.size());
+    std::vector<uint32_t> indices(world.size());
+
+    size_t visible = camera.transformVisible(world.data(), world.size(), 0.0f, screen.data(), indices.data());
+
+    ASSERT_EQ(visible, 3u);
+    EXPECT_EQ(indices[0], 0u);
+    EXPECT_EQ(indices[1], 2u);
+    EXPECT_EQ(indices[2], 4u);
+    Vector2 expected = camera.worldToScreen(world[2]);
+    EXPECT_NEAR(screen[1].x, expected.x, 1e-3f);
+    EXPECT_NEAR(screen[1].y, expected.y, 1e-3f);
+}
+
+TEST_F(SonarCameraTest, TransformVisibleMarginKeepsNearbyPoints) {
+    camera.zoomAt({320, 420}, 4.0f);
+    // just beyond the right edge of the view
+    Vector2 world = {152, 0};
+    Vector2 screen;
+
+    EXPECT_EQ(camera.transformVisible(&world, 1, 0.0f, &screen, nullptr), 0u);
+    EXPECT_EQ(camera.transformVisible(&world, 1, 10.0f, &screen, nullptr), 1u);
+}
@@ -0,0 +1,26 @@
+#include <gtest/gtest.h>
+#include "ui/StartupTimer.h"
+
+TEST(StartupTimerTest, MarksStartUnset) {
+    StartupTimer timer;
+    EXPECT_FALSE(timer.isComplete());
+    EXPECT_LT(timer.getMs(StartupTimer::MAIN), 0.0);
+}
+
+TEST(StartupTimerTest, KeepsFirstTimeOfEachMark) {
+    StartupTimer timer;
+    timer.mark(StartupTimer::MAIN);
+    const double first = timer.getMs(StartupTimer::MAIN);
+    EXPECT_GE(first, 0.0);
+
+    timer.mark(StartupTimer::WINDOW);
+    timer.mark(StartupTimer::MAIN);
+    EXPECT_EQ(timer.getMs(StartupTimer::MAIN), first);
+    EXPECT_GE(timer.getMs(StartupTimer::WINDOW), first);
+}
+
+TEST(StartupTimerTest, CompleteAfterFirstFrame) {
+    StartupTimer timer;
+    timer.mark(StartupTimer::FIRST_FRAME);
+    EXPECT_TRUE(timer.isComplete());
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "ui/WaterfallHistory.h"
+
+namespace {
+constexpr float HALF_PI = 1.57079633f;
+}
+
+TEST(WaterfallHistoryTest, HeadMovesUpAndWraps) {
+    WaterfallHistory history(16, 4);
+    history.beginRow(1);
+    EXPECT_EQ(history.commitRow(), 3);
+    history.beginRow(2);
+    EXPECT_EQ(history.commitRow(), 2);
+    history.beginRow(3);
+    history.commitRow();
+    history.beginRow(4);
+    EXPECT_EQ(history.commitRow(), 0);
+    history.beginRow(5);
+    EXPECT_EQ(history.commitRow(), 3);
+    EXPECT_EQ(history.getHead(), 3);
+    EXPECT_EQ(history.getFilledRows(), 4);
+}
+
+TEST(WaterfallHistoryTest, BearingIsClockwiseFromScreenUp) {
+    EXPECT_NEAR(WaterfallHistory::bearingOf({0, -10}), 0.0f, 1e-5f);
+    EXPECT_NEAR(WaterfallHistory::bearingOf({10, 0}), HALF_PI, 1e-5f);
+    EXPECT_NEAR(WaterfallHistory::bearingOf({0, 10}), 2.0f * HALF_PI, 1e-5f);
+    EXPECT_NEAR(WaterfallHistory::bearingOf({-10, 0}), 3.0f * HALF_PI, 1e-5f);
+}
+
+TEST(WaterfallHistoryTest, DetectionBrightensItsBearingBin) {
+    WaterfallHistory history(64, 8);
+    history.beginRow(7);
+    history.addDetection(HALF_PI, 1.0f);
+    history.commitRow();
+
+    const Color* row = history.getRow();
+    EXPECT_EQ(row[16].g, 255);
+    EXPECT_GT(row[16].g, row[18].g);
+    EXPECT_LT(row[40].g, 24 + 32);
+}
+
+TEST(WaterfallHistoryTest, DetectionsNearNorthWrapAcrossTheEdge) {
+    WaterfallHistory history(64, 8);
+    history.beginRow(0);
+    history.addDetection(0.0f, 1.0f);
+    history.commitRow();
+
+    const Color* row = history.getRow();
+    EXPECT_EQ(row[0].g, 255);
+    EXPECT_GT(row[63].g, 24 + 32);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "ui/widgets/Indicator.h"
+
+class IndicatorTest : public ::testing::Test {
+protected:
+    Indicator indicator{"Power", false};
+
+    void SetUp() override {
+        indicator.setBounds({10, 10, 180, 28});
+        indicator.clearDirty();
+    }
+};
+
+TEST_F(IndicatorTest, StartsDirtySoFirstFrameIsDrawn) {
+    Indicator fresh("Depth");
+    EXPECT_TRUE(fresh.isDirty());
+}
+
+TEST_F(IndicatorTest, StateChangeMarksDirty) {
+    indicator.setState(true);
+    EXPECT_TRUE(indicator.isDirty());
+    EXPECT_TRUE(indicator.getState());
+}
+
+TEST_F(IndicatorTest, SameStateDoesNotMarkDirty) {
+    indicator.setState(false);
+    indicator.setLabel("Power");
+    EXPECT_FALSE(indicator.isDirty());
+}
+
+TEST_F(IndicatorTest, BoundsChangeMarksDirty) {
+    indicator.setBounds({10, 10, 180, 28});
+    EXPECT_FALSE(indicator.isDirty());
+
+    indicator.setBounds({20, 10, 180, 28});
+    EXPECT_TRUE(indicator.isDirty());
+}
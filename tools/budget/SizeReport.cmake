@@ -0,0 +1,29 @@
+# Prints the size of each web bundle file against its budget and fails when
+# any file is over. Run by the size_report target:
+#   cmake -DWASM=<file> -DWASM_BUDGET=<bytes> -DJS=<file> -DJS_BUDGET=<bytes> -P SizeReport.cmake
+
+set(over_budget FALSE)
+
+foreach(kind WASM JS)
+  set(file "${${kind}}")
+  set(budget "${${kind}_BUDGET}")
+  if(NOT EXISTS "${file}")
+    message(SEND_ERROR "size report: ${file} not found")
+    set(over_budget TRUE)
+    continue()
+  endif()
+
+  file(SIZE "${file}" size)
+  math(EXPR percent "${size} * 100 / ${budget}")
+  get_filename_component(name "${file}" NAME)
+  if(size GREATER budget)
+    message(STATUS "${name}: ${size} bytes, budget ${budget} (${percent}%) OVER BUDGET")
+    set(over_budget TRUE)
+  else()
+    message(STATUS "${name}: ${size} bytes, budget ${budget} (${percent}%)")
+  endif()
+endforeach()
+
+if(over_budget)
+  message(FATAL_ERROR "web bundle is over its size budget")
+endif()
@@ -0,0 +1,192 @@
+// headless visual regression check. renders UIRoot into an offscreen render
+// texture from a hidden window, with fixed seeds and a fixed timestep, and
+// compares a hash of every sampled frame against a golden file.
+//
+//   render_snapshot [--golden <file>] [--update] [--out <dir>]
+//
+// --update rewrites the golden file; without it a missing golden file is an
+// error rather than something to record. on a mismatch the differing frames
+// are written as PNGs to --out (default: current directory) for inspection.
+// without a display, run under a virtual one (for example xvfb-run).
+
+#include <raylib.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "sim/SimulationWorld.h"
+#include "sim/SimulationSnapshot.h"
+#include "sim/SimulationCommands.h"
+#include "ui/UIRoot.h"
+#include "ui/RenderCache.h"
+
+namespace {
+
+constexpr int SCREEN_WIDTH = 1280;
+constexpr int SCREEN_HEIGHT = 720;
+constexpr float STEP = 1.0f / 60.0f;
+
+struct Scenario {
+    const char* name;
+    uint32_t seed;
+    int frames;
+    int sampleEvery;
+    std::function<void(SimulationWorld&)> setup;
+};
+
+// a few fixed situations covering the static panels, moving contacts and
+// missile/explosion batching
+const std::vector<Scenario>& scenarios() {
+    static const std::vector<Scenario> list = {
+        { "startup", 1, 120, 10, [](SimulationWorld&) {} },
+        { "powered", 2, 240, 10, [](SimulationWorld& world) {
+            world.getPowerSystem().setPowerState(true);
+        } },
+        { "engagement", 3, 240, 8, [](SimulationWorld& world) {
+            world.getPowerSystem().setPowerState(true);
+            ContactManager& contacts = world.getContactManager();
+            contacts.spawnContactsIfNeeded();
+            for (const SonarContact& contact : contacts.getActiveContacts()) {
+                world.getMissileManager().launchMissile({0.0f, 0.0f}, contact.id);
+            }
+        } },
+    };
+    return list;
+}
+
+// FNV-1a over the raw RGBA pixels
+uint64_t hashPixels(const Image& image) {
+    const auto* bytes = static_cast<const unsigned char*>(image.data);
+    const size_t size = static_cast<size_t>(image.width) * image.height * 4;
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string frameKey(const char* scenario, int frame) {
+    return std::string(scenario) + " " + std::to_string(frame);
+}
+
+// lines of "<scenario> <frame> <hash>"
+bool readGolden(const std::string& path, std::map<std::string, uint64_t>& golden) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string name;
+    int frame;
+    std::string hash;
+    while (in >> name >> frame >> hash) {
+        golden[frameKey(name.c_str(), frame)] = std::stoull(hash, nullptr, 16);
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string goldenPath = "render_snapshots.txt";
+    std::string outDir = ".";
+    bool update = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--golden") == 0 && i + 1 < argc) goldenPath = argv[++i];
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) outDir = argv[++i];
+        else if (std::strcmp(argv[i], "--update") == 0) update = true;
+        else {
+            std::cerr << "usage: " << argv[0] << " [--golden <file>] [--update] [--out <dir>]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::map<std::string, uint64_t> golden;
+    if (!update && !readGolden(goldenPath, golden)) {
+        std::cerr << "[RenderSnapshot] no golden file at " << goldenPath
+                  << "; record one with --update and commit it" << std::endl;
+        return 2;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "render_snapshot");
+    RenderTexture2D frame = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    if (!IsWindowReady() || !IsRenderTextureValid(frame)) {
+        std::cerr << "[RenderSnapshot] could not create a rendering context" << std::endl;
+        CloseWindow();
+        return 2;
+    }
+
+    std::ostringstream recorded;
+    int mismatches = 0;
+    int sampled = 0;
+    int rendered = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const Scenario& scenario : scenarios()) {
+        SimulationWorld world(scenario.seed);
+        SimulationSnapshot snapshot;
+        SimulationCommandQueue commands;
+        UIRoot ui(snapshot, commands);
+        scenario.setup(world);
+
+        for (int f = 0; f < scenario.frames; ++f) {
+            commands.apply(world);
+            world.update(STEP);
+            world.capture(snapshot);
+            snapshot.appliedCommands = commands.getAppliedCount();
+            ui.update(STEP);
+
+            RenderCache::beginFrameTarget(frame);
+            ClearBackground(BLACK);
+            ui.draw();
+            RenderCache::endFrameTarget();
+            ++rendered;
+
+            if (f % scenario.sampleEvery != 0) continue;
+            ++sampled;
+
+            Image image = LoadImageFromTexture(frame.texture);
+            const uint64_t hash = hashPixels(image);
+            recorded << scenario.name << " " << f << " " << std::hex << hash << std::dec << "\n";
+
+            if (!update) {
+                auto it = golden.find(frameKey(scenario.name, f));
+                if (it == golden.end() || it->second != hash) {
+                    ++mismatches;
+                    // render textures are stored bottom-up
+                    ImageFlipVertical(&image);
+                    const std::string png = outDir + "/" + scenario.name + "_" + std::to_string(f) + ".png";
+                    ExportImage(image, png.c_str());
+                    std::cout << "[RenderSnapshot] mismatch: " << scenario.name << " frame " << f
+                              << " (written to " << png << ")" << std::endl;
+                }
+            }
+            UnloadImage(image);
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    UnloadRenderTexture(frame);
+    CloseWindow();
+
+    std::cout << "[RenderSnapshot] " << rendered << " frames, " << sampled << " compared, "
+              << (seconds > 0.0 ? rendered / seconds : 0.0) << " frames/s" << std::endl;
+
+    if (update) {
+        std::ofstream out(goldenPath);
+        if (!out) {
+            std::cerr << "[RenderSnapshot] could not write " << goldenPath << std::endl;
+            return 2;
+        }
+        out << recorded.str();
+        std::cout << "[RenderSnapshot] wrote " << goldenPath << std::endl;
+        return 0;
+    }
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+// headless sim throughput benchmark. steps a set of crowded worlds for a
+// fixed wall time and reports sim ticks per second, plus the raw throughput
+// of the vectorized world kernels, current sampling, the sonar detection
+// pass, the tracker, fish schooling and submarine behaviours. the web build
+// is compiled twice (with and without -msimd128) and web/benchmark.html runs
+// both.
+//
+//   sim_benchmark [--worlds N] [--contacts N] [--missiles N] [--seconds S]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "sim/SimulationWorld.h"
+#include "sim/world/ContactTracker.h"
+#include "sim/world/OceanCurrentField.h"
+#include "sim/world/SonarDetection.h"
+#include "sim/world/SonarSweep.h"
+#include "sim/world/SubmarineBehaviors.h"
+#include "sim/world/WorldKernels.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr float STEP = 1.0f / 60.0f;
+
+double elapsedSeconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// runs fn in batches until at least `seconds` of wall time has passed;
+// returns calls per second
+template <typename Fn>
+double measure(double seconds, int batch, Fn fn) {
+    uint64_t calls = 0;
+    const auto start = Clock::now();
+    double elapsed = 0.0;
+    do {
+        for (int i = 0; i < batch; ++i) fn();
+        calls += static_cast<uint64_t>(batch);
+        elapsed = elapsedSeconds(start);
+    } while (elapsed < seconds);
+    return static_cast<double>(calls) / elapsed;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int worldCount = 16;
+    int contactCount = 400;
+    int missileCount = 8;
+    double seconds = 2.0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--worlds") == 0) worldCount = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--contacts") == 0) contactCount = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--missiles") == 0) missileCount = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seconds") == 0) seconds = std::atof(argv[i + 1]);
+    }
+
+    std::cout << "variant " << (WorldKernels::isVectorized() ? "simd" : "scalar") << std::endl;
+
+    // crowded worlds: far more contacts than normal play, plus live missiles
+    std::vector<std::unique_ptr<SimulationWorld>> worlds;
+    for (int w = 0; w < worldCount; ++w) {
+        worlds.push_back(std::make_unique<SimulationWorld>(static_cast<uint32_t>(w + 1)));
+        SimulationWorld& world = *worlds.back();
+        for (int c = 0; c < contactCount; ++c) {
+            world.getContactManager().spawnContact();
+        }
+        for (int m = 0; m < missileCount; ++m) {
+            world.getMissileManager().launchMissile({0.0f, 0.0f}, static_cast<uint32_t>(m));
+        }
+    }
+
+    const double worldTicks = measure(seconds, 1, [&]() {
+        for (auto& world : worlds) world->update(STEP);
+    }) * worldCount;
+    std::cout << "ticks_per_sec " << worldTicks << std::endl;
+
+    // kernel throughput on one large contiguous population
+    const size_t points = 4096;
+    std::vector<Vector2> positions(points), previous(points), velocities(points);
+    for (size_t i = 0; i < points; ++i) {
+        positions[i] = { (float)(i % 64) * 10.0f - 320.0f, (float)(i / 64) * 10.0f - 320.0f };
+        velocities[i] = { 1.0f, -1.0f };
+    }
+
+    const double integrateRate = measure(seconds * 0.5, 64, [&]() {
+        WorldKernels::integrate(positions.data(), previous.data(), velocities.data(), points, sizeof(Vector2), STEP);
+    }) * points;
+    std::cout << "integrate_points_per_sec " << integrateRate << std::endl;
+
+    // a centre no point reaches, so every scan covers the whole array
+    volatile size_t sink = 0;
+    const double scanRate = measure(seconds * 0.5, 64, [&]() {
+        sink = WorldKernels::firstWithinRadius(positions.data(), points, {5000.0f, 5000.0f}, 15.0f);
+    }) * points;
+    std::cout << "radius_scan_points_per_sec " << scanRate << std::endl;
+    (void)sink;
+
+    OceanCurrentField currents;
+    currents.seed(1);
+    std::vector<Vector2> drift(points);
+    const double currentRate = measure(seconds * 0.5, 64, [&]() {
+        currents.sample(positions.data(), points, sizeof(Vector2), drift.data());
+    }) * points;
+    std::cout << "current_samples_per_sec " << currentRate << std::endl;
+
+    // one sonar ping over a population far beyond normal play
+    const int pingContacts = 20000;
+    ContactManager crowd;
+    crowd.seed(1);
+    for (int c = 0; c < pingContacts; ++c) {
+        crowd.spawnContact();
+    }
+    SonarDetectionModel detection;
+    detection.seed(1);
+    const double pingRate = measure(seconds * 0.5, 4, [&]() { detection.ping(crowd); });
+    std::cout << "detection_contacts_per_sec " << pingRate * pingContacts << std::endl;
+    std::cout << "detection_ms_per_ping_20k " << 1000.0 / pingRate << std::endl;
+
+    // tracker predict, associate and correct over the same crowd
+    ContactTracker tracker;
+    detection.ping(crowd);
+    tracker.update(crowd);
+    const double trackRate = measure(seconds * 0.5, 4, [&]() {
+        tracker.advance(0.5f);
+        tracker.update(crowd);
+    });
+    std::cout << "tracker_tracks " << tracker.getTrackCount() << std::endl;
+    std::cout << "tracker_ms_per_ping_20k " << 1000.0 / trackRate << std::endl;
+
+    // sweep mode: one 60 Hz tick of the beam over the same crowd
+    SonarSweep sweep;
+    sweep.advance(crowd, 0.0f);
+    const double sweepRate = measure(seconds * 0.5, 64, [&]() {
+        sweep.advance(crowd, 1.0f / 60.0f);
+        detection.pingContacts(crowd, sweep.getSwept().data(), sweep.getSwept().size());
+    });
+    std::cout << "sweep_ms_per_tick_20k " << 1000.0 / sweepRate << std::endl;
+
+    // schooling clutter: ten schools of a thousand fish, steered and moved
+    ContactManager shoal;
+    shoal.seed(1);
+    for (int s = 0; s < 10; ++s) {
+        shoal.spawnSchool({ -450.0f + 100.0f * s, (s % 2) ? 150.0f : -150.0f }, 1000, 90.0f);
+    }
+    const double schoolRate = measure(seconds * 0.5, 16, [&]() { shoal.updateContactPositions(1.0f / 60.0f); });
+    std::cout << "schooling_ms_per_tick_10k " << 1000.0 / schoolRate << std::endl;
+
+    // submarine behaviours for two thousand contacts with missiles in the water
+    ContactManager fleet;
+    fleet.seed(6);
+    for (int c = 0; c < 2000; ++c) {
+        fleet.spawnContact();
+    }
+    SubmarineBehaviors behaviors;
+    behaviors.seed(6);
+    const std::vector<Vector2> threats = { {100.0f, 0.0f}, {-200.0f, 50.0f} };
+    behaviors.update(fleet, threats, STEP);
+    const double behaviorRate = measure(seconds * 0.5, 60, [&]() { behaviors.update(fleet, threats, STEP); });
+    std::cout << "behaviors_subs " << behaviors.getSubCount() << std::endl;
+    std::cout << "behaviors_ms_per_tick_2k " << 1000.0 / behaviorRate << std::endl;
+    return 0;
+}